@@ -267,6 +267,23 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT secp256k1_scratch_space* secp256k1_sc
     size_t max_size
 ) SECP256K1_ARG_NONNULL(1);
 
+/** Create a secp256k1 scratch space object that keeps its memory between uses.
+ *
+ *  Deallocated frames keep their memory for the next operation using the
+ *  scratch space, as long as the total memory kept is at most retain_size.
+ *  Such a scratch space must not be used by multiple threads at once.
+ *
+ *  Returns: a newly created scratch space.
+ *  Args: ctx:  an existing context object (cannot be NULL)
+ *  In:   max_size: maximum amount of memory to allocate
+ *        retain_size: maximum amount of memory to keep between uses
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT secp256k1_scratch_space* secp256k1_scratch_space_create_retained(
+    const secp256k1_context* ctx,
+    size_t max_size,
+    size_t retain_size
+) SECP256K1_ARG_NONNULL(1);
+
 /** Destroy a secp256k1 scratch space.
  *
  *  The pointer may not be used afterwards.
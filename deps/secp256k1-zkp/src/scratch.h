@@ -15,13 +15,18 @@ typedef struct secp256k1_scratch_space_struct {
     void *data[SECP256K1_SCRATCH_MAX_FRAMES];
     size_t offset[SECP256K1_SCRATCH_MAX_FRAMES];
     size_t frame_size[SECP256K1_SCRATCH_MAX_FRAMES];
+    size_t capacity[SECP256K1_SCRATCH_MAX_FRAMES];
     size_t frame;
     size_t max_size;
+    size_t retain_size;
     const secp256k1_callback* error_callback;
 } secp256k1_scratch;
 
 static secp256k1_scratch* secp256k1_scratch_create(const secp256k1_callback* error_callback, size_t max_size);
 
+/** Like secp256k1_scratch_create, but deallocated frames keep their memory for reuse while the total kept is at most `retain_size` bytes */
+static secp256k1_scratch* secp256k1_scratch_create_retained(const secp256k1_callback* error_callback, size_t max_size, size_t retain_size);
+
 static void secp256k1_scratch_destroy(secp256k1_scratch* scratch);
 
 /** Attempts to allocate a new stack frame with `n` available bytes. Returns 1 on success, 0 on failure */
@@ -16,10 +16,15 @@
 #define ALIGNMENT 16
 
 static secp256k1_scratch* secp256k1_scratch_create(const secp256k1_callback* error_callback, size_t max_size) {
+    return secp256k1_scratch_create_retained(error_callback, max_size, 0);
+}
+
+static secp256k1_scratch* secp256k1_scratch_create_retained(const secp256k1_callback* error_callback, size_t max_size, size_t retain_size) {
     secp256k1_scratch* ret = (secp256k1_scratch*)checked_malloc(error_callback, sizeof(*ret));
     if (ret != NULL) {
         memset(ret, 0, sizeof(*ret));
         ret->max_size = max_size;
+        ret->retain_size = retain_size;
         ret->error_callback = error_callback;
     }
     return ret;
@@ -27,7 +32,11 @@ static secp256k1_scratch* secp256k1_scratch_create(const secp256k1_callback* err
 
 static void secp256k1_scratch_destroy(secp256k1_scratch* scratch) {
     if (scratch != NULL) {
+        size_t i;
         VERIFY_CHECK(scratch->frame == 0);
+        for (i = 0; i < SECP256K1_SCRATCH_MAX_FRAMES; i++) {
+            free(scratch->data[i]);
+        }
         free(scratch);
     }
 }
@@ -49,9 +58,15 @@ static int secp256k1_scratch_allocate_frame(secp256k1_scratch* scratch, size_t n
 
     if (n <= secp256k1_scratch_max_allocation(scratch, objects)) {
         n += objects * ALIGNMENT;
-        scratch->data[scratch->frame] = checked_malloc(scratch->error_callback, n);
-        if (scratch->data[scratch->frame] == NULL) {
-            return 0;
+        /* Reuse the memory kept from an earlier frame at this depth when it's big enough */
+        if (scratch->capacity[scratch->frame] < n) {
+            free(scratch->data[scratch->frame]);
+            scratch->capacity[scratch->frame] = 0;
+            scratch->data[scratch->frame] = checked_malloc(scratch->error_callback, n);
+            if (scratch->data[scratch->frame] == NULL) {
+                return 0;
+            }
+            scratch->capacity[scratch->frame] = n;
         }
         scratch->frame_size[scratch->frame] = n;
         scratch->offset[scratch->frame] = 0;
@@ -63,9 +78,18 @@ static int secp256k1_scratch_allocate_frame(secp256k1_scratch* scratch, size_t n
 }
 
 static void secp256k1_scratch_deallocate_frame(secp256k1_scratch* scratch) {
+    size_t i;
+    size_t retained = 0;
     VERIFY_CHECK(scratch->frame > 0);
     scratch->frame -= 1;
-    free(scratch->data[scratch->frame]);
+    for (i = 0; i < SECP256K1_SCRATCH_MAX_FRAMES; i++) {
+        retained += scratch->capacity[i];
+    }
+    if (retained > scratch->retain_size) {
+        free(scratch->data[scratch->frame]);
+        scratch->data[scratch->frame] = NULL;
+        scratch->capacity[scratch->frame] = 0;
+    }
 }
 
 static void *secp256k1_scratch_alloc(secp256k1_scratch* scratch, size_t size) {
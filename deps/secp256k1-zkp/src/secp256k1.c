@@ -140,6 +140,11 @@ secp256k1_scratch_space* secp256k1_scratch_space_create(const secp256k1_context*
     return secp256k1_scratch_create(&ctx->error_callback, max_size);
 }
 
+secp256k1_scratch_space* secp256k1_scratch_space_create_retained(const secp256k1_context* ctx, size_t max_size, size_t retain_size) {
+    VERIFY_CHECK(ctx != NULL);
+    return secp256k1_scratch_create_retained(&ctx->error_callback, max_size, retain_size);
+}
+
 void secp256k1_scratch_space_destroy(secp256k1_scratch_space* scratch) {
     secp256k1_scratch_destroy(scratch);
 }
@@ -301,6 +301,7 @@ void run_scratch_tests(void) {
     int32_t ecount = 0;
     secp256k1_context *none = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
     secp256k1_scratch_space *scratch;
+    void *retained;
 
     /* Test public API */
     secp256k1_context_set_illegal_callback(none, counting_illegal_callback_fn, &ecount);
@@ -330,6 +331,51 @@ void run_scratch_tests(void) {
     CHECK(secp256k1_scratch_max_allocation(scratch, 0) == 1000);
     CHECK(secp256k1_scratch_alloc(scratch, 500) == NULL);
 
+    secp256k1_scratch_space_destroy(scratch);
+
+    /* Test a scratch space that keeps its memory between frames */
+    scratch = secp256k1_scratch_space_create_retained(none, 1000, 600);
+    CHECK(scratch != NULL);
+    CHECK(ecount == 0);
+
+    /* A deallocated frame keeps its memory while the total kept is within the retain limit... */
+    CHECK(secp256k1_scratch_allocate_frame(scratch, 500, 1));
+    retained = scratch->data[0];
+    CHECK(retained != NULL);
+    secp256k1_scratch_deallocate_frame(scratch);
+    CHECK(scratch->data[0] == retained);
+    CHECK(scratch->capacity[0] == 500 + ALIGNMENT);
+    CHECK(secp256k1_scratch_max_allocation(scratch, 0) == 1000);
+
+    /* ...and a later frame that fits reuses it, without being able to allocate more than it asked for */
+    CHECK(secp256k1_scratch_allocate_frame(scratch, 400, 1));
+    CHECK(scratch->data[0] == retained);
+    CHECK(secp256k1_scratch_alloc(scratch, 400) != NULL);
+    CHECK(secp256k1_scratch_alloc(scratch, 400) == NULL);
+
+    /* A nested frame that would take the total kept above the limit is freed */
+    CHECK(secp256k1_scratch_allocate_frame(scratch, 300, 1));
+    CHECK(scratch->data[1] != NULL);
+    secp256k1_scratch_deallocate_frame(scratch);
+    CHECK(scratch->data[1] == NULL);
+    CHECK(scratch->capacity[1] == 0);
+    secp256k1_scratch_deallocate_frame(scratch);
+    CHECK(scratch->data[0] == retained);
+
+    /* A frame larger than the kept memory replaces it, and is freed since it alone exceeds the limit */
+    CHECK(secp256k1_scratch_allocate_frame(scratch, 700, 1));
+    CHECK(scratch->capacity[0] == 700 + ALIGNMENT);
+    CHECK(secp256k1_scratch_alloc(scratch, 700) != NULL);
+    secp256k1_scratch_deallocate_frame(scratch);
+    CHECK(scratch->data[0] == NULL);
+    CHECK(scratch->capacity[0] == 0);
+    CHECK(secp256k1_scratch_max_allocation(scratch, 0) == 1000);
+
+    /* Destroying the scratch space frees the memory it still keeps */
+    CHECK(secp256k1_scratch_allocate_frame(scratch, 200, 1));
+    secp256k1_scratch_deallocate_frame(scratch);
+    CHECK(scratch->data[0] != NULL);
+
     /* cleanup */
     secp256k1_scratch_space_destroy(scratch);
     secp256k1_context_destroy(none);
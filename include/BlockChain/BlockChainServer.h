@@ -5,6 +5,7 @@
 // file LICENSE or http://www.opensource.org/licenses/mit-license.php.
 
 #include <Common/ImportExport.h>
+#include <Common/TaskPool.h>
 #include <BlockChain/BlockChainStatus.h>
 #include <TxPool/PoolType.h>
 #include <P2P/SyncStatus.h>
@@ -13,12 +14,15 @@
 #include <Core/Models/BlockHeader.h>
 #include <Core/Models/FullBlock.h>
 #include <Core/Models/CompactBlock.h>
+#include <Core/Models/KernelLocation.h>
+#include <Core/Models/OutputHistory.h>
 #include <Core/Models/Transaction.h>
 #include <Core/Traits/Lockable.h>
 #include <Crypto/BigInteger.h>
 #include <PMMR/HeaderMMR.h>
 #include <filesystem.h>
 
+#include <string>
 #include <vector>
 #include <memory>
 
@@ -50,9 +54,30 @@ public:
 	virtual uint64_t GetHeight(const EChainType chainType) const = 0;
 	virtual uint64_t GetTotalDifficulty(const EChainType chainType) const = 0;
 
-	virtual EBlockChainStatus AddBlock(const FullBlock& block) = 0;
+	//
+	// Validates and adds the given block to the block chain, or to the orphan pool if its previous block is missing.
+	// The source identifies the peer that sent the block (empty if unknown), and is used to limit the orphans held per peer.
+	// The block is shared with the orphan pool and caches, never copied.
+	//
+	virtual EBlockChainStatus AddBlock(const FullBlock::CPtr& pBlock, const std::string& source = "") = 0;
+
+	//
+	// For callers that hold the block by value. Copies it once.
+	//
+	EBlockChainStatus AddBlock(const FullBlock& block, const std::string& source = "")
+	{
+		return AddBlock(std::make_shared<const FullBlock>(block), source);
+	}
+
 	virtual EBlockChainStatus AddCompactBlock(const CompactBlock& compactBlock) = 0;
 
+	//
+	// Performs the context-free validation of the block (structure, rangeproofs, kernel signatures, coinbase) without taking the chain lock.
+	// Valid blocks are marked as validated, so adding the same block object afterwards won't repeat the work.
+	// Returns false if the block is invalid.
+	//
+	virtual bool VerifyBlock(const FullBlock& block) const = 0;
+
 	virtual fs::path SnapshotTxHashSet(BlockHeaderPtr pBlockHeader) = 0;
 	virtual EBlockChainStatus ProcessTransactionHashSet(const Hash& blockHash, const fs::path& path, SyncStatus& syncStatus) = 0;
 	virtual EBlockChainStatus AddTransaction(TransactionPtr pTransaction, const EPoolType poolType) = 0;
@@ -85,6 +110,24 @@ public:
 	//
 	virtual BlockHeaderPtr GetBlockHeaderByCommitment(const Commitment& outputCommitment) const = 0;
 
+	//
+	// Returns the location (block height and mmr index) of the kernel with the given excess commitment.
+	// This will be null if the kernel is not found on the confirmed chain.
+	//
+	virtual std::unique_ptr<KernelLocation> GetKernelLocation(const Commitment& excessCommitment) const = 0;
+
+	//
+	// Returns the creation location and, if spent, the spent height of the output with the given commitment.
+	// Spent outputs are only found when archive mode is enabled.
+	//
+	virtual std::unique_ptr<OutputHistory> GetOutputHistory(const Commitment& outputCommitment) const = 0;
+
+	//
+	// Returns the hash of the block applied at the given height, as recorded by the archive height index.
+	// This will be null when archive mode is disabled.
+	//
+	virtual std::unique_ptr<Hash> GetArchivedBlockHash(const uint64_t height) const = 0;
+
 	//
 	// Returns the block header at the tip of the specified chain type.
 	//
@@ -132,6 +175,29 @@ public:
 	virtual std::vector<std::pair<uint64_t, Hash>> GetBlocksNeeded(const uint64_t maxNumBlocks) const = 0;
 
 	virtual bool ProcessNextOrphanBlock() = 0;
+
+	//
+	// Writes every block of the confirmed chain (excluding genesis) to a bootstrap file at the given path.
+	// Returns the number of blocks written.
+	// Throws BlockChainException if a block is missing (ie. the node was fast-synced), or FileException if the file can't be written.
+	//
+	virtual uint64_t ExportBootstrap(const fs::path& path) const = 0;
+
+	//
+	// Validates and applies the blocks from a bootstrap file created by ExportBootstrap, starting after the confirmed tip.
+	// Headers are added in batches, and each batch of block bodies is verified in parallel before being applied in order.
+	// Returns the number of blocks applied.
+	// Throws BadDataException if the file or any of its blocks are invalid, or FileException if the file can't be read.
+	//
+	virtual uint64_t ImportBootstrap(const fs::path& path) = 0;
+
+	//
+	// Validates and applies the confirmed blocks of another block chain (eg. one opened from an existing data directory),
+	// starting after this chain's confirmed tip, the same way ImportBootstrap does. The source is only read from.
+	// Returns the number of blocks applied.
+	// Throws BlockChainException if the source is missing blocks, or BadDataException if any of its blocks are invalid.
+	//
+	virtual uint64_t ReplayChain(const IBlockChainServer& source) = 0;
 };
 
 typedef std::shared_ptr<IBlockChainServer> IBlockChainServerPtr;
@@ -146,6 +212,7 @@ namespace BlockChainAPI
 		std::shared_ptr<Locked<IBlockDB>> pDatabase,
 		std::shared_ptr<Locked<TxHashSetManager>> pTxHashSetManager,
 		std::shared_ptr<ITransactionPool> pTransactionPool,
-		std::shared_ptr<Locked<IHeaderMMR>> pHeaderMMR
+		std::shared_ptr<Locked<IHeaderMMR>> pHeaderMMR,
+		const TaskPool::Ptr& pTaskPool
 	);
 }
\ No newline at end of file
@@ -40,6 +40,12 @@ public:
 
 	EChainType GetType() const noexcept { return m_chainType; }
 
+	//
+	// Returns the highest block index shared by this chain and the other chain (ie. the fork point).
+	// Chains that agree at some height agree at every height below it, so this is a binary search over heights.
+	//
+	std::shared_ptr<const BlockIndex> FindCommonIndex(const Chain& other) const;
+
 	std::shared_ptr<const BlockIndex> AddBlock(const Hash& hash, const uint64_t height);
 	void Rewind(const uint64_t lastHeight);
 
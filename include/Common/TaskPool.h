@@ -0,0 +1,674 @@
+#pragma once
+
+#include <Infrastructure/Logger.h>
+#include <Infrastructure/ThreadManager.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <future>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+enum class ETaskPriority : uint8_t
+{
+	HIGH = 0,
+	NORMAL = 1,
+	LOW = 2
+};
+
+// Forward Declarations
+class TaskGroup;
+
+//
+// A fixed-size, work-stealing thread pool shared by the whole node (owned by Context).
+//
+// Each worker owns one deque per priority. Tasks posted from a worker go to the back of its own deque,
+// and are popped LIFO for cache locality. Idle workers steal from the front of other workers' deques.
+// Workers always look for HIGH tasks (locally, then by stealing) before NORMAL, and NORMAL before LOW,
+// so priorities are honored across the pool, although ordering within a priority is best-effort.
+//
+// Subsystems should not post to the pool directly when they need a concurrency limit or cancellation.
+// Instead, they should create a TaskGroup via CreateGroup().
+//
+class TaskPool : public std::enable_shared_from_this<TaskPool>
+{
+public:
+	using Ptr = std::shared_ptr<TaskPool>;
+	using Clock = std::chrono::steady_clock;
+
+	static TaskPool::Ptr Create(const size_t numThreads = GetDefaultNumThreads())
+	{
+		std::shared_ptr<TaskPool> pTaskPool(new TaskPool(numThreads));
+		pTaskPool->Start();
+		return pTaskPool;
+	}
+
+	~TaskPool() { Shutdown(); }
+
+	static size_t GetDefaultNumThreads() noexcept
+	{
+		return (std::max)((size_t)std::thread::hardware_concurrency(), (size_t)2);
+	}
+
+	size_t GetNumThreads() const noexcept { return m_queues.size(); }
+
+	//
+	// Creates a subsystem group that runs at most maxConcurrency tasks at a time on this pool.
+	//
+	std::shared_ptr<TaskGroup> CreateGroup(const std::string& name, const size_t maxConcurrency);
+
+	//
+	// Queues the task. Returns false, without running either callback, if the pool was already shutdown.
+	// If the pool is shutdown before the task starts, the task is discarded and onDiscarded (if any) is called instead.
+	//
+	bool Post(const ETaskPriority priority, std::function<void()>&& task, std::function<void()>&& onDiscarded = nullptr)
+	{
+		const auto& worker = CurrentWorker();
+		const size_t index = worker.first == this ? worker.second : (m_nextQueue++ % m_queues.size());
+
+		{
+			WorkerQueue& queue = *m_queues[index];
+			std::unique_lock<std::mutex> lock(queue.mutex);
+
+			// Checked under the queue lock, so the task is either rejected here or seen by Shutdown's discard pass.
+			if (m_shutdown)
+			{
+				return false;
+			}
+
+			queue.tasks[(size_t)priority].push_back(QueuedTask{ std::move(task), std::move(onDiscarded) });
+			m_numPending++;
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(m_sleepMutex);
+		}
+		m_sleepCondition.notify_one();
+		return true;
+	}
+
+	template<typename F>
+	auto Submit(const ETaskPriority priority, F&& func) -> std::future<decltype(func())>
+	{
+		using R = decltype(func());
+
+		auto pTask = std::make_shared<std::packaged_task<R()>>(std::forward<F>(func));
+		std::future<R> future = pTask->get_future();
+		Post(priority, [pTask]() { (*pTask)(); });
+
+		return future;
+	}
+
+	//
+	// Posts the task once the delay has elapsed.
+	//
+	void PostAfter(const Clock::duration delay, const ETaskPriority priority, std::function<void()>&& task)
+	{
+		AddTimer(Clock::now() + delay, TimedTask{ priority, std::move(task), 0, Clock::duration(0) });
+	}
+
+	//
+	// Runs the task every interval, measured from the end of the previous run, starting immediately.
+	// Returns an id which can be passed to CancelInterval.
+	//
+	uint64_t ScheduleInterval(const Clock::duration interval, const ETaskPriority priority, std::function<void()>&& task)
+	{
+		const uint64_t intervalId = m_nextIntervalId++;
+		{
+			std::unique_lock<std::mutex> lock(m_timerMutex);
+			m_activeIntervals.insert(intervalId);
+		}
+
+		AddTimer(Clock::now(), TimedTask{ priority, std::move(task), intervalId, interval });
+		return intervalId;
+	}
+
+	//
+	// Stops future runs of the interval task. A run that is already in progress is not interrupted.
+	//
+	void CancelInterval(const uint64_t intervalId)
+	{
+		std::unique_lock<std::mutex> lock(m_timerMutex);
+		m_activeIntervals.erase(intervalId);
+	}
+
+	//
+	// Runs a single queued task on the calling thread, if one is available.
+	// Threads that wait on other tasks should call this, so waiting workers never starve the pool.
+	//
+	bool RunPendingTask()
+	{
+		const auto& worker = CurrentWorker();
+		const size_t index = worker.first == this ? worker.second : 0;
+
+		std::function<void()> task;
+		if (TryPop(index, task))
+		{
+			RunTask(task);
+			return true;
+		}
+
+		return false;
+	}
+
+	//
+	// Waits for the future to be ready, running other queued tasks in the meantime.
+	//
+	template<typename T>
+	T Await(std::future<T>& future)
+	{
+		while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		{
+			if (!RunPendingTask())
+			{
+				future.wait_for(std::chrono::milliseconds(1));
+			}
+		}
+
+		return future.get();
+	}
+
+	//
+	// Stops and joins all workers. Queued tasks that have not started are discarded, and their onDiscarded callbacks are called.
+	//
+	void Shutdown()
+	{
+		if (m_shutdown.exchange(true))
+		{
+			return;
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(m_sleepMutex);
+		}
+		m_sleepCondition.notify_all();
+
+		for (std::thread& worker : m_workers)
+		{
+			if (worker.get_id() == std::this_thread::get_id())
+			{
+				worker.detach();
+			}
+			else if (worker.joinable())
+			{
+				worker.join();
+			}
+		}
+
+		std::vector<QueuedTask> discarded;
+		for (auto& pQueue : m_queues)
+		{
+			std::unique_lock<std::mutex> lock(pQueue->mutex);
+			for (auto& tasks : pQueue->tasks)
+			{
+				std::move(tasks.begin(), tasks.end(), std::back_inserter(discarded));
+				tasks.clear();
+			}
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(m_timerMutex);
+			m_timers.clear();
+		}
+
+		// Called outside of the queue locks, since callbacks (eg. TaskGroup) may try to post again, which is rejected.
+		for (QueuedTask& queuedTask : discarded)
+		{
+			if (queuedTask.onDiscarded)
+			{
+				queuedTask.onDiscarded();
+			}
+		}
+	}
+
+private:
+	struct QueuedTask
+	{
+		std::function<void()> task;
+		std::function<void()> onDiscarded;
+	};
+
+	struct WorkerQueue
+	{
+		std::mutex mutex;
+		std::array<std::deque<QueuedTask>, 3> tasks;
+	};
+
+	struct TimedTask
+	{
+		ETaskPriority priority;
+		std::function<void()> task;
+		uint64_t intervalId; // 0 for one-shot tasks
+		Clock::duration interval;
+	};
+
+	explicit TaskPool(const size_t numThreads)
+		: m_shutdown(false), m_numPending(0), m_nextQueue(0), m_nextIntervalId(1), m_timerVersion(0), m_nextDeadline(NO_DEADLINE)
+	{
+		for (size_t i = 0; i < (std::max)(numThreads, (size_t)1); i++)
+		{
+			m_queues.push_back(std::make_unique<WorkerQueue>());
+		}
+	}
+
+	void Start()
+	{
+		for (size_t i = 0; i < m_queues.size(); i++)
+		{
+			m_workers.emplace_back(std::thread([this, i] { WorkerLoop(i); }));
+		}
+	}
+
+	static std::pair<const TaskPool*, size_t>& CurrentWorker()
+	{
+		static thread_local std::pair<const TaskPool*, size_t> worker = { nullptr, 0 };
+		return worker;
+	}
+
+	void WorkerLoop(const size_t index)
+	{
+		CurrentWorker() = { this, index };
+		ThreadManagerAPI::SetCurrentThreadName("TASK_POOL");
+
+		while (!m_shutdown)
+		{
+			if (Clock::now().time_since_epoch().count() >= m_nextDeadline)
+			{
+				PromoteDueTimers();
+			}
+
+			std::function<void()> task;
+			if (TryPop(index, task))
+			{
+				RunTask(task);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(m_sleepMutex);
+			const uint64_t timerVersion = m_timerVersion;
+			const Clock::time_point wakeTime = (std::min)(
+				Clock::time_point(Clock::duration(m_nextDeadline.load())),
+				Clock::now() + std::chrono::milliseconds(100)
+			);
+			m_sleepCondition.wait_until(lock, wakeTime, [this, timerVersion] {
+				return m_shutdown || m_numPending > 0 || m_timerVersion != timerVersion;
+			});
+		}
+	}
+
+	bool TryPop(const size_t index, std::function<void()>& task)
+	{
+		if (m_numPending == 0)
+		{
+			return false;
+		}
+
+		for (size_t priority = 0; priority < 3; priority++)
+		{
+			// Own queue first (LIFO), then steal from the others (FIFO).
+			for (size_t i = 0; i < m_queues.size(); i++)
+			{
+				WorkerQueue& queue = *m_queues[(index + i) % m_queues.size()];
+				std::unique_lock<std::mutex> lock(queue.mutex);
+
+				auto& tasks = queue.tasks[priority];
+				if (!tasks.empty())
+				{
+					if (i == 0)
+					{
+						task = std::move(tasks.back().task);
+						tasks.pop_back();
+					}
+					else
+					{
+						task = std::move(tasks.front().task);
+						tasks.pop_front();
+					}
+
+					m_numPending--;
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	static void RunTask(std::function<void()>& task)
+	{
+		try
+		{
+			task();
+		}
+		catch (std::exception& e)
+		{
+			LOG_ERROR_F("Exception thrown by task: {}", e.what());
+		}
+		catch (...)
+		{
+			LOG_ERROR("Unknown exception thrown by task");
+		}
+	}
+
+	void AddTimer(const Clock::time_point time, TimedTask&& timedTask)
+	{
+		if (m_shutdown)
+		{
+			return;
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(m_timerMutex);
+			m_timers.emplace(time, std::move(timedTask));
+			m_nextDeadline = m_timers.begin()->first.time_since_epoch().count();
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(m_sleepMutex);
+			m_timerVersion++;
+		}
+		m_sleepCondition.notify_one();
+	}
+
+	void PromoteDueTimers()
+	{
+		std::vector<TimedTask> dueTasks;
+		{
+			std::unique_lock<std::mutex> lock(m_timerMutex);
+
+			auto end = m_timers.upper_bound(Clock::now());
+			for (auto iter = m_timers.begin(); iter != end; iter++)
+			{
+				dueTasks.push_back(std::move(iter->second));
+			}
+
+			m_timers.erase(m_timers.begin(), end);
+			m_nextDeadline = m_timers.empty() ? NO_DEADLINE : m_timers.begin()->first.time_since_epoch().count();
+		}
+
+		for (TimedTask& timedTask : dueTasks)
+		{
+			if (timedTask.intervalId == 0)
+			{
+				Post(timedTask.priority, std::move(timedTask.task));
+			}
+			else
+			{
+				const ETaskPriority priority = timedTask.priority;
+				Post(priority, [this, timedTask]() mutable { RunInterval(std::move(timedTask)); });
+			}
+		}
+	}
+
+	void RunInterval(TimedTask&& timedTask)
+	{
+		if (!IsIntervalActive(timedTask.intervalId))
+		{
+			return;
+		}
+
+		RunTask(timedTask.task);
+
+		if (IsIntervalActive(timedTask.intervalId))
+		{
+			const Clock::time_point nextRun = Clock::now() + timedTask.interval;
+			AddTimer(nextRun, std::move(timedTask));
+		}
+	}
+
+	bool IsIntervalActive(const uint64_t intervalId)
+	{
+		std::unique_lock<std::mutex> lock(m_timerMutex);
+		return m_activeIntervals.count(intervalId) > 0;
+	}
+
+	static constexpr Clock::rep NO_DEADLINE = (std::numeric_limits<Clock::rep>::max)();
+
+	std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+	std::vector<std::thread> m_workers;
+	std::atomic_bool m_shutdown;
+	std::atomic_size_t m_numPending;
+	std::atomic_size_t m_nextQueue;
+
+	std::mutex m_sleepMutex;
+	std::condition_variable m_sleepCondition;
+
+	std::mutex m_timerMutex;
+	std::multimap<Clock::time_point, TimedTask> m_timers;
+	std::unordered_set<uint64_t> m_activeIntervals;
+	std::atomic_uint64_t m_nextIntervalId;
+	uint64_t m_timerVersion;
+	std::atomic<Clock::rep> m_nextDeadline;
+};
+
+//
+// A named subsystem running on a TaskPool, with its own concurrency limit.
+// Tasks beyond the limit wait inside the group (by priority) until one of the group's running tasks finishes,
+// so a busy subsystem can never occupy more than maxConcurrency of the pool's workers.
+//
+// Cancel() discards all waiting tasks and rejects new ones. Running tasks are not interrupted,
+// but long-running tasks should poll IsCancelled(). Owners should call Cancel() then Wait() before
+// destroying anything their tasks reference.
+//
+class TaskGroup : public std::enable_shared_from_this<TaskGroup>
+{
+public:
+	using Ptr = std::shared_ptr<TaskGroup>;
+	using Clock = TaskPool::Clock;
+
+	TaskGroup(const std::weak_ptr<TaskPool>& pTaskPool, const std::string& name, const size_t maxConcurrency)
+		: m_pTaskPool(pTaskPool), m_name(name), m_maxConcurrency((std::max)(maxConcurrency, (size_t)1)), m_running(0), m_cancelled(false) { }
+
+	const std::string& GetName() const noexcept { return m_name; }
+	size_t GetMaxConcurrency() const noexcept { return m_maxConcurrency; }
+	bool IsCancelled() const noexcept { return m_cancelled; }
+
+	//
+	// Returns false if the group was cancelled or the pool was shutdown.
+	// Tasks that were accepted but discarded by a pool shutdown still release their slot, so Wait() returns.
+	//
+	bool Post(const ETaskPriority priority, std::function<void()>&& task)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			if (m_cancelled)
+			{
+				return false;
+			}
+
+			if (m_running >= m_maxConcurrency)
+			{
+				m_waiting[(size_t)priority].push_back(std::move(task));
+				return true;
+			}
+
+			m_running++;
+		}
+
+		if (!Dispatch(priority, std::move(task)))
+		{
+			OnTaskFinished();
+			return false;
+		}
+
+		return true;
+	}
+
+	template<typename F>
+	auto Submit(const ETaskPriority priority, F&& func) -> std::future<decltype(func())>
+	{
+		using R = decltype(func());
+
+		auto pTask = std::make_shared<std::packaged_task<R()>>(std::forward<F>(func));
+		std::future<R> future = pTask->get_future();
+		Post(priority, [pTask]() { (*pTask)(); });
+
+		return future;
+	}
+
+	//
+	// Posts the task to the group once the delay has elapsed, unless the group was cancelled in the meantime.
+	//
+	void PostAfter(const Clock::duration delay, const ETaskPriority priority, std::function<void()>&& task)
+	{
+		auto pTaskPool = m_pTaskPool.lock();
+		if (pTaskPool != nullptr && !m_cancelled)
+		{
+			std::weak_ptr<TaskGroup> pWeakGroup = shared_from_this();
+			pTaskPool->PostAfter(delay, priority, [pWeakGroup, priority, task = std::move(task)]() mutable {
+				auto pGroup = pWeakGroup.lock();
+				if (pGroup != nullptr)
+				{
+					pGroup->Post(priority, std::move(task));
+				}
+			});
+		}
+	}
+
+	void Cancel()
+	{
+		std::array<std::deque<std::function<void()>>, 3> discarded;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_cancelled = true;
+			discarded.swap(m_waiting);
+		}
+
+		m_idleCondition.notify_all();
+	}
+
+	//
+	// Waits until the group has no waiting or running tasks, running other pool tasks in the meantime.
+	//
+	void Wait()
+	{
+		auto pTaskPool = m_pTaskPool.lock();
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (m_running > 0 || HasWaiting())
+		{
+			lock.unlock();
+			const bool ranTask = pTaskPool != nullptr && pTaskPool->RunPendingTask();
+			lock.lock();
+
+			if (!ranTask && (m_running > 0 || HasWaiting()))
+			{
+				m_idleCondition.wait_for(lock, std::chrono::milliseconds(1));
+			}
+		}
+	}
+
+	//
+	// Waits for the future to be ready, running other pool tasks in the meantime.
+	//
+	template<typename T>
+	T Await(std::future<T>& future)
+	{
+		auto pTaskPool = m_pTaskPool.lock();
+		if (pTaskPool != nullptr)
+		{
+			return pTaskPool->Await(future);
+		}
+
+		return future.get();
+	}
+
+private:
+	bool Dispatch(const ETaskPriority priority, std::function<void()>&& task)
+	{
+		auto pTaskPool = m_pTaskPool.lock();
+		if (pTaskPool == nullptr)
+		{
+			return false;
+		}
+
+		std::shared_ptr<TaskGroup> pGroup = shared_from_this();
+		auto onDiscarded = [pGroup]() { pGroup->OnTaskFinished(); };
+		return pTaskPool->Post(priority, [pGroup, task = std::move(task)]() mutable {
+			if (!pGroup->IsCancelled())
+			{
+				try
+				{
+					task();
+				}
+				catch (std::exception& e)
+				{
+					LOG_ERROR_F("Exception thrown by {} task: {}", pGroup->GetName(), e.what());
+				}
+				catch (...)
+				{
+					LOG_ERROR_F("Unknown exception thrown by {} task", pGroup->GetName());
+				}
+			}
+
+			pGroup->OnTaskFinished();
+		}, std::move(onDiscarded));
+	}
+
+	void OnTaskFinished()
+	{
+		std::function<void()> nextTask;
+		ETaskPriority nextPriority = ETaskPriority::NORMAL;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			for (size_t priority = 0; priority < 3 && !m_cancelled; priority++)
+			{
+				if (!m_waiting[priority].empty())
+				{
+					nextTask = std::move(m_waiting[priority].front());
+					nextPriority = (ETaskPriority)priority;
+					m_waiting[priority].pop_front();
+					break;
+				}
+			}
+
+			if (!nextTask)
+			{
+				m_running--;
+				if (m_running == 0)
+				{
+					m_idleCondition.notify_all();
+				}
+
+				return;
+			}
+		}
+
+		// The slot is handed straight to the next waiting task.
+		if (!Dispatch(nextPriority, std::move(nextTask)))
+		{
+			OnTaskFinished();
+		}
+	}
+
+	bool HasWaiting() const
+	{
+		return std::any_of(m_waiting.cbegin(), m_waiting.cend(), [](const auto& tasks) { return !tasks.empty(); });
+	}
+
+	std::weak_ptr<TaskPool> m_pTaskPool;
+	std::string m_name;
+	size_t m_maxConcurrency;
+
+	std::mutex m_mutex;
+	std::condition_variable m_idleCondition;
+	std::array<std::deque<std::function<void()>>, 3> m_waiting;
+	size_t m_running;
+	std::atomic_bool m_cancelled;
+};
+
+inline std::shared_ptr<TaskGroup> TaskPool::CreateGroup(const std::string& name, const size_t maxConcurrency)
+{
+	return std::make_shared<TaskGroup>(weak_from_this(), name, maxConcurrency);
+}
\ No newline at end of file
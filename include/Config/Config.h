@@ -35,6 +35,7 @@ public:
 	}
 
 	Json::Value& GetJSON() noexcept { return m_json; }
+	const Json::Value& GetJSON() const noexcept { return m_json; }
 
 	const std::string& GetLogLevel() const noexcept { return m_logLevel; }
 	const Environment& GetEnvironment() const noexcept { return m_environment; }
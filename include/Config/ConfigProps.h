@@ -8,6 +8,18 @@ namespace ConfigProps
 	static const std::string ENVIRONMENT = "ENVIRONMENT";
 	static const std::string DATA_PATH = "DATA_PATH";
 
+	namespace Node
+	{
+		static const std::string NODE = "NODE";
+
+		static const std::string ARCHIVE_MODE = "ARCHIVE_MODE";
+		static const std::string SLOW_BLOCK_MS = "SLOW_BLOCK_MS";
+		static const std::string ASSUME_VALID = "ASSUME_VALID";
+		static const std::string SCRATCH_SPACE_MB = "SCRATCH_SPACE_MB";
+		static const std::string SCRATCH_RETAIN_MB = "SCRATCH_RETAIN_MB";
+		static const std::string VERIFIED_CACHE_SIZE = "VERIFIED_CACHE_SIZE";
+	}
+
 	namespace P2P
 	{
 		static const std::string P2P = "P2P";
@@ -4,8 +4,12 @@
 #include <Config/DandelionConfig.h>
 #include <Config/ClientMode.h>
 #include <Config/P2PConfig.h>
+#include <Crypto/Hash.h>
 
+#include <chrono>
 #include <cstdint>
+#include <algorithm>
+#include <optional>
 #include <json/json.h>
 
 class NodeConfig
@@ -21,12 +25,53 @@ public:
 	const fs::path& GetDatabasePath() const { return m_databasePath; }
 	const fs::path& GetTxHashSetPath() const { return m_txHashSetPath; }
 
+	// When enabled, spent output history and a height-to-block index are kept in the chain database.
+	// It can only be turned on for a node without a chain, since blocks already applied can't be archived.
+	bool IsArchiveMode() const { return m_archiveMode; }
+
+	// Blocks (and header batches) that take longer than this to process are logged with a per-stage breakdown.
+	std::chrono::milliseconds GetSlowBlockThreshold() const { return m_slowBlockThreshold; }
+
+	// Blocks at or below this trusted block, on the most-work header chain, skip rangeproof and kernel signature verification.
+	const std::optional<Hash>& GetAssumeValid() const { return m_assumeValid; }
+
+	// Most memory a single rangeproof or signature batch verification may use, and how much of it each thread keeps for reuse.
+	size_t GetScratchSpaceSize() const { return m_scratchSpaceMB * 1024 * 1024; }
+	size_t GetScratchRetainSize() const { return m_scratchRetainMB * 1024 * 1024; }
+
+	// Number of verified rangeproofs and kernel signatures remembered, so they aren't verified again when seen in a block.
+	size_t GetVerifiedCacheSize() const { return m_verifiedCacheSize; }
+
 	//
 	// Constructor
 	//
 	NodeConfig(const Json::Value& json, const fs::path& dataPath)
 		: m_p2pConfig(json), m_dandelion(json)
 	{
+		m_archiveMode = false;
+		m_slowBlockThreshold = std::chrono::milliseconds(2000);
+		m_scratchSpaceMB = MIN_SCRATCH_SPACE_MB;
+		m_scratchRetainMB = 16;
+		m_verifiedCacheSize = 100'000;
+		if (json.isMember(ConfigProps::Node::NODE))
+		{
+			const Json::Value& nodeJSON = json[ConfigProps::Node::NODE];
+			m_archiveMode = nodeJSON.get(ConfigProps::Node::ARCHIVE_MODE, false).asBool();
+			m_slowBlockThreshold = std::chrono::milliseconds(nodeJSON.get(ConfigProps::Node::SLOW_BLOCK_MS, 2000).asUInt64());
+
+			// Rangeproofs are verified in batches of up to 1000 during txhashset validation, which needs the full default.
+			// Smaller values would make valid proofs fail to verify, so they're raised to it.
+			m_scratchSpaceMB = (std::max)((size_t)nodeJSON.get(ConfigProps::Node::SCRATCH_SPACE_MB, 256).asUInt64(), MIN_SCRATCH_SPACE_MB);
+			m_scratchRetainMB = (std::min)((size_t)nodeJSON.get(ConfigProps::Node::SCRATCH_RETAIN_MB, 16).asUInt64(), m_scratchSpaceMB);
+			m_verifiedCacheSize = (size_t)nodeJSON.get(ConfigProps::Node::VERIFIED_CACHE_SIZE, 100'000).asUInt64();
+
+			const std::string assumeValid = nodeJSON.get(ConfigProps::Node::ASSUME_VALID, "").asString();
+			if (!assumeValid.empty())
+			{
+				m_assumeValid = std::make_optional(Hash::FromHex(assumeValid));
+			}
+		}
+
 		const fs::path nodePath = dataPath / "NODE";
 
 		m_chainPath = nodePath / "CHAIN";
@@ -44,9 +89,17 @@ public:
 	}
 
 private:
+	static constexpr size_t MIN_SCRATCH_SPACE_MB = 256;
+
 	fs::path m_chainPath;
 	fs::path m_databasePath;
 	fs::path m_txHashSetPath;
+	bool m_archiveMode;
+	std::chrono::milliseconds m_slowBlockThreshold;
+	std::optional<Hash> m_assumeValid;
+	size_t m_scratchSpaceMB;
+	size_t m_scratchRetainMB;
+	size_t m_verifiedCacheSize;
 
 	P2PConfig m_p2pConfig;
 	DandelionConfig m_dandelion;
@@ -2,7 +2,7 @@
 
 #include <Config/Config.h>
 #include <Net/Tor/TorProcess.h>
-#include <scheduler/Scheduler.h>
+#include <Common/TaskPool.h>
 #include <memory>
 #include <cassert>
 
@@ -13,11 +13,15 @@ public:
 
     Context(
         const ConfigPtr& pConfig,
-        const std::shared_ptr<Bosma::Scheduler>& pScheduler,
+        const TaskPool::Ptr& pTaskPool,
         const TorProcess::Ptr& pTorProcess
-    ) : m_pConfig(pConfig), m_pScheduler(pScheduler), m_pTorProcess(pTorProcess) { }
+    ) : m_pConfig(pConfig), m_pTaskPool(pTaskPool), m_pTorProcess(pTorProcess) { }
 
-    ~Context() { LOG_INFO("Deleting node context"); }
+    ~Context()
+    {
+        LOG_INFO("Deleting node context");
+        m_pTaskPool->Shutdown();
+    }
 
     static Context::Ptr Create(const ConfigPtr& pConfig)
     {
@@ -30,19 +34,24 @@ public:
         );
         return std::make_shared<Context>(
             pConfig,
-            std::make_shared<Bosma::Scheduler>(12),
+            TaskPool::Create(),
             pTorProcess
         );
     }
 
     const Config& GetConfig() const { return *m_pConfig; }
-    const std::shared_ptr<Bosma::Scheduler>& GetScheduler() const noexcept { return m_pScheduler; }
+
+    //
+    // The node's shared thread pool. Subsystems should create their own TaskGroup from it,
+    // rather than spawning threads, so that the node never runs more busy threads than there are cores.
+    //
+    const TaskPool::Ptr& GetTaskPool() const noexcept { return m_pTaskPool; }
     const TorProcess::Ptr& GetTorProcess() const noexcept { return m_pTorProcess; }
 
 private:
     // TODO: Include logger
 
     ConfigPtr m_pConfig;
-    std::shared_ptr<Bosma::Scheduler> m_pScheduler;
+    TaskPool::Ptr m_pTaskPool;
     TorProcess::Ptr m_pTorProcess;
 };
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <Core/Traits/Batchable.h>
 #include <Crypto/BigInteger.h>
 #include <Common/Util/StringUtil.h>
+#include <Infrastructure/Metrics.h>
 #include <memory>
 
 template<size_t NUM_BYTES>
@@ -18,13 +19,14 @@ public:
 		std::shared_ptr<AppendOnlyFile> pFile = std::make_shared<AppendOnlyFile>(path);
 		pFile->Load();
 
-		return std::make_shared<DataFile>(DataFile(pFile));
+		return std::make_shared<DataFile>(DataFile(pFile, GetMetricsPrefix(path)));
 	}
 
 	virtual void Commit() override final
 	{
 		if (IsDirty())
 		{
+			Metrics::ScopedTimer timer(*m_pFlushLatency);
 			if (!m_pFile->Flush())
 			{
 				throw FILE_EXCEPTION("Commit failed.");
@@ -60,6 +62,8 @@ public:
 
 	std::vector<unsigned char> GetDataAt(const uint64_t position) const
 	{
+		m_pReads->Increment();
+
 		std::vector<unsigned char> data;
 		if (!m_pFile->Read(position * NUM_BYTES, NUM_BYTES, data))
 		{
@@ -69,24 +73,56 @@ public:
 		return data;
 	}
 
+	//
+	// Reads 'count' consecutive entries, starting at 'position', in a single read.
+	// Throws a FileException if the range runs past the end of the file.
+	//
+	std::vector<unsigned char> GetDataRange(const uint64_t position, const uint64_t count) const
+	{
+		m_pReads->Increment();
+
+		std::vector<unsigned char> data;
+		if (!m_pFile->Read(position * NUM_BYTES, count * NUM_BYTES, data))
+		{
+			throw FILE_EXCEPTION(StringUtil::Format("Failed to read {} entries at position {}", count, position));
+		}
+
+		return data;
+	}
+
 	void AddData(const std::vector<unsigned char>& data)
 	{
 		SetDirty(true);
 		m_pFile->Append(data);
+		m_pBytesWritten->Increment(data.size());
 	}
 
 	void AddData(const CBigInteger<NUM_BYTES>& data)
 	{
 		SetDirty(true);
 		m_pFile->Append(data.GetData());
+		m_pBytesWritten->Increment(NUM_BYTES);
 	}
 
 private:
-	DataFile(std::shared_ptr<AppendOnlyFile> pFile)
-		: m_pFile(pFile)
+	DataFile(std::shared_ptr<AppendOnlyFile> pFile, const std::string& metricsPrefix)
+		: m_pFile(pFile),
+		m_pReads(&MetricsAPI::GetCounter(metricsPrefix + ".reads")),
+		m_pBytesWritten(&MetricsAPI::GetCounter(metricsPrefix + ".bytes_written")),
+		m_pFlushLatency(&MetricsAPI::GetHistogram(metricsPrefix + ".flush_micros"))
 	{
 
 	}
 
+	// eg. "file.kernel.pmmr_hash" for ".../txhashset/kernel/pmmr_hash.bin"
+	static std::string GetMetricsPrefix(const fs::path& path)
+	{
+		return "file." + path.parent_path().filename().u8string() + "." + path.stem().u8string();
+	}
+
 	std::shared_ptr<AppendOnlyFile> m_pFile;
+
+	Metrics::Counter* m_pReads;
+	Metrics::Counter* m_pBytesWritten;
+	Metrics::Histogram* m_pFlushLatency;
 };
\ No newline at end of file
@@ -14,6 +14,11 @@
 #include <memory>
 #include <vector>
 
+//
+// Blocks are passed between subsystems (pipeline, orphan pool, processor, caches) as FullBlock::CPtr,
+// so a received block is shared rather than deep-copied at each stage. Once constructed, a block is never modified,
+// other than being marked as validated.
+//
 class FullBlock : public Traits::IPrintable, public Traits::ISerializable
 {
 public:
@@ -23,9 +28,10 @@ public:
 	// Constructors
 	//
 	FullBlock(BlockHeaderPtr pBlockHeader, TransactionBody&& transactionBody);
+	FullBlock(BlockHeaderPtr pBlockHeader, TransactionBody&& transactionBody, const uint64_t serializedSize);
 	FullBlock(const FullBlock& other) = default;
 	FullBlock(FullBlock&& other) noexcept = default;
-	FullBlock() = default;
+	FullBlock() : m_serializedSize(0), m_validated(false), m_assumedValid(false) { }
 
 	//
 	// Destructor
@@ -81,6 +87,22 @@ public:
 		return commitments;
 	}
 
+	std::vector<Commitment> GetKernelCommitments() const
+	{
+		const auto& kernels = GetKernels();
+
+		std::vector<Commitment> commitments;
+		commitments.reserve(kernels.size());
+
+		std::transform(
+			kernels.cbegin(), kernels.cend(),
+			std::back_inserter(commitments),
+			[](const TransactionKernel& kernel) { return kernel.GetExcessCommitment(); }
+		);
+
+		return commitments;
+	}
+
 	uint64_t GetTotalFees() const noexcept
 	{
 		return std::accumulate(
@@ -90,6 +112,12 @@ public:
 	}
 
 	uint64_t GetHeight() const noexcept { return m_pBlockHeader->GetHeight(); }
+
+	//
+	// Computed on first use when the block wasn't deserialized or constructed with a known size.
+	//
+	uint64_t GetSerializedSize() const;
+
 	const Hash& GetPreviousHash() const noexcept { return m_pBlockHeader->GetPreviousBlockHash(); }
 	uint64_t GetTotalDifficulty() const noexcept { return m_pBlockHeader->GetTotalDifficulty(); }
 	const BlindingFactor& GetTotalKernelOffset() const noexcept { return m_pBlockHeader->GetTotalKernelOffset(); }
@@ -113,6 +141,13 @@ public:
 	bool WasValidated() const noexcept { return m_validated; }
 	void MarkAsValidated() const noexcept { m_validated = true; }
 
+	//
+	// Set when the block was checked as an ancestor of the assume-valid block, so its rangeproofs and
+	// kernel signatures were never verified. Such a block is not considered validated.
+	//
+	bool WasAssumedValid() const noexcept { return m_assumedValid; }
+	void MarkAsAssumedValid() const noexcept { m_assumedValid = true; }
+
 	//
 	// Traits
 	//
@@ -121,5 +156,7 @@ public:
 private:
 	BlockHeaderPtr m_pBlockHeader;
 	TransactionBody m_transactionBody;
+	mutable uint64_t m_serializedSize;
 	mutable bool m_validated;
+	mutable bool m_assumedValid;
 };
\ No newline at end of file
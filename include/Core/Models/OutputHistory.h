@@ -0,0 +1,74 @@
+#pragma once
+
+// Copyright (c) 2018-2019 David Burkett
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <Core/Serialization/Serializer.h>
+#include <Core/Serialization/ByteBuffer.h>
+#include <Core/Traits/Serializable.h>
+#include <Core/Models/OutputLocation.h>
+#include <Core/Exceptions/DeserializationException.h>
+#include <cstdint>
+#include <optional>
+
+//
+// The full lifetime of an output, as tracked in archive mode.
+// The spent height is only set once the output has been spent.
+//
+class OutputHistory : public Traits::ISerializable
+{
+public:
+	//
+	// Constructor
+	//
+	OutputHistory(const OutputLocation& location, const std::optional<uint64_t>& spentHeight)
+		: m_location(location), m_spentHeight(spentHeight) { }
+	virtual ~OutputHistory() = default;
+
+	//
+	// Getters
+	//
+	const OutputLocation& GetLocation() const noexcept { return m_location; }
+	uint64_t GetMMRIndex() const noexcept { return m_location.GetMMRIndex(); }
+	uint64_t GetCreatedHeight() const noexcept { return m_location.GetBlockHeight(); }
+	const std::optional<uint64_t>& GetSpentHeight() const noexcept { return m_spentHeight; }
+	bool IsSpent() const noexcept { return m_spentHeight.has_value(); }
+
+	//
+	// Serialization/Deserialization
+	//
+	void Serialize(Serializer& serializer) const final
+	{
+		serializer.Append<uint8_t>(/* version= */ 0);
+		m_location.Serialize(serializer);
+		serializer.Append<uint8_t>(m_spentHeight.has_value() ? 1 : 0);
+		if (m_spentHeight.has_value())
+		{
+			serializer.Append<uint64_t>(m_spentHeight.value());
+		}
+	}
+
+	static OutputHistory Deserialize(ByteBuffer& byteBuffer)
+	{
+		const uint8_t version = byteBuffer.ReadU8();
+		if (version != 0)
+		{
+			throw DESERIALIZATION_EXCEPTION();
+		}
+
+		OutputLocation location = OutputLocation::Deserialize(byteBuffer);
+
+		std::optional<uint64_t> spentHeight = std::nullopt;
+		if (byteBuffer.ReadU8() == 1)
+		{
+			spentHeight = std::make_optional(byteBuffer.ReadU64());
+		}
+
+		return OutputHistory(location, spentHeight);
+	}
+
+private:
+	OutputLocation m_location;
+	std::optional<uint64_t> m_spentHeight;
+};
\ No newline at end of file
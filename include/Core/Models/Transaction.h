@@ -65,6 +65,11 @@ public:
 	//
 	const Hash& GetHash() const;
 
+	//
+	// Both the hash and the serialized size are calculated once, on construction.
+	//
+	uint64_t GetSerializedSize() const noexcept { return m_serializedSize; }
+
 	//
 	// Traits
 	//
@@ -78,6 +83,7 @@ private:
 	TransactionBody m_transactionBody;
 
 	mutable Hash m_hash;
+	uint64_t m_serializedSize = 0;
 };
 
 typedef std::shared_ptr<const Transaction> TransactionPtr;
\ No newline at end of file
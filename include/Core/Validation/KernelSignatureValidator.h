@@ -2,38 +2,98 @@
 
 #include <Crypto/Crypto.h>
 #include <Core/Models/TransactionKernel.h>
+#include <Common/TaskPool.h>
 #include <Infrastructure/Logger.h>
+#include <algorithm>
 
 class KernelSignatureValidator
 {
 public:
-	// Verify the tx kernels.
-	// No ability to batch verify these right now so just do them individually.
-	static bool VerifyKernelSignatures(const std::vector<TransactionKernel>& kernels)
+	// Verify the tx kernels as a single batch on the calling thread.
+	// Verified signatures are remembered unless addToCache is false, so bulk validation doesn't evict mempool entries.
+	static bool VerifyKernelSignatures(const std::vector<TransactionKernel>& kernels, const bool addToCache = true)
+	{
+		return VerifyRange(kernels, 0, kernels.size(), addToCache);
+	}
+
+	//
+	// Splits large batches into one chunk per worker of the task pool, and verifies the chunks in parallel.
+	// Each worker uses its own secp256k1 context, so the chunks don't contend with each other.
+	//
+	static bool VerifyKernelSignatures(const std::vector<TransactionKernel>& kernels, TaskPool& taskPool, const bool addToCache = true)
+	{
+		const size_t numChunks = (std::min)(taskPool.GetNumThreads(), kernels.size() / MIN_CHUNK_SIZE);
+		if (numChunks <= 1)
+		{
+			return VerifyKernelSignatures(kernels, addToCache);
+		}
+
+		const size_t chunkSize = (kernels.size() + numChunks - 1) / numChunks;
+
+		std::vector<std::future<bool>> tasks;
+		tasks.reserve(numChunks);
+		for (size_t begin = 0; begin < kernels.size(); begin += chunkSize)
+		{
+			const size_t end = (std::min)(begin + chunkSize, kernels.size());
+			tasks.push_back(taskPool.Submit(ETaskPriority::HIGH, [&kernels, begin, end, addToCache] { return VerifyRange(kernels, begin, end, addToCache); }));
+		}
+
+		// All tasks must finish before returning, since they reference the kernels.
+		bool valid = true;
+		for (auto& task : tasks)
+		{
+			if (!taskPool.Await(task))
+			{
+				valid = false;
+			}
+		}
+
+		return valid;
+	}
+
+private:
+	// Smaller chunks lose more to per-batch overhead than they gain from the extra threads.
+	static const size_t MIN_CHUNK_SIZE = 256;
+
+	// Verifies kernels [begin, end) as one batch.
+	// A failed batch doesn't say which signature is bad, so the kernels are then checked one at a time to log the invalid ones.
+	static bool VerifyRange(const std::vector<TransactionKernel>& kernels, const size_t begin, const size_t end, const bool addToCache)
 	{
 		std::vector<const Commitment*> commitments;
-		commitments.reserve(kernels.size());
+		commitments.reserve(end - begin);
 		std::vector<const Signature*> signatures;
-		signatures.reserve(kernels.size());
+		signatures.reserve(end - begin);
 		std::vector<Hash> msgs;
-		msgs.reserve(kernels.size());
+		msgs.reserve(end - begin);
 		std::vector<const Hash*> messages;
-		messages.reserve(kernels.size());
+		messages.reserve(end - begin);
 
 		// Verify the transaction proof validity. Entails handling the commitment as a public key and checking the signature verifies with the fee as message.
-		for (size_t i = 0; i < kernels.size(); i++)
+		for (size_t i = begin; i < end; i++)
 		{
 			const TransactionKernel& kernel = kernels[i];
 			commitments.push_back(&kernel.GetExcessCommitment());
 			signatures.push_back(&kernel.GetExcessSignature());
 			msgs.emplace_back(kernel.GetSignatureMessage());
-			messages.push_back(&msgs[i]);
+			messages.push_back(&msgs.back());
 		}
 
 		LOG_TRACE("Start verify");
-		if (!Crypto::VerifyKernelSignatures(signatures, commitments, messages))
+		if (!Crypto::VerifyKernelSignatures(signatures, commitments, messages, addToCache))
 		{
 			LOG_ERROR("Failed to verify kernels.");
+
+			if (end - begin > 1)
+			{
+				for (size_t i = 0; i < commitments.size(); i++)
+				{
+					if (!Crypto::VerifyKernelSignatures({ signatures[i] }, { commitments[i] }, { messages[i] }, addToCache))
+					{
+						LOG_ERROR_F("Invalid signature for kernel {}", *commitments[i]);
+					}
+				}
+			}
+
 			return false;
 		}
 
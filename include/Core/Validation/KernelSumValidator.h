@@ -30,19 +30,18 @@ public:
 		auto getKernelCommitments = [](TransactionKernel& kernel) -> Commitment { return kernel.GetExcessCommitment(); };
 		std::vector<Commitment> kernelCommitments = FunctionalUtil::map<std::vector<Commitment>>(transactionBody.GetKernels(), getKernelCommitments);
 
-		return ValidateKernelSums(inputCommitments, outputCommitments, kernelCommitments, overage, kernelOffset, blockSumsOpt);
+		return ValidateKernelSums(std::move(inputCommitments), std::move(outputCommitments), std::move(kernelCommitments), overage, kernelOffset, blockSumsOpt);
 	}
 
+	// Takes the commitments by value, so callers can move large vectors (eg. the whole TxHashSet) in rather than copying every commitment.
 	static BlockSums ValidateKernelSums(
-		const std::vector<Commitment>& inputs,
-		const std::vector<Commitment>& outputs,
-		const std::vector<Commitment>& kernels,
+		std::vector<Commitment> inputCommitments,
+		std::vector<Commitment> outputCommitments,
+		std::vector<Commitment> kernelCommitments,
 		const int64_t overage,
 		const BlindingFactor& kernelOffset,
 		const std::optional<BlockSums>& blockSumsOpt)
 	{
-		std::vector<Commitment> inputCommitments = inputs;
-		std::vector<Commitment> outputCommitments = outputs;
 		if (overage > 0)
 		{
 			outputCommitments.push_back(Crypto::CommitTransparent(overage));
@@ -61,7 +60,6 @@ public:
 		Commitment utxoSum = Crypto::AddCommitments(outputCommitments, inputCommitments);
 
 		// Sum the kernel excesses accounting for the kernel offset.
-		std::vector<Commitment> kernelCommitments = kernels;
 		if (blockSumsOpt.has_value())
 		{
 			kernelCommitments.push_back(blockSumsOpt.value().GetKernelSum());
@@ -1,15 +1,31 @@
 #pragma once
 
 #include <Core/Models/TransactionBody.h>
+#include <Common/TaskPool.h>
 
 class TransactionBodyValidator
 {
 public:
+	TransactionBodyValidator() = default;
+
+	//
+	// Large batches of kernel signatures are split across the task pool's workers.
+	//
+	TransactionBodyValidator(const TaskPool::Ptr& pTaskPool) : m_pTaskPool(pTaskPool) { }
+
 	void Validate(const TransactionBody& transactionBody, const bool withReward);
 
+	//
+	// Checks the weight, sorting and cut-through of the body, without verifying any rangeproofs or kernel signatures.
+	//
+	void ValidateStructure(const TransactionBody& transactionBody, const bool withReward);
+
 private:
 	void ValidateWeight(const TransactionBody& transactionBody, const bool withReward);
 	void VerifySorted(const TransactionBody& transactionBody);
 	void VerifyCutThrough(const TransactionBody& transactionBody);
 	void VerifyRangeProofs(const std::vector<TransactionOutput>& outputs);
+	bool VerifyKernelSignatures(const std::vector<TransactionKernel>& kernels) const;
+
+	TaskPool::Ptr m_pTaskPool;
 };
\ No newline at end of file
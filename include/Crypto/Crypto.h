@@ -106,6 +106,18 @@ public:
 		const std::vector<BlindingFactor>& negative
 	);
 
+	//
+	// Sets the scratch space used by rangeproof and signature batch operations.
+	// maxBytes limits the memory a single operation may use, and retainBytes limits what each thread keeps for reuse between operations.
+	// Only affects threads that haven't performed such an operation yet, so call this at startup.
+	//
+	static void ConfigureScratchSpace(const size_t maxBytes, const size_t retainBytes);
+
+	//
+	// Sets how many verified rangeproofs and kernel signatures are remembered, so verifying them again is free.
+	//
+	static void ConfigureVerifiedCache(const size_t capacity);
+
 	//
 	//
 	//
@@ -127,19 +139,21 @@ public:
 	);
 
 	//
-	//
+	// Proofs that verify are remembered, unless addToCache is false (eg. for bulk txhashset validation).
 	//
 	static bool VerifyRangeProofs(
-		const std::vector<std::pair<Commitment, RangeProof>>& rangeProofs
+		const std::vector<std::pair<Commitment, RangeProof>>& rangeProofs,
+		const bool addToCache = true
 	);
 
 	//
-	//
+	// Signatures that verify are remembered, unless addToCache is false (eg. for bulk txhashset validation).
 	//
 	static bool VerifyKernelSignatures(
 		const std::vector<const Signature*>& signatures,
 		const std::vector<const Commitment*>& publicKeys,
-		const std::vector<const Hash*>& messages
+		const std::vector<const Hash*>& messages,
+		const bool addToCache = true
 	);
 
 	//
@@ -6,7 +6,9 @@
 #include <Core/Models/FullBlock.h>
 #include <Core/Models/BlockSums.h>
 #include <Core/Models/OutputLocation.h>
+#include <Core/Models/KernelLocation.h>
 #include <Core/Models/SpentOutput.h>
+#include <Core/Models/OutputHistory.h>
 #include <Core/Traits/Batchable.h>
 #include <unordered_map>
 #include <memory>
@@ -36,4 +38,19 @@ public:
 	virtual void AddSpentPositions(const Hash& blockHash, const std::vector<SpentOutput>& outputPositions) = 0;
 	virtual std::unordered_map<Commitment, OutputLocation> GetSpentPositions(const Hash& blockHash) const = 0;
 	virtual void ClearSpentPositions() = 0;
+
+	virtual void AddKernelPosition(const Commitment& excessCommitment, const KernelLocation& location) = 0;
+	virtual std::unique_ptr<KernelLocation> GetKernelPosition(const Commitment& excessCommitment) const = 0;
+	virtual void RemoveKernelPositions(const std::vector<Commitment>& excessCommitments) = 0;
+	virtual void ClearKernelPositions() = 0;
+
+	//
+	// Archive mode only - these are no-ops (or return nullptr) when archive mode is disabled.
+	// Records the creation and spend heights of the outputs spent by the block, and indexes the block by height.
+	//
+	virtual void AddArchiveEntries(const FullBlock& block, const std::vector<SpentOutput>& spentOutputs) = 0;
+	virtual void RemoveArchiveEntries(const FullBlock& block) = 0;
+	virtual void ClearArchiveEntries() = 0;
+	virtual std::unique_ptr<OutputHistory> GetOutputHistory(const Commitment& outputCommitment) const = 0;
+	virtual std::unique_ptr<Hash> GetArchivedBlockHash(const uint64_t height) const = 0;
 };
\ No newline at end of file
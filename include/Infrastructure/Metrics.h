@@ -0,0 +1,258 @@
+#pragma once
+
+#include <Common/ImportExport.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef MW_INFRASTRUCTURE
+#define METRICS_API EXPORT
+#else
+#define METRICS_API IMPORT
+#endif
+
+namespace Metrics
+{
+	//
+	// Monotonically increasing count (eg. number of reads).
+	//
+	class Counter
+	{
+	public:
+		void Increment(const uint64_t amount = 1) noexcept { m_value.fetch_add(amount, std::memory_order_relaxed); }
+		uint64_t GetValue() const noexcept { return m_value.load(std::memory_order_relaxed); }
+
+	private:
+		std::atomic_uint64_t m_value = { 0 };
+	};
+
+	//
+	// Point-in-time value that can move in either direction (eg. cache size).
+	//
+	class Gauge
+	{
+	public:
+		void Set(const int64_t value) noexcept { m_value.store(value, std::memory_order_relaxed); }
+		void Add(const int64_t amount) noexcept { m_value.fetch_add(amount, std::memory_order_relaxed); }
+		int64_t GetValue() const noexcept { return m_value.load(std::memory_order_relaxed); }
+
+	private:
+		std::atomic_int64_t m_value = { 0 };
+	};
+
+	struct HistogramSnapshot
+	{
+		uint64_t count;
+		uint64_t sum;
+		uint64_t max;
+
+		// Upper bound of the bucket containing the percentile.
+		uint64_t p50;
+		uint64_t p99;
+
+		uint64_t Mean() const noexcept { return count == 0 ? 0 : sum / count; }
+	};
+
+	//
+	// Resource usage of the whole process since it started.
+	// Values the platform doesn't report are 0.
+	//
+	struct ProcessStats
+	{
+		uint64_t peakMemoryBytes;
+		uint64_t readBytes;
+		uint64_t writeBytes;
+	};
+
+	//
+	// Latency histogram with power-of-2 microsecond buckets, from 1us up to ~35 minutes.
+	//
+	class Histogram
+	{
+	public:
+		static constexpr size_t NUM_BUCKETS = 32;
+
+		void Record(const uint64_t micros) noexcept
+		{
+			size_t bucket = 0;
+			while (bucket < NUM_BUCKETS - 1 && (1ull << bucket) < micros)
+			{
+				++bucket;
+			}
+
+			m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+			m_sum.fetch_add(micros, std::memory_order_relaxed);
+
+			uint64_t max = m_max.load(std::memory_order_relaxed);
+			while (micros > max && !m_max.compare_exchange_weak(max, micros, std::memory_order_relaxed)) { }
+		}
+
+		HistogramSnapshot GetSnapshot() const noexcept
+		{
+			std::array<uint64_t, NUM_BUCKETS> buckets;
+			uint64_t total = 0;
+			for (size_t i = 0; i < NUM_BUCKETS; i++)
+			{
+				buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+				total += buckets[i];
+			}
+
+			return HistogramSnapshot{
+				total,
+				m_sum.load(std::memory_order_relaxed),
+				m_max.load(std::memory_order_relaxed),
+				Percentile(buckets, total, 50),
+				Percentile(buckets, total, 99)
+			};
+		}
+
+	private:
+		static uint64_t Percentile(const std::array<uint64_t, NUM_BUCKETS>& buckets, const uint64_t total, const uint64_t percentile) noexcept
+		{
+			const uint64_t threshold = (total * percentile + 99) / 100;
+
+			uint64_t seen = 0;
+			for (size_t i = 0; i < NUM_BUCKETS; i++)
+			{
+				seen += buckets[i];
+				if (seen >= threshold && seen > 0)
+				{
+					return 1ull << i;
+				}
+			}
+
+			return 0;
+		}
+
+		std::array<std::atomic_uint64_t, NUM_BUCKETS> m_buckets = {};
+		std::atomic_uint64_t m_sum = { 0 };
+		std::atomic_uint64_t m_max = { 0 };
+	};
+
+	//
+	// Records the lifetime of the timer (in microseconds) to the given histogram.
+	//
+	class ScopedTimer
+	{
+	public:
+		ScopedTimer(Histogram& histogram) noexcept
+			: m_histogram(histogram), m_start(std::chrono::steady_clock::now()) { }
+		~ScopedTimer() noexcept
+		{
+			const auto elapsed = std::chrono::steady_clock::now() - m_start;
+			m_histogram.Record((uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+		}
+
+	private:
+		Histogram& m_histogram;
+		std::chrono::steady_clock::time_point m_start;
+	};
+}
+
+namespace MetricsAPI
+{
+	//
+	// Returns the metric registered with the given name, creating it if it doesn't exist.
+	// The returned references remain valid for the lifetime of the process, so callers should cache them.
+	//
+	METRICS_API Metrics::Counter& GetCounter(const std::string& name);
+	METRICS_API Metrics::Gauge& GetGauge(const std::string& name);
+	METRICS_API Metrics::Histogram& GetHistogram(const std::string& name);
+
+	//
+	// Registers a function that refreshes gauges for metrics that must be polled (eg. RocksDB statistics).
+	// Collectors are run before each snapshot. Returns an id that can be used to unregister the collector.
+	//
+	METRICS_API uint64_t RegisterCollector(const std::function<void()>& collector);
+	METRICS_API void UnregisterCollector(const uint64_t collectorId);
+
+	METRICS_API std::map<std::string, uint64_t> GetCounters();
+	METRICS_API std::map<std::string, int64_t> GetGauges();
+	METRICS_API std::map<std::string, Metrics::HistogramSnapshot> GetHistograms();
+
+	//
+	// Returns the peak resident memory and storage I/O of the process.
+	//
+	METRICS_API Metrics::ProcessStats GetProcessStats();
+
+	//
+	// Logs a one-line-per-metric summary of all non-empty metrics.
+	//
+	METRICS_API void LogSummary();
+}
+
+namespace Metrics
+{
+	//
+	// Breaks an operation down into consecutive stages, and accumulates the time spent in each.
+	// Call Mark(stage) at the end of each stage. A stage can repeat (eg. once per block during a reorg), in which case its times add up.
+	//
+	class StageTimer
+	{
+	public:
+		explicit StageTimer(const std::string& prefix)
+			: m_prefix(prefix), m_start(std::chrono::steady_clock::now()), m_last(m_start) { }
+
+		void Mark(const std::string& stage)
+		{
+			const auto now = std::chrono::steady_clock::now();
+			const uint64_t micros = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(now - m_last).count();
+			m_last = now;
+
+			for (auto& entry : m_stages)
+			{
+				if (entry.first == stage)
+				{
+					entry.second += micros;
+					return;
+				}
+			}
+
+			m_stages.push_back(std::make_pair(stage, micros));
+		}
+
+		uint64_t GetTotalMicros() const noexcept
+		{
+			return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(m_last - m_start).count();
+		}
+
+		//
+		// Records each stage to the "<prefix>.<stage>" histogram, and the total to "<prefix>.total".
+		//
+		void Record() const
+		{
+			for (const auto& entry : m_stages)
+			{
+				MetricsAPI::GetHistogram(m_prefix + "." + entry.first).Record(entry.second);
+			}
+
+			MetricsAPI::GetHistogram(m_prefix + ".total").Record(GetTotalMicros());
+		}
+
+		//
+		// Formats the breakdown as space-separated key=value pairs (eg. "total_us=1500 verify_us=1200 commit_us=300").
+		//
+		std::string Format() const
+		{
+			std::string formatted = "total_us=" + std::to_string(GetTotalMicros());
+			for (const auto& entry : m_stages)
+			{
+				formatted += " " + entry.first + "_us=" + std::to_string(entry.second);
+			}
+
+			return formatted;
+		}
+
+	private:
+		std::string m_prefix;
+		std::chrono::steady_clock::time_point m_start;
+		std::chrono::steady_clock::time_point m_last;
+		std::vector<std::pair<std::string, uint64_t>> m_stages;
+	};
+}
\ No newline at end of file
@@ -20,6 +20,7 @@ class IBlockDB;
 class Transaction;
 class TransactionBody;
 class SyncStatus;
+class TaskPool;
 
 class ITxHashSet : public Traits::IBatchable
 {
@@ -33,6 +34,7 @@ public:
 	virtual std::unique_ptr<BlockSums> ValidateTxHashSet(
 		const BlockHeader& header,
 		const IBlockChainServer& blockChainServer,
+		TaskPool& taskPool,
 		SyncStatus& syncStatus
 	) = 0;
 
@@ -45,6 +47,15 @@ public:
 		std::shared_ptr<IBlockDB> pBlockDB
 	) const = 0;
 
+	//
+	// Saves the excess commitments, MMR indices, and block height for all kernels in the chain.
+	// This is typically only used during initial sync.
+	//
+	virtual void SaveKernelPositions(
+		const Chain::CPtr& pChain,
+		std::shared_ptr<IBlockDB> pBlockDB
+	) const = 0;
+
 	//
 	// Returns true if all inputs in the transaction are valid and unspent. Otherwise, false.
 	//
@@ -55,6 +66,7 @@ public:
 
 	//
 	// Appends all new kernels, outputs, and rangeproofs to the MMRs, and prunes all of the inputs.
+	// The output and kernel positions are updated in the given IBlockDB.
 	//
 	virtual bool ApplyBlock(
 		std::shared_ptr<IBlockDB> pBlockDB,
@@ -33,6 +33,22 @@ public:
 		const BlockHeader& previousHeader
 	) const;
 
+	//
+	// Validates the total difficulty and secondary scaling of the header, without validating the cuckoo cycle.
+	// This should only be used for headers that were already checked with IsProofValid.
+	//
+	bool IsDifficultyValid(
+		const BlockHeader& header,
+		const BlockHeader& previousHeader
+	) const;
+
+	//
+	// Validates only the header's cuckoo cycle. This doesn't require any chain state, so it's safe to call
+	// in parallel and without holding any chain locks. IsPoWValid still needs to be called to check difficulty.
+	// Returns true if the proof is valid.
+	//
+	static bool IsProofValid(const Config& config, const BlockHeader& header);
+
 private:
 	const Config& m_config;
 	std::shared_ptr<const IBlockDB> m_pBlockDB;
@@ -77,6 +77,17 @@ public:
 		const FullBlock& block
 	) = 0;
 
+	//
+	// Re-admits mempool txs that were removed by recently applied blocks, if they're valid on the new chain state.
+	// Should be called after a reorg, since the rewound blocks may have contained txs that the new fork doesn't.
+	// The txs were fully validated when first added, so only lock heights, conflicts, and inputs & outputs are checked.
+	//
+	virtual void ReconcileReorg(
+		std::shared_ptr<const IBlockDB> pBlockDB,
+		ITxHashSetConstPtr pTxHashSet,
+		const BlockHeader& lastConfirmedBlock
+	) = 0;
+
 	// Dandelion
 	virtual TransactionPtr GetTransactionToStem(
 		std::shared_ptr<const IBlockDB> pBlockDB,
@@ -2,6 +2,7 @@
 
 #include <Crypto/Commitment.h>
 #include <Core/Models/OutputLocation.h>
+#include <Core/Models/KernelLocation.h>
 #include <Core/Models/Transaction.h>
 #include <Core/Models/DTOs/BlockWithOutputs.h>
 #include <Core/Models/DTOs/OutputRange.h>
@@ -33,6 +34,11 @@ public:
 	//
 	virtual std::map<Commitment, OutputLocation> GetOutputsByCommitment(const std::vector<Commitment>& commitments) const = 0;
 
+	//
+	// Returns the location (block height and mmr index) of the kernel with the given excess commitment, if it's been confirmed.
+	//
+	virtual std::unique_ptr<KernelLocation> GetKernelByExcess(const Commitment& excessCommitment) const = 0;
+
 	//
 	// Returns a vector containing block ids and their outputs for the given range.
 	//
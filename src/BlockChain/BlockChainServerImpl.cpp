@@ -7,10 +7,13 @@
 #include "Processors/TxHashSetProcessor.h"
 #include "Processors/BlockProcessor.h"
 #include "ChainResyncer.h"
+#include "BootstrapFile.h"
 
 #include <GrinVersion.h>
 #include <Infrastructure/Logger.h>
+#include <Infrastructure/Metrics.h>
 #include <Core/Exceptions/BadDataException.h>
+#include <Core/Exceptions/BlockChainException.h>
 #include <Config/Config.h>
 #include <Crypto/Crypto.h>
 #include <PMMR/TxHashSet.h>
@@ -24,15 +27,18 @@ BlockChainServer::BlockChainServer(
 	std::shared_ptr<Locked<TxHashSetManager>> pTxHashSetManager,
 	std::shared_ptr<ITransactionPool> pTransactionPool,
 	std::shared_ptr<Locked<ChainState>> pChainState,
-	std::shared_ptr<Locked<IHeaderMMR>> pHeaderMMR)
+	std::shared_ptr<Locked<IHeaderMMR>> pHeaderMMR,
+	const TaskPool::Ptr& pTaskPool)
 	: m_config(config),
 	m_pDatabase(pDatabase),
 	m_pTxHashSetManager(pTxHashSetManager),
 	m_pTransactionPool(pTransactionPool),
 	m_pChainState(pChainState),
-	m_pHeaderMMR(pHeaderMMR)
+	m_pHeaderMMR(pHeaderMMR),
+	m_pTaskPool(pTaskPool),
+	m_assumeValidHeight(0)
 {
-
+	UpdateAssumeValid();
 }
 
 std::shared_ptr<BlockChainServer> BlockChainServer::Create(
@@ -40,7 +46,8 @@ std::shared_ptr<BlockChainServer> BlockChainServer::Create(
 	std::shared_ptr<Locked<IBlockDB>> pDatabase,
 	std::shared_ptr<Locked<TxHashSetManager>> pTxHashSetManager,
 	std::shared_ptr<ITransactionPool> pTransactionPool,
-	std::shared_ptr<Locked<IHeaderMMR>> pHeaderMMR)
+	std::shared_ptr<Locked<IHeaderMMR>> pHeaderMMR,
+	const TaskPool::Ptr& pTaskPool)
 {
 	const FullBlock& genesisBlock = config.GetEnvironment().GetGenesisBlock();
 	auto pGenesisIndex = std::make_shared<BlockIndex>(genesisBlock.GetHash(), 0);
@@ -62,8 +69,10 @@ std::shared_ptr<BlockChainServer> BlockChainServer::Create(
 		auto pTxHashSet = pBatch->GetTxHashSet();
 		if (pTxHashSet != nullptr)
 		{
+			// A TxHashSet that fell behind the horizon is dropped so it's downloaded again,
+			// except on archive nodes, which never download it and catch up on full blocks instead.
 			const uint64_t horizon = Consensus::GetHorizonHeight(pChainState->Read()->GetHeight(EChainType::CONFIRMED));
-			if (pTxHashSet->GetFlushedBlockHeader()->GetHeight() < horizon)
+			if (!config.GetNodeConfig().IsArchiveMode() && pTxHashSet->GetFlushedBlockHeader()->GetHeight() < horizon)
 			{
 				pTxHashSetManager->Write()->Close();
 			}
@@ -78,16 +87,37 @@ std::shared_ptr<BlockChainServer> BlockChainServer::Create(
 
 	const auto versionPath = config.GetDataDirectory() / "NODE" / "version.txt";
 	std::vector<uint8_t> versionData;
-	if (!FileUtil::ReadFile(versionPath, versionData))
+	const bool versionChanged = !FileUtil::ReadFile(versionPath, versionData)
+		|| std::string(versionData.cbegin(), versionData.cend()) != GRINPP_VERSION;
+
+	// The kernel index was added without a version bump, so existing nodes are tracked by their own marker.
+	const auto kernelIndexPath = config.GetDataDirectory() / "NODE" / "kernel_index.txt";
+	const bool kernelIndexMissing = !FileUtil::Exists(kernelIndexPath);
+
+	if (versionChanged || kernelIndexMissing)
 	{
-		LOG_WARNING_F("Updating chain for version {}", GRINPP_VERSION);
 		auto pBlockDB = pDatabase->Write();
-		pBlockDB->ClearOutputPositions();
-
 		auto pTxHashSetReader = pTxHashSetManager->Read();
+
+		if (versionChanged)
+		{
+			LOG_WARNING_F("Updating chain for version {}", GRINPP_VERSION);
+			pBlockDB->ClearOutputPositions();
+
+			if (pTxHashSetReader->GetTxHashSet() != nullptr)
+			{
+				pTxHashSetReader->GetTxHashSet()->SaveOutputPositions(
+					pChainStore->Read()->GetCandidateChain(),
+					pBlockDB.GetShared()
+				);
+			}
+		}
+
+		LOG_WARNING("Building kernel index");
+		pBlockDB->ClearKernelPositions();
 		if (pTxHashSetReader->GetTxHashSet() != nullptr)
 		{
-			pTxHashSetReader->GetTxHashSet()->SaveOutputPositions(
+			pTxHashSetReader->GetTxHashSet()->SaveKernelPositions(
 				pChainStore->Read()->GetCandidateChain(),
 				pBlockDB.GetShared()
 			);
@@ -96,6 +126,31 @@ std::shared_ptr<BlockChainServer> BlockChainServer::Create(
 		pBlockDB->Commit();
 
 		FileUtil::WriteTextToFile(versionPath, GRINPP_VERSION);
+		FileUtil::WriteTextToFile(kernelIndexPath, GRINPP_VERSION);
+	}
+
+	// Archive entries are only recorded as blocks are applied, so history is only complete if archive mode was on
+	// since the chain was empty. The marker records that, since blocks before the switch can't be archived after the fact.
+	const auto archivePath = config.GetDataDirectory() / "NODE" / "archive.txt";
+	if (config.GetNodeConfig().IsArchiveMode())
+	{
+		if (!FileUtil::Exists(archivePath))
+		{
+			if (pChainState->Read()->GetHeight(EChainType::CONFIRMED) > 0)
+			{
+				throw BLOCK_CHAIN_EXCEPTION("ARCHIVE_MODE can't be enabled on a node that was synced without it. Delete the NODE directory to resync.");
+			}
+
+			FileUtil::WriteTextToFile(archivePath, GRINPP_VERSION);
+		}
+	}
+	else if (FileUtil::Exists(archivePath))
+	{
+		// Blocks applied from now on won't be archived, so the existing entries would be incomplete if it's turned back on.
+		auto pBlockDB = pDatabase->Write();
+		pBlockDB->ClearArchiveEntries();
+		pBlockDB->Commit();
+		FileUtil::RemoveFile(archivePath);
 	}
 
 	return std::shared_ptr<BlockChainServer>(new BlockChainServer(
@@ -104,13 +159,15 @@ std::shared_ptr<BlockChainServer> BlockChainServer::Create(
 		pTxHashSetManager,
 		pTransactionPool,
 		pChainState,
-		pHeaderMMR
+		pHeaderMMR,
+		pTaskPool
 	));
 }
 
 void BlockChainServer::ResyncChain()
 {
 	ChainResyncer(m_pChainState).ResyncChain();
+	UpdateAssumeValid();
 }
 
 void BlockChainServer::UpdateSyncStatus(SyncStatus& syncStatus) const
@@ -128,11 +185,11 @@ uint64_t BlockChainServer::GetTotalDifficulty(const EChainType chainType) const
 	return m_pChainState->Read()->GetTotalDifficulty(chainType);
 }
 
-EBlockChainStatus BlockChainServer::AddBlock(const FullBlock& block)
+EBlockChainStatus BlockChainServer::AddBlock(const FullBlock::CPtr& pBlock, const std::string& source)
 {
 	try
 	{
-		return BlockProcessor(m_config, m_pChainState).ProcessBlock(block);
+		return BlockProcessor(m_config, m_pChainState, m_pTaskPool).ProcessBlock(pBlock, source);
 	}
 	catch (std::exception& e)
 	{
@@ -141,6 +198,44 @@ EBlockChainStatus BlockChainServer::AddBlock(const FullBlock& block)
 	}
 }
 
+bool BlockChainServer::VerifyBlock(const FullBlock& block) const
+{
+	try
+	{
+		// Only a pre-check, so it's read without the chain lock, and verification isn't held up by blocks being applied.
+		// Whether the block is still assumed-valid is decided again under the lock when it's applied.
+		const uint64_t assumeValidHeight = m_assumeValidHeight.load();
+		const bool assumeValid = assumeValidHeight != 0 && block.GetHeight() <= assumeValidHeight;
+		BlockValidator::VerifySelfConsistent(block, assumeValid, m_pTaskPool);
+		return true;
+	}
+	catch (std::exception& e)
+	{
+		LOG_ERROR_F("Block {} failed to verify: {}", block, e.what());
+		return false;
+	}
+}
+
+void BlockChainServer::UpdateAssumeValid()
+{
+	const std::optional<Hash>& assumeValid = m_config.GetNodeConfig().GetAssumeValid();
+	if (!assumeValid.has_value())
+	{
+		return;
+	}
+
+	auto pReader = m_pChainState->Read();
+	auto pCheckpoint = pReader->GetBlockDB()->GetBlockHeader(assumeValid.value());
+	if (pCheckpoint != nullptr && pReader->GetChainStore()->GetCandidateChain()->IsOnChain(pCheckpoint->GetHeight(), pCheckpoint->GetHash()))
+	{
+		m_assumeValidHeight = pCheckpoint->GetHeight();
+	}
+	else
+	{
+		m_assumeValidHeight = 0;
+	}
+}
+
 EBlockChainStatus BlockChainServer::AddCompactBlock(const CompactBlock& compactBlock)
 {
 	const Hash& hash = compactBlock.GetHash();
@@ -157,10 +252,10 @@ EBlockChainStatus BlockChainServer::AddCompactBlock(const CompactBlock& compactB
 
 	try
 	{
-		std::unique_ptr<FullBlock> pHydratedBlock = BlockHydrator(m_pTransactionPool).Hydrate(compactBlock);
+		FullBlock::CPtr pHydratedBlock = BlockHydrator(m_pTransactionPool).Hydrate(compactBlock);
 		if (pHydratedBlock != nullptr)
 		{
-			const EBlockChainStatus added = AddBlock(*pHydratedBlock);
+			const EBlockChainStatus added = AddBlock(pHydratedBlock, "");
 			if (added == EBlockChainStatus::INVALID)
 			{
 				return EBlockChainStatus::TRANSACTIONS_MISSING;
@@ -194,7 +289,7 @@ EBlockChainStatus BlockChainServer::ProcessTransactionHashSet(const Hash& blockH
 {
 	try
 	{
-		const bool success = TxHashSetProcessor(m_config, *this, m_pChainState).ProcessTxHashSet(blockHash, path, syncStatus);
+		const bool success = TxHashSetProcessor(m_config, *this, m_pChainState, m_pTaskPool).ProcessTxHashSet(blockHash, path, syncStatus);
 		if (success)
 		{
 			return EBlockChainStatus::SUCCESS;
@@ -254,7 +349,9 @@ EBlockChainStatus BlockChainServer::AddBlockHeader(BlockHeaderPtr pBlockHeader)
 {
 	try
 	{
-		return BlockHeaderProcessor(m_config, m_pChainState).ProcessSingleHeader(pBlockHeader);
+		const EBlockChainStatus status = BlockHeaderProcessor(m_config, m_pChainState, m_pTaskPool).ProcessSingleHeader(pBlockHeader);
+		UpdateAssumeValid();
+		return status;
 	}
 	catch (std::exception& e)
 	{
@@ -267,7 +364,9 @@ EBlockChainStatus BlockChainServer::AddBlockHeaders(const std::vector<BlockHeade
 {
 	try
 	{
-		return BlockHeaderProcessor(m_config, m_pChainState).ProcessSyncHeaders(blockHeaders);
+		const EBlockChainStatus status = BlockHeaderProcessor(m_config, m_pChainState, m_pTaskPool).ProcessSyncHeaders(blockHeaders);
+		UpdateAssumeValid();
+		return status;
 	}
 	catch (BadDataException&)
 	{
@@ -316,6 +415,21 @@ BlockHeaderPtr BlockChainServer::GetTipBlockHeader(const EChainType chainType) c
 	return m_pChainState->Read()->GetTipBlockHeader(chainType);
 }
 
+std::unique_ptr<KernelLocation> BlockChainServer::GetKernelLocation(const Commitment& excessCommitment) const
+{
+	return m_pChainState->Read()->GetKernelLocation(excessCommitment);
+}
+
+std::unique_ptr<OutputHistory> BlockChainServer::GetOutputHistory(const Commitment& outputCommitment) const
+{
+	return m_pChainState->Read()->GetOutputHistory(outputCommitment);
+}
+
+std::unique_ptr<Hash> BlockChainServer::GetArchivedBlockHash(const uint64_t height) const
+{
+	return m_pChainState->Read()->GetArchivedBlockHash(height);
+}
+
 std::unique_ptr<CompactBlock> BlockChainServer::GetCompactBlockByHash(const Hash& hash) const
 {
 	std::unique_ptr<FullBlock> pBlock = m_pChainState->Read()->GetBlockByHash(hash);
@@ -387,36 +501,150 @@ std::vector<std::pair<uint64_t, Hash>> BlockChainServer::GetBlocksNeeded(const u
 
 bool BlockChainServer::ProcessNextOrphanBlock()
 {
-	BlockHeaderPtr pNextHeader = nullptr;
-	std::shared_ptr<const FullBlock> pOrphanBlock = nullptr;
-
+	// Found through the orphan pool's index of children, rather than by looking up the next candidate header.
+	std::shared_ptr<const FullBlock> pOrphanBlock = m_pChainState->Read()->GetNextOrphanBlock();
+	if (pOrphanBlock == nullptr)
 	{
-		auto pReader = m_pChainState->Read();
-		const uint64_t height = pReader->GetHeight(EChainType::CONFIRMED) + 1;
-		pNextHeader = pReader->GetBlockHeaderByHeight(height, EChainType::CANDIDATE);
-		if (pNextHeader == nullptr)
-		{
-			return false;
-		}
-
-		pOrphanBlock = pReader->GetOrphanBlock(height, pNextHeader->GetHash());
-		if (pOrphanBlock == nullptr)
-		{
-			return false;
-		}
+		return false;
 	}
 
 	try
 	{
-		return BlockProcessor(m_config, m_pChainState).ProcessBlock(*pOrphanBlock) == EBlockChainStatus::SUCCESS;
+		return BlockProcessor(m_config, m_pChainState, m_pTaskPool).ProcessBlock(pOrphanBlock, "") == EBlockChainStatus::SUCCESS;
 	}
 	catch (std::exception&)
 	{
-		m_pChainState->Write()->GetOrphanPool()->RemoveOrphan(pNextHeader->GetHeight(), pNextHeader->GetHash());
+		m_pChainState->Write()->GetOrphanPool()->RemoveOrphan(pOrphanBlock->GetHeight(), pOrphanBlock->GetHash());
 		return false;
 	}
 }
 
+uint64_t BlockChainServer::ExportBootstrap(const fs::path& path) const
+{
+	const uint64_t confirmedHeight = GetHeight(EChainType::CONFIRMED);
+	LOG_INFO_F("Exporting {} blocks to {}", confirmedHeight, path);
+
+	BootstrapWriter writer(path, m_config.GetEnvironment().GetGenesisHash());
+	for (uint64_t height = 1; height <= confirmedHeight; height++)
+	{
+		std::unique_ptr<FullBlock> pBlock = GetBlockByHeight(height);
+		if (pBlock == nullptr)
+		{
+			LOG_ERROR_F("Block at height {} not found", height);
+			throw BLOCK_CHAIN_EXCEPTION("Block missing. Nodes synced from a TxHashSet can't export a bootstrap file.");
+		}
+
+		writer.AddBlock(*pBlock);
+	}
+
+	writer.Finalize();
+	return confirmedHeight;
+}
+
+uint64_t BlockChainServer::ImportBootstrap(const fs::path& path)
+{
+	std::unique_ptr<BootstrapReader> pReader = BootstrapReader::Open(path, m_config.GetEnvironment().GetGenesisHash());
+	LOG_INFO_F("Importing {} blocks from {}", pReader->GetNumBlocks(), path);
+
+	return ImportBlocks(pReader->GetNumBlocks(), [&pReader](const uint64_t height) {
+		return std::make_shared<const FullBlock>(pReader->GetBlock(height));
+	});
+}
+
+uint64_t BlockChainServer::ReplayChain(const IBlockChainServer& source)
+{
+	const uint64_t sourceHeight = source.GetHeight(EChainType::CONFIRMED);
+	LOG_INFO_F("Replaying {} blocks", sourceHeight);
+
+	return ImportBlocks(sourceHeight, [&source](const uint64_t height) {
+		FullBlock::CPtr pBlock = source.GetBlockByHeight(height);
+		if (pBlock == nullptr)
+		{
+			LOG_ERROR_F("Block at height {} not found", height);
+			throw BLOCK_CHAIN_EXCEPTION("Block missing. Nodes synced from a TxHashSet can't be replayed.");
+		}
+
+		return pBlock;
+	});
+}
+
+uint64_t BlockChainServer::ImportBlocks(const uint64_t lastHeight, const std::function<FullBlock::CPtr(const uint64_t)>& getBlock)
+{
+	static const uint64_t BATCH_SIZE = 128;
+
+	const uint64_t startHeight = GetHeight(EChainType::CONFIRMED) + 1;
+
+	uint64_t numApplied = 0;
+	for (uint64_t batchStart = startHeight; batchStart <= lastHeight; batchStart += BATCH_SIZE)
+	{
+		const uint64_t batchEnd = (std::min)(batchStart + BATCH_SIZE - 1, lastHeight);
+		Metrics::StageTimer timer("block.import");
+
+		std::vector<FullBlock::CPtr> blocks;
+		std::vector<BlockHeaderPtr> headers;
+		blocks.reserve(batchEnd - batchStart + 1);
+		headers.reserve(batchEnd - batchStart + 1);
+		for (uint64_t height = batchStart; height <= batchEnd; height++)
+		{
+			blocks.push_back(getBlock(height));
+			headers.push_back(blocks.back()->GetHeader());
+		}
+		timer.Mark("read");
+
+		// Headers go first, so the bodies can be checked against the candidate chain (eg. for assume-valid).
+		const EBlockChainStatus headersStatus = BlockHeaderProcessor(m_config, m_pChainState, m_pTaskPool).ProcessSyncHeaders(headers);
+		if (headersStatus != EBlockChainStatus::SUCCESS && headersStatus != EBlockChainStatus::ALREADY_EXISTS)
+		{
+			LOG_ERROR_F("Failed to add headers {} to {}", batchStart, batchEnd);
+			throw BAD_DATA_EXCEPTION("Imported headers invalid.");
+		}
+
+		UpdateAssumeValid();
+		timer.Mark("headers");
+
+		std::vector<std::future<bool>> tasks;
+		tasks.reserve(blocks.size());
+		for (const FullBlock::CPtr& pBlock : blocks)
+		{
+			tasks.push_back(m_pTaskPool->Submit(ETaskPriority::HIGH, [this, pBlock] { return VerifyBlock(*pBlock); }));
+		}
+
+		// All tasks must finish before returning, since they reference the blocks.
+		bool valid = true;
+		for (auto& task : tasks)
+		{
+			if (!m_pTaskPool->Await(task))
+			{
+				valid = false;
+			}
+		}
+
+		if (!valid)
+		{
+			throw BAD_DATA_EXCEPTION("Imported block invalid.");
+		}
+		timer.Mark("verify");
+
+		for (const FullBlock::CPtr& pBlock : blocks)
+		{
+			const EBlockChainStatus status = BlockProcessor(m_config, m_pChainState, m_pTaskPool).ProcessBlock(pBlock, "import");
+			if (status != EBlockChainStatus::SUCCESS && status != EBlockChainStatus::ALREADY_EXISTS)
+			{
+				LOG_ERROR_F("Failed to apply block {}", *pBlock);
+				throw BAD_DATA_EXCEPTION("Imported block invalid.");
+			}
+
+			++numApplied;
+		}
+		timer.Mark("apply");
+		timer.Record();
+
+		LOG_INFO_F("Imported blocks up to height {}", batchEnd);
+	}
+
+	return numApplied;
+}
+
 namespace BlockChainAPI
 {
 	BLOCK_CHAIN_API std::shared_ptr<IBlockChainServer> StartBlockChainServer(
@@ -424,8 +652,9 @@ namespace BlockChainAPI
 		std::shared_ptr<Locked<IBlockDB>> pDatabase,
 		std::shared_ptr<Locked<TxHashSetManager>> pTxHashSetManager,
 		std::shared_ptr<ITransactionPool> pTransactionPool,
-		std::shared_ptr<Locked<IHeaderMMR>> pHeaderMMR)
+		std::shared_ptr<Locked<IHeaderMMR>> pHeaderMMR,
+		const TaskPool::Ptr& pTaskPool)
 	{
-		return BlockChainServer::Create(config, pDatabase, pTxHashSetManager, pTransactionPool, pHeaderMMR);
+		return BlockChainServer::Create(config, pDatabase, pTxHashSetManager, pTransactionPool, pHeaderMMR, pTaskPool);
 	}
 }
@@ -10,7 +10,9 @@
 #include <PMMR/TxHashSetManager.h>
 #include <P2P/SyncStatus.h>
 #include <stdint.h>
+#include <atomic>
 #include <mutex>
+#include <functional>
 
 class BlockChainServer : public IBlockChainServer
 {
@@ -24,7 +26,8 @@ public:
 		std::shared_ptr<Locked<IBlockDB>> pDatabase,
 		std::shared_ptr<Locked<TxHashSetManager>> pTxHashSetManager,
 		std::shared_ptr<ITransactionPool> pTransactionPool,
-		std::shared_ptr<Locked<IHeaderMMR>> pHeaderMMR
+		std::shared_ptr<Locked<IHeaderMMR>> pHeaderMMR,
+		const TaskPool::Ptr& pTaskPool
 	);
 
 	void ResyncChain() final;
@@ -33,8 +36,10 @@ public:
 	uint64_t GetHeight(const EChainType chainType) const final;
 	uint64_t GetTotalDifficulty(const EChainType chainType) const final;
 
-	EBlockChainStatus AddBlock(const FullBlock& block) final;
+	using IBlockChainServer::AddBlock;
+	EBlockChainStatus AddBlock(const FullBlock::CPtr& pBlock, const std::string& source) final;
 	EBlockChainStatus AddCompactBlock(const CompactBlock& block) final;
+	bool VerifyBlock(const FullBlock& block) const final;
 
 	EBlockChainStatus AddBlockHeader(BlockHeaderPtr pBlockHeader) final;
 	EBlockChainStatus AddBlockHeaders(const std::vector<BlockHeaderPtr>& blockHeaders) final;
@@ -48,6 +53,9 @@ public:
 	BlockHeaderPtr GetBlockHeaderByHash(const CBigInteger<32>& hash) const final;
 	BlockHeaderPtr GetBlockHeaderByCommitment(const Commitment& outputCommitment) const final;
 	BlockHeaderPtr GetTipBlockHeader(const EChainType chainType) const final;
+	std::unique_ptr<KernelLocation> GetKernelLocation(const Commitment& excessCommitment) const final;
+	std::unique_ptr<OutputHistory> GetOutputHistory(const Commitment& outputCommitment) const final;
+	std::unique_ptr<Hash> GetArchivedBlockHash(const uint64_t height) const final;
 	std::vector<BlockHeaderPtr> GetBlockHeadersByHash(const std::vector<CBigInteger<32>>& hashes) const final;
 
 	std::unique_ptr<CompactBlock> GetCompactBlockByHash(const Hash& hash) const final;
@@ -61,6 +69,10 @@ public:
 
 	bool ProcessNextOrphanBlock() final;
 
+	uint64_t ExportBootstrap(const fs::path& path) const final;
+	uint64_t ImportBootstrap(const fs::path& path) final;
+	uint64_t ReplayChain(const IBlockChainServer& source) final;
+
 private:
 	BlockChainServer(
 		const Config& config,
@@ -68,13 +80,30 @@ private:
 		std::shared_ptr<Locked<TxHashSetManager>> pTxHashSetManager,
 		std::shared_ptr<ITransactionPool> pTransactionPool,
 		std::shared_ptr<Locked<ChainState>> pChainState,
-		std::shared_ptr<Locked<IHeaderMMR>> pHeaderMMR
+		std::shared_ptr<Locked<IHeaderMMR>> pHeaderMMR,
+		const TaskPool::Ptr& pTaskPool
 	);
 
+	//
+	// Adds the blocks after the confirmed tip up to lastHeight, as retrieved by getBlock.
+	// Each batch's headers are added first, then its bodies are verified in parallel and applied in order.
+	//
+	uint64_t ImportBlocks(const uint64_t lastHeight, const std::function<FullBlock::CPtr(const uint64_t)>& getBlock);
+
+	//
+	// Refreshes m_assumeValidHeight from the candidate chain. Called after headers are added, since that's when it can change.
+	//
+	void UpdateAssumeValid();
+
 	const Config& m_config;
 	std::shared_ptr<Locked<IBlockDB>> m_pDatabase;
 	std::shared_ptr<Locked<TxHashSetManager>> m_pTxHashSetManager;
 	std::shared_ptr<ITransactionPool> m_pTransactionPool;
 	std::shared_ptr<Locked<ChainState>> m_pChainState;
 	std::shared_ptr<Locked<IHeaderMMR>> m_pHeaderMMR;
+	TaskPool::Ptr m_pTaskPool;
+
+	// Height of the assume-valid block while it's on the candidate chain, or 0 if it's not (or none is configured).
+	// Lets VerifyBlock pre-check assume-valid without taking the chain lock.
+	std::atomic<uint64_t> m_assumeValidHeight;
 };
@@ -0,0 +1,192 @@
+#include "BootstrapFile.h"
+
+#include <Core/Serialization/ByteBuffer.h>
+#include <Core/Serialization/Serializer.h>
+#include <Core/Exceptions/BadDataException.h>
+#include <Core/Exceptions/DeserializationException.h>
+#include <Core/Exceptions/FileException.h>
+#include <Infrastructure/Logger.h>
+
+static const uint64_t BOOTSTRAP_MAGIC = 0x475250505f424f4f; // "GRPP_BOO"
+static const uint8_t BOOTSTRAP_VERSION = 1;
+static const uint64_t HEADER_SIZE = 8 + 1 + 32;
+static const uint64_t FOOTER_SIZE = 8 + 8 + 8;
+
+BootstrapWriter::BootstrapWriter(const fs::path& path, const Hash& genesisHash)
+	: m_file(path, std::ios::out | std::ios::binary | std::ios::trunc), m_position(0)
+{
+	if (!m_file.is_open())
+	{
+		throw FILE_EXCEPTION_F("Failed to create bootstrap file {}", path);
+	}
+
+	Serializer serializer;
+	serializer.Append<uint64_t>(BOOTSTRAP_MAGIC);
+	serializer.Append<uint8_t>(BOOTSTRAP_VERSION);
+	serializer.AppendBigInteger(genesisHash);
+	Write(serializer.GetBytes());
+}
+
+void BootstrapWriter::AddBlock(const FullBlock& block)
+{
+	if (block.GetHeight() != m_offsets.size() + 1)
+	{
+		throw BAD_DATA_EXCEPTION("Bootstrap blocks must be added in height order.");
+	}
+
+	m_offsets.push_back(m_position);
+
+	Serializer serializer;
+	block.Serialize(serializer);
+
+	Serializer sizeSerializer;
+	sizeSerializer.Append<uint64_t>(serializer.size());
+	Write(sizeSerializer.GetBytes());
+	Write(serializer.GetBytes());
+}
+
+void BootstrapWriter::Finalize()
+{
+	const uint64_t indexOffset = m_position;
+
+	Serializer serializer;
+	for (const uint64_t offset : m_offsets)
+	{
+		serializer.Append<uint64_t>(offset);
+	}
+
+	serializer.Append<uint64_t>(indexOffset);
+	serializer.Append<uint64_t>(m_offsets.size());
+	serializer.Append<uint64_t>(BOOTSTRAP_MAGIC);
+	Write(serializer.GetBytes());
+
+	m_file.flush();
+	if (!m_file.good())
+	{
+		throw FILE_EXCEPTION("Failed to write bootstrap file.");
+	}
+}
+
+void BootstrapWriter::Write(const std::vector<unsigned char>& bytes)
+{
+	m_file.write((const char*)bytes.data(), bytes.size());
+	m_position += bytes.size();
+}
+
+std::unique_ptr<BootstrapReader> BootstrapReader::Open(const fs::path& path, const Hash& genesisHash)
+{
+	std::ifstream file(path, std::ios::in | std::ios::binary | std::ios::ate);
+	if (!file.is_open())
+	{
+		throw FILE_EXCEPTION_F("Failed to open bootstrap file {}", path);
+	}
+
+	const uint64_t fileSize = (uint64_t)file.tellg();
+	if (fileSize < HEADER_SIZE + FOOTER_SIZE)
+	{
+		throw BAD_DATA_EXCEPTION("Bootstrap file too small.");
+	}
+
+	BootstrapReader reader(std::move(file), fileSize, {});
+
+	try
+	{
+		ByteBuffer header(reader.Read(0, HEADER_SIZE));
+		if (header.ReadU64() != BOOTSTRAP_MAGIC || header.ReadU8() != BOOTSTRAP_VERSION)
+		{
+			throw BAD_DATA_EXCEPTION("Not a bootstrap file, or unsupported version.");
+		}
+
+		if (header.ReadBigInteger<32>() != genesisHash)
+		{
+			throw BAD_DATA_EXCEPTION("Bootstrap file is for a different chain.");
+		}
+
+		ByteBuffer footer(reader.Read(fileSize - FOOTER_SIZE, FOOTER_SIZE));
+		const uint64_t indexOffset = footer.ReadU64();
+		const uint64_t numBlocks = footer.ReadU64();
+
+		// Bounded before they're used, so a corrupt footer can't overflow the index size or reserve huge amounts of memory.
+		if (numBlocks > fileSize / 8 || indexOffset < HEADER_SIZE || indexOffset > fileSize)
+		{
+			throw DESERIALIZATION_EXCEPTION();
+		}
+
+		if (footer.ReadU64() != BOOTSTRAP_MAGIC || indexOffset + (numBlocks * 8) != fileSize - FOOTER_SIZE)
+		{
+			throw BAD_DATA_EXCEPTION("Bootstrap file is truncated or was not finalized.");
+		}
+
+		ByteBuffer index(reader.Read(indexOffset, numBlocks * 8));
+		std::vector<uint64_t> offsets;
+		offsets.reserve(numBlocks);
+		for (uint64_t i = 0; i < numBlocks; i++)
+		{
+			// Each block's size prefix must lie between the header and the index.
+			const uint64_t offset = index.ReadU64();
+			if (offset < HEADER_SIZE || indexOffset - HEADER_SIZE < 8 || offset > indexOffset - 8)
+			{
+				throw DESERIALIZATION_EXCEPTION();
+			}
+
+			offsets.push_back(offset);
+		}
+
+		return std::unique_ptr<BootstrapReader>(new BootstrapReader(std::move(reader.m_file), fileSize, std::move(offsets)));
+	}
+	catch (const DeserializationException&)
+	{
+		throw BAD_DATA_EXCEPTION("Bootstrap file is malformed.");
+	}
+}
+
+FullBlock BootstrapReader::GetBlock(const uint64_t height)
+{
+	if (height == 0 || height > m_offsets.size())
+	{
+		throw BAD_DATA_EXCEPTION("Height not in bootstrap file.");
+	}
+
+	try
+	{
+		const uint64_t offset = m_offsets[height - 1];
+		const uint64_t size = ByteBuffer(Read(offset, 8)).ReadU64();
+		if (size > m_fileSize - offset - 8)
+		{
+			throw DESERIALIZATION_EXCEPTION();
+		}
+
+		ByteBuffer byteBuffer(Read(offset + 8, size));
+		FullBlock block = FullBlock::Deserialize(byteBuffer);
+		if (block.GetHeight() != height)
+		{
+			LOG_ERROR_F("Expected block at height {}, but found {}", height, block);
+			throw BAD_DATA_EXCEPTION("Bootstrap block at wrong height.");
+		}
+
+		return block;
+	}
+	catch (const DeserializationException&)
+	{
+		throw BAD_DATA_EXCEPTION("Bootstrap block is malformed.");
+	}
+}
+
+std::vector<unsigned char> BootstrapReader::Read(const uint64_t position, const uint64_t numBytes)
+{
+	if (position > m_fileSize || numBytes > m_fileSize - position)
+	{
+		throw DESERIALIZATION_EXCEPTION();
+	}
+
+	std::vector<unsigned char> bytes(numBytes);
+	m_file.seekg(position);
+	m_file.read((char*)bytes.data(), numBytes);
+	if (!m_file.good())
+	{
+		m_file.clear();
+		throw DESERIALIZATION_EXCEPTION();
+	}
+
+	return bytes;
+}
\ No newline at end of file
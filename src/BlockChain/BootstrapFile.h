@@ -0,0 +1,72 @@
+#pragma once
+
+#include <Crypto/Hash.h>
+#include <Core/Models/FullBlock.h>
+#include <filesystem.h>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+//
+// A bootstrap file holds the full blocks (which include their headers) of a chain, in height order starting at height 1,
+// followed by an index of where each block starts, so any height can be read without scanning the file.
+//
+// Layout (integers are big-endian):
+//   header:  magic (8) | version (1) | genesis hash (32)
+//   blocks:  size (8) | serialized block, for each height
+//   index:   offset of the block's size from the start of the file (8), for each height
+//   footer:  index offset (8) | number of blocks (8) | magic (8)
+//
+class BootstrapWriter
+{
+public:
+	//
+	// Throws FileException if the file can't be created.
+	//
+	BootstrapWriter(const fs::path& path, const Hash& genesisHash);
+
+	//
+	// Appends the block, which must be at the height after the previously added block.
+	//
+	void AddBlock(const FullBlock& block);
+
+	//
+	// Writes the index and footer. The file isn't readable until this is called.
+	//
+	void Finalize();
+
+private:
+	void Write(const std::vector<unsigned char>& bytes);
+
+	std::ofstream m_file;
+	uint64_t m_position;
+	std::vector<uint64_t> m_offsets;
+};
+
+class BootstrapReader
+{
+public:
+	//
+	// Throws FileException if the file can't be read, or BadDataException if it's malformed or for a different chain.
+	//
+	static std::unique_ptr<BootstrapReader> Open(const fs::path& path, const Hash& genesisHash);
+
+	uint64_t GetNumBlocks() const noexcept { return m_offsets.size(); }
+
+	//
+	// Reads the block at the given height, which must be between 1 and GetNumBlocks().
+	// Throws BadDataException if the block doesn't deserialize, or isn't at that height.
+	//
+	FullBlock GetBlock(const uint64_t height);
+
+private:
+	BootstrapReader(std::ifstream&& file, const uint64_t fileSize, std::vector<uint64_t>&& offsets)
+		: m_file(std::move(file)), m_fileSize(fileSize), m_offsets(std::move(offsets)) { }
+
+	// Throws DeserializationException if the range isn't within the file, before allocating anything.
+	std::vector<unsigned char> Read(const uint64_t position, const uint64_t numBytes);
+
+	std::ifstream m_file;
+	uint64_t m_fileSize;
+	std::vector<uint64_t> m_offsets;
+};
\ No newline at end of file
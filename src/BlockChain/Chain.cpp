@@ -2,6 +2,7 @@
 
 #include <BlockChain/Chain.h>
 #include <Core/Exceptions/BlockChainException.h>
+#include <algorithm>
 
 Chain::Chain(
 	const EChainType chainType,
@@ -33,12 +34,17 @@ std::shared_ptr<Chain> Chain::Load(
 		pDataFile->Commit();
 	}
 
+	// Read every hash in one pass over the mapped file, rather than one read per height.
+	const uint64_t size = pDataFile->GetSize();
+	const std::vector<unsigned char> hashes = pDataFile->GetDataRange(0, size);
+
 	std::vector<std::shared_ptr<const BlockIndex>> indices;
+	indices.reserve(size);
 	indices.push_back(pGenesisIndex);
 
-	while (indices.size() < pDataFile->GetSize())
+	while (indices.size() < size)
 	{
-		Hash hash = pDataFile->GetDataAt(indices.size());
+		Hash hash(&hashes[indices.size() * 32]);
 		indices.emplace_back(pBlockIndexAllocator->GetOrCreateIndex(std::move(hash), indices.size()));
 	}
 
@@ -55,6 +61,34 @@ std::shared_ptr<const BlockIndex> Chain::GetByHeight(const uint64_t height) cons
 	return nullptr;
 }
 
+std::shared_ptr<const BlockIndex> Chain::FindCommonIndex(const Chain& other) const
+{
+	auto agrees = [this, &other](const uint64_t height) { return GetHash(height) == other.GetHash(height); };
+
+	uint64_t low = 0;
+	uint64_t high = (std::min)(m_height, other.m_height);
+	if (agrees(high))
+	{
+		return m_indices[high];
+	}
+
+	// Invariant: the chains agree at 'low' (genesis), and disagree at 'high'.
+	while (high - low > 1)
+	{
+		const uint64_t middle = low + ((high - low) / 2);
+		if (agrees(middle))
+		{
+			low = middle;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+
+	return m_indices[low];
+}
+
 std::shared_ptr<const BlockIndex> Chain::AddBlock(const Hash& hash, const uint64_t height)
 {
 	if (height != m_height + 1)
@@ -50,4 +50,6 @@ void ChainResyncer::CleanDatabase(const std::shared_ptr<IBlockDB>& pBlockDB)
 	pBlockDB->ClearBlockSums();
 	pBlockDB->ClearOutputPositions();
 	pBlockDB->ClearSpentPositions();
+	pBlockDB->ClearKernelPositions();
+	pBlockDB->ClearArchiveEntries();
 }
\ No newline at end of file
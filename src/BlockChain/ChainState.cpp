@@ -19,7 +19,8 @@ ChainState::ChainState(
 	m_pHeaderMMR(pHeaderMMR),
 	m_pTransactionPool(pTransactionPool),
 	m_pTxHashSetManager(pTxHashSetManager),
-	m_pOrphanPool(std::make_shared<OrphanPool>())
+	m_pOrphanPool(std::make_shared<OrphanPool>()),
+	m_pValidatedBlockCache(std::make_shared<ValidatedBlockCache>())
 {
 
 }
@@ -130,6 +131,21 @@ BlockHeaderPtr ChainState::GetBlockHeaderByCommitment(const Commitment& outputCo
 	return BlockHeaderPtr(nullptr);
 }
 
+std::unique_ptr<KernelLocation> ChainState::GetKernelLocation(const Commitment& excessCommitment) const
+{
+	return GetBlockDB()->GetKernelPosition(excessCommitment);
+}
+
+std::unique_ptr<OutputHistory> ChainState::GetOutputHistory(const Commitment& outputCommitment) const
+{
+	return GetBlockDB()->GetOutputHistory(outputCommitment);
+}
+
+std::unique_ptr<Hash> ChainState::GetArchivedBlockHash(const uint64_t height) const
+{
+	return GetBlockDB()->GetArchivedBlockHash(height);
+}
+
 std::unique_ptr<FullBlock> ChainState::GetBlockByHash(const Hash& hash) const
 {
 	return GetBlockDB()->GetBlock(hash);
@@ -146,9 +162,20 @@ std::unique_ptr<FullBlock> ChainState::GetBlockByHeight(const uint64_t height) c
 	return std::unique_ptr<FullBlock>(nullptr);
 }
 
-std::shared_ptr<const FullBlock> ChainState::GetOrphanBlock(const uint64_t height, const Hash& hash) const
+std::shared_ptr<const FullBlock> ChainState::GetNextOrphanBlock() const
 {
-	return m_pOrphanPool->GetOrphanBlock(height, hash);
+	std::shared_ptr<const Chain> pCandidateChain = GetChainStore()->GetCandidateChain();
+	const Hash& tipHash = GetChainStore()->GetConfirmedChain()->GetTipHash();
+
+	for (const FullBlock::CPtr& pOrphan : m_pOrphanPool->GetOrphanChildren(tipHash))
+	{
+		if (pCandidateChain->IsOnChain(pOrphan->GetBlockHeader()))
+		{
+			return pOrphan;
+		}
+	}
+
+	return std::shared_ptr<const FullBlock>(nullptr);
 }
 
 std::unique_ptr<BlockWithOutputs> ChainState::GetBlockWithOutputs(const uint64_t height) const
@@ -207,6 +234,25 @@ std::vector<std::pair<uint64_t, Hash>> ChainState::GetBlocksNeeded(const uint64_
 	return blocksNeeded;
 }
 
+bool ChainState::IsAssumedValid(const BlockHeader& header) const
+{
+	const std::optional<Hash>& assumeValid = m_config.GetNodeConfig().GetAssumeValid();
+	if (!assumeValid.has_value())
+	{
+		return false;
+	}
+
+	auto pCheckpoint = GetBlockDB()->GetBlockHeader(assumeValid.value());
+	if (pCheckpoint == nullptr || header.GetHeight() > pCheckpoint->GetHeight())
+	{
+		return false;
+	}
+
+	std::shared_ptr<const Chain> pCandidateChain = GetChainStore()->GetCandidateChain();
+	return pCandidateChain->IsOnChain(pCheckpoint->GetHeight(), pCheckpoint->GetHash())
+		&& pCandidateChain->IsOnChain(header.GetHeight(), header.GetHash());
+}
+
 void ChainState::Commit()
 {
 	if (!m_chainStoreWriter.IsNull())
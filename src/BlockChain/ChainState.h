@@ -2,6 +2,7 @@
 
 #include "ChainStore.h"
 #include "OrphanPool/OrphanPool.h"
+#include "ValidatedBlockCache.h"
 
 #include <P2P/SyncStatus.h>
 #include <Core/Models/BlockHeader.h>
@@ -39,15 +40,28 @@ public:
 	BlockHeaderPtr GetBlockHeaderByHash(const Hash& hash) const;
 	BlockHeaderPtr GetBlockHeaderByHeight(const uint64_t height, const EChainType chainType) const;
 	BlockHeaderPtr GetBlockHeaderByCommitment(const Commitment& outputCommitment) const;
+	std::unique_ptr<KernelLocation> GetKernelLocation(const Commitment& excessCommitment) const;
+	std::unique_ptr<OutputHistory> GetOutputHistory(const Commitment& outputCommitment) const;
+	std::unique_ptr<Hash> GetArchivedBlockHash(const uint64_t height) const;
 
 	std::unique_ptr<FullBlock> GetBlockByHash(const Hash& hash) const;
 	std::unique_ptr<FullBlock> GetBlockByHeight(const uint64_t height) const;
-	std::shared_ptr<const FullBlock> GetOrphanBlock(const uint64_t height, const Hash& hash) const;
+
+	//
+	// Returns the orphan that builds on the confirmed tip and is on the candidate chain, if there is one.
+	//
+	std::shared_ptr<const FullBlock> GetNextOrphanBlock() const;
 
 	std::unique_ptr<BlockWithOutputs> GetBlockWithOutputs(const uint64_t height) const;
 
 	std::vector<std::pair<uint64_t, Hash>> GetBlocksNeeded(const uint64_t maxNumBlocks) const;
 
+	//
+	// Returns true if the header is on the candidate chain, at or below the configured assume-valid block,
+	// which must itself be on the candidate chain (ie. the trusted block has the most known work behind it).
+	//
+	bool IsAssumedValid(const BlockHeader& header) const;
+
 	virtual void Commit() override final;
 	virtual void Rollback() noexcept override final;
 	virtual void OnInitWrite() override final;
@@ -152,6 +166,7 @@ public:
 	}
 
 	std::shared_ptr<OrphanPool> GetOrphanPool() { return m_pOrphanPool; }
+	std::shared_ptr<ValidatedBlockCache> GetValidatedBlockCache() { return m_pValidatedBlockCache; }
 	ITransactionPoolPtr GetTransactionPool() { return m_pTransactionPool; }
 
 private:
@@ -171,6 +186,7 @@ private:
 	std::shared_ptr<ITransactionPool> m_pTransactionPool;
 	std::shared_ptr<Locked<TxHashSetManager>> m_pTxHashSetManager;
 	std::shared_ptr<OrphanPool> m_pOrphanPool;
+	std::shared_ptr<ValidatedBlockCache> m_pValidatedBlockCache;
 
 	// Writers
 	Writer<ChainStore> m_chainStoreWriter;
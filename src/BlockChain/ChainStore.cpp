@@ -79,18 +79,7 @@ std::shared_ptr<const BlockIndex> ChainStore::FindCommonIndex(const EChainType c
 	std::shared_ptr<const Chain> pChain1 = GetChain(chainType1);
 	std::shared_ptr<const Chain> pChain2 = GetChain(chainType2);
 
-	uint64_t height = (std::min)(pChain1->GetHeight(), pChain2->GetHeight());
-	std::shared_ptr<const BlockIndex> pChain1Index = pChain1->GetByHeight(height);
-	std::shared_ptr<const BlockIndex> pChain2Index = pChain2->GetByHeight(height);
-
-	while (pChain1Index->GetHash() != pChain2Index->GetHash())
-	{
-		--height;
-		pChain1Index = pChain1->GetByHeight(height);
-		pChain2Index = pChain2->GetByHeight(height);
-	}
-
-	return pChain1Index;
+	return pChain1->FindCommonIndex(*pChain2);
 }
 
 void ChainStore::ReorgChain(const EChainType source, const EChainType destination)
@@ -5,8 +5,8 @@
 struct Orphan
 {
 public:
-	explicit Orphan(const FullBlock& block)
-		: m_pBlock(std::make_shared<FullBlock>(block))
+	explicit Orphan(const FullBlock::CPtr& pBlock)
+		: m_pBlock(pBlock)
 	{
 
 	}
@@ -33,5 +33,5 @@ public:
 	uint64_t GetHeight() const noexcept { return m_pBlock->GetHeight(); }
 
 private:
-	std::shared_ptr<FullBlock> m_pBlock;
+	FullBlock::CPtr m_pBlock;
 };
\ No newline at end of file
@@ -1,106 +1,185 @@
 #include "OrphanPool.h"
 
-OrphanPool::OrphanPool() : m_orphanHeadersByHash(64)
+#include <Infrastructure/Logger.h>
+
+OrphanPool::OrphanPool() : OrphanPool(Limits())
 {
 
 }
 
-bool OrphanPool::IsOrphan(const uint64_t height, const Hash& hash) const
+OrphanPool::OrphanPool(const Limits& limits) : m_totalBytes(0), m_limits(limits), m_orphanHeadersByHash(64)
 {
-	auto heightIter = m_orphansByHeight.find(height);
-	if (heightIter != m_orphansByHeight.cend())
-	{
-		for (auto orphanIter = heightIter->second.cbegin(); orphanIter != heightIter->second.cend(); orphanIter++)
-		{
-			if (orphanIter->GetHash() == hash)
-			{
-				return true;
-			}
-		}
-	}
 
-	return false;
 }
 
-void OrphanPool::AddOrphanBlock(const FullBlock& block)
+bool OrphanPool::IsOrphan(const uint64_t height, const Hash& hash) const
 {
+	auto iter = m_orphansByHash.find(hash);
+	return iter != m_orphansByHash.cend() && iter->second.orphan.GetHeight() == height;
+}
+
+bool OrphanPool::AddOrphanBlock(const FullBlock::CPtr& pBlock, const uint64_t confirmedHeight, const std::string& source)
+{
+	const FullBlock& block = *pBlock;
 	if (!m_orphanHeadersByHash.Cached(block.GetHash()))
 	{
 		m_orphanHeadersByHash.Put(block.GetHash(), block.GetBlockHeader());
 	}
 
-	auto heightIter = m_orphansByHeight.find(block.GetHeight());
-	if (heightIter != m_orphansByHeight.cend())
+	EvictExpired();
+
+	if (m_orphansByHash.find(block.GetHash()) != m_orphansByHash.cend())
 	{
-		for (auto orphanIter = heightIter->second.cbegin(); orphanIter != heightIter->second.cend(); orphanIter++)
+		return true;
+	}
+
+	if (block.GetHeight() > confirmedHeight + m_limits.maxHeightAhead)
+	{
+		LOG_DEBUG_F("Orphan {} is too far ahead of the confirmed tip.", block);
+		return false;
+	}
+
+	const uint64_t numBytes = block.GetSerializedSize();
+	if (!source.empty())
+	{
+		auto getSourceBytes = [this, &source]() -> uint64_t {
+			auto iter = m_bytesBySource.find(source);
+			return iter != m_bytesBySource.cend() ? iter->second : 0;
+		};
+
+		while (getSourceBytes() + numBytes > m_limits.maxBytesPerSource)
 		{
-			if (orphanIter->GetHash() == block.GetHash())
+			if (!EvictFurthest(source, block.GetHeight()))
 			{
-				return;
+				LOG_DEBUG_F("Orphan quota for {} exceeded. Dropping {}.", source, block);
+				return false;
 			}
 		}
-
-		heightIter->second.emplace_back(Orphan(block));
 	}
-	else
+
+	while (m_totalBytes + numBytes > m_limits.maxBytes || m_orphansByHash.size() >= m_limits.maxOrphans)
 	{
-		m_orphansByHeight[block.GetHeight()] = std::vector<Orphan>({ Orphan(block) });
+		if (!EvictFurthest("", block.GetHeight()))
+		{
+			LOG_DEBUG_F("Orphan pool full. Dropping {}.", block);
+			return false;
+		}
 	}
+
+	const Clock::time_point now = Clock::now();
+	m_orphansByHash.insert({ block.GetHash(), Entry{ Orphan(pBlock), source, numBytes, now } });
+	m_childrenByPreviousHash.insert({ block.GetPreviousHash(), block.GetHash() });
+	m_orphansByHeight.insert({ block.GetHeight(), block.GetHash() });
+	m_orphansByAge.insert({ now, block.GetHash() });
+	m_bytesBySource[source] += numBytes;
+	m_totalBytes += numBytes;
+
+	return true;
 }
 
 std::shared_ptr<const FullBlock> OrphanPool::GetOrphanBlock(const uint64_t height, const Hash& hash) const
 {
-	auto heightIter = m_orphansByHeight.find(height);
-	if (heightIter != m_orphansByHeight.cend())
+	auto iter = m_orphansByHash.find(hash);
+	if (iter != m_orphansByHash.cend() && iter->second.orphan.GetHeight() == height)
 	{
-		for (auto orphanIter = heightIter->second.cbegin(); orphanIter != heightIter->second.cend(); orphanIter++)
-		{
-			if (orphanIter->GetHash() == hash)
-			{
-				return orphanIter->GetBlock();
-			}
-		}
+		return iter->second.orphan.GetBlock();
 	}
 
 	return std::shared_ptr<const FullBlock>(nullptr);
 }
 
-std::shared_ptr<const FullBlock> OrphanPool::GetNextOrphanBlock(const uint64_t height, const Hash& previousHash) const
+std::vector<FullBlock::CPtr> OrphanPool::GetOrphanChildren(const Hash& previousHash) const
 {
-	auto heightIter = m_orphansByHeight.find(height);
-	if (heightIter != m_orphansByHeight.cend())
+	std::vector<FullBlock::CPtr> children;
+
+	auto range = m_childrenByPreviousHash.equal_range(previousHash);
+	for (auto childIter = range.first; childIter != range.second; childIter++)
 	{
-		for (auto orphanIter = heightIter->second.cbegin(); orphanIter != heightIter->second.cend(); orphanIter++)
-		{
-			if (orphanIter->GetBlock()->GetPreviousHash() == previousHash)
-			{
-				return orphanIter->GetBlock();
-			}
-		}
+		children.push_back(m_orphansByHash.at(childIter->second).orphan.GetBlock());
 	}
 
-	return std::shared_ptr<const FullBlock>(nullptr);
+	return children;
 }
 
 void OrphanPool::RemoveOrphan(const uint64_t height, const Hash& hash)
 {
-	auto iter = m_orphansByHeight.find(height);
-	if (iter != m_orphansByHeight.end())
+	if (IsOrphan(height, hash))
 	{
-		for (auto orphanIter = iter->second.begin(); orphanIter != iter->second.end(); orphanIter++)
+		Evict(hash);
+	}
+}
+
+void OrphanPool::Evict(const Hash& hash)
+{
+	auto iter = m_orphansByHash.find(hash);
+	if (iter == m_orphansByHash.end())
+	{
+		return;
+	}
+
+	const Entry& entry = iter->second;
+
+	auto range = m_childrenByPreviousHash.equal_range(entry.orphan.GetBlock()->GetPreviousHash());
+	for (auto childIter = range.first; childIter != range.second; childIter++)
+	{
+		if (childIter->second == hash)
 		{
-			if (orphanIter->GetHash() == hash)
-			{
-				iter->second.erase(orphanIter);
-				break;
-			}
+			m_childrenByPreviousHash.erase(childIter);
+			break;
 		}
+	}
+
+	m_orphansByHeight.erase({ entry.orphan.GetHeight(), hash });
+	m_orphansByAge.erase({ entry.addedTime, hash });
+
+	auto sourceIter = m_bytesBySource.find(entry.source);
+	sourceIter->second -= entry.numBytes;
+	if (sourceIter->second == 0)
+	{
+		m_bytesBySource.erase(sourceIter);
+	}
+
+	m_totalBytes -= entry.numBytes;
+	m_orphansByHash.erase(iter);
+}
+
+void OrphanPool::EvictExpired()
+{
+	const auto now = Clock::now();
 
-		if (iter->second.empty())
+	size_t numExpired = 0;
+	while (!m_orphansByAge.empty() && m_orphansByAge.cbegin()->first + m_limits.maxAge < now)
+	{
+		const Hash hash = m_orphansByAge.cbegin()->second;
+		Evict(hash);
+		++numExpired;
+	}
+
+	if (numExpired > 0)
+	{
+		LOG_DEBUG_F("{} orphans expired.", numExpired);
+	}
+}
+
+//
+// Evicts the highest orphan (from the given source, if not empty) that is further from the tip than the given height.
+// Returns false if there is no such orphan, in which case the block at the given height is the one that should go.
+//
+bool OrphanPool::EvictFurthest(const std::string& source, const uint64_t height)
+{
+	for (auto iter = m_orphansByHeight.crbegin(); iter != m_orphansByHeight.crend() && iter->first > height; iter++)
+	{
+		if (source.empty() || m_orphansByHash.at(iter->second).source == source)
 		{
-			m_orphansByHeight.erase(height);
+			LOG_TRACE_F("Evicting orphan at height {}.", iter->first);
+
+			const Hash hash = iter->second;
+			Evict(hash);
+			return true;
 		}
 	}
+
+	return false;
 }
 
 BlockHeaderPtr OrphanPool::GetOrphanHeader(const Hash& hash) const
@@ -5,23 +5,89 @@
 #include <Crypto/Hash.h>
 #include <Core/Models/FullBlock.h>
 #include <unordered_map>
+#include <chrono>
+#include <set>
+#include <string>
+#include <vector>
 #include <caches/Cache.h>
 
+//
+// Holds blocks whose previous block hasn't been processed yet.
+//
+// Orphans are indexed by hash, and by previous hash so the children of a newly connected block are found in O(1).
+// The pool is bounded both in total bytes and in bytes per source peer. When a limit is exceeded, the orphans
+// furthest above the confirmed tip are evicted first, since they're the least likely to connect soon.
+// Orphans also expire after a while, so a stalled fork can't pin memory indefinitely.
+//
 class OrphanPool
 {
 public:
+	struct Limits
+	{
+		// Memory used by orphans, overall and per source peer.
+		uint64_t maxBytes = 64 * 1024 * 1024;
+		uint64_t maxBytesPerSource = 32 * 1024 * 1024;
+		size_t maxOrphans = 4096;
+
+		// Well beyond the BlockSyncer's download window. Anything further ahead is most likely junk.
+		uint64_t maxHeightAhead = 4096;
+
+		std::chrono::milliseconds maxAge = std::chrono::minutes(30);
+	};
+
 	OrphanPool();
+	explicit OrphanPool(const Limits& limits);
 
 	bool IsOrphan(const uint64_t height, const Hash& hash) const;
-	void AddOrphanBlock(const FullBlock& block);
+
+	//
+	// Adds the block to the pool, evicting other orphans if needed to stay within the limits.
+	// The source identifies the peer the block came from (empty if unknown), and is used to enforce per-peer quotas.
+	// Returns false if the block was rejected (eg. it's too far ahead of the confirmed tip, or would be evicted immediately).
+	//
+	bool AddOrphanBlock(const FullBlock::CPtr& pBlock, const uint64_t confirmedHeight, const std::string& source = "");
 	std::shared_ptr<const FullBlock> GetOrphanBlock(const uint64_t height, const Hash& hash) const;
-	std::shared_ptr<const FullBlock> GetNextOrphanBlock(const uint64_t height, const Hash& previousHash) const;
+
+	//
+	// Returns the orphans that build directly on the given block (usually one, or more after a fork).
+	//
+	std::vector<FullBlock::CPtr> GetOrphanChildren(const Hash& previousHash) const;
+
 	void RemoveOrphan(const uint64_t height, const Hash& hash);
 
+	size_t GetNumOrphans() const { return m_orphansByHash.size(); }
+	uint64_t GetTotalBytes() const { return m_totalBytes; }
+
 	void AddOrphanHeader(BlockHeaderPtr pHeader);
 	BlockHeaderPtr GetOrphanHeader(const Hash& hash) const;
 
 private:
-	std::unordered_map<uint64_t, std::vector<Orphan>> m_orphansByHeight;
+	using Clock = std::chrono::steady_clock;
+
+	struct Entry
+	{
+		Orphan orphan;
+		std::string source;
+		uint64_t numBytes;
+		Clock::time_point addedTime;
+	};
+
+	void Evict(const Hash& hash);
+	void EvictExpired();
+	bool EvictFurthest(const std::string& source, const uint64_t height);
+
+	std::unordered_map<Hash, Entry> m_orphansByHash;
+	std::unordered_multimap<Hash, Hash> m_childrenByPreviousHash;
+
+	// Sorted by height, so the orphans furthest from the tip can be evicted first.
+	std::set<std::pair<uint64_t, Hash>> m_orphansByHeight;
+
+	// Sorted by the time they were added, so expired orphans are found without scanning the whole pool.
+	std::set<std::pair<Clock::time_point, Hash>> m_orphansByAge;
+
+	std::unordered_map<std::string, uint64_t> m_bytesBySource;
+	uint64_t m_totalBytes;
+	Limits m_limits;
+
 	LRUCache<Hash, BlockHeaderPtr> m_orphanHeadersByHash;
-};
+};
\ No newline at end of file
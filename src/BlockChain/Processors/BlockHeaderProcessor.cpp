@@ -7,11 +7,12 @@
 #include <PMMR/HeaderMMR.h>
 #include <Common/Util/HexUtil.h>
 #include <Common/Util/StringUtil.h>
+#include <algorithm>
 
 static const size_t SYNC_BATCH_SIZE = 128;
 
-BlockHeaderProcessor::BlockHeaderProcessor(const Config& config, std::shared_ptr<Locked<ChainState>> pChainState)
-	: m_config(config), m_pChainState(pChainState)
+BlockHeaderProcessor::BlockHeaderProcessor(const Config& config, std::shared_ptr<Locked<ChainState>> pChainState, const TaskPool::Ptr& pTaskPool)
+	: m_config(config), m_pChainState(pChainState), m_pTaskPool(pTaskPool), m_timer("header.process")
 {
 
 }
@@ -20,7 +21,24 @@ EBlockChainStatus BlockHeaderProcessor::ProcessSingleHeader(const BlockHeaderPtr
 {
 	LOG_TRACE_F("Validating {}", *pHeader);
 
+	if (m_pChainState->Read()->GetBlockHeaderByHash(pHeader->GetHash()) != nullptr)
+	{
+		LOG_TRACE_F("Header {} already processed.", *pHeader);
+		return EBlockChainStatus::ALREADY_EXISTS;
+	}
+
+	// Verify PoW before locking
+	if (!BlockHeaderValidator::PreValidate(m_config, *pHeader))
+	{
+		LOG_ERROR_F("Header {} failed to validate", *pHeader);
+		throw BAD_DATA_EXCEPTION("Header failed to validate.");
+	}
+
+	m_timer.Mark("prevalidate");
+
 	auto pLockedState = m_pChainState->BatchWrite();
+	m_timer.Mark("lock_wait");
+
 	auto pBlockDB = pLockedState->GetBlockDB();
 	auto pHeaderMMR = pLockedState->GetHeaderMMR();
 	//auto pSyncChain = pLockedState->GetChainStore()->GetSyncChain();
@@ -48,7 +66,7 @@ EBlockChainStatus BlockHeaderProcessor::ProcessSingleHeader(const BlockHeaderPtr
 
 	// Validate the header.
 	auto pPreviousHeaderPtr = pBlockDB->GetBlockHeader(pCandidateChain->GetTipHash());
-	if (!BlockHeaderValidator(m_config, pBlockDB, pHeaderMMR).IsValidHeader(*pHeader, *pPreviousHeaderPtr))
+	if (!BlockHeaderValidator(m_config, pBlockDB, pHeaderMMR).IsValidInContext(*pHeader, *pPreviousHeaderPtr))
 	{
 		LOG_ERROR_F("Header {} failed to validate", *pHeader);
 		throw BAD_DATA_EXCEPTION("Header failed to validate.");
@@ -58,10 +76,14 @@ EBlockChainStatus BlockHeaderProcessor::ProcessSingleHeader(const BlockHeaderPtr
 	pHeaderMMR->AddHeader(*pHeader);
 	pCandidateChain->AddBlock(pHeader->GetHash(), pHeader->GetHeight());
 	//pLockedState->GetChainStore()->ReorgChain(EChainType::CANDIDATE, EChainType::SYNC);
+	m_timer.Mark("validate");
 
 	LOG_DEBUG_F("Successfully validated {}", *pHeader);
 
 	pLockedState->Commit();
+	m_timer.Mark("commit");
+
+	ReportTimings(*pHeader, *pHeader);
 	return EBlockChainStatus::SUCCESS;
 }
 
@@ -145,14 +167,37 @@ EBlockChainStatus BlockHeaderProcessor::ProcessSyncHeaders(const std::vector<Blo
 		}
 	}
 
-	const size_t size = headers.size();
+	// Skip headers already on the candidate chain, so they don't get their PoW validated again.
+	std::vector<BlockHeaderPtr> newHeaders;
+	{
+		auto pReader = m_pChainState->Read();
+		auto pCandidateChain = pReader->GetChainStore()->GetCandidateChain();
+
+		auto iter = std::find_if(
+			headers.cbegin(),
+			headers.cend(),
+			[&pCandidateChain](const BlockHeaderPtr& pHeader) { return !pCandidateChain->IsOnChain(pHeader); }
+		);
+		newHeaders = std::vector<BlockHeaderPtr>(iter, headers.cend());
+	}
+
+	if (newHeaders.empty())
+	{
+		LOG_DEBUG("Headers already processed.");
+		return EBlockChainStatus::SUCCESS;
+	}
+
+	PreValidateHeaders(newHeaders);
+	m_timer.Mark("prevalidate");
+
+	const size_t size = newHeaders.size();
 	size_t index = 0;
 
 	std::vector<BlockHeaderPtr> chunkedHeaders;
 	chunkedHeaders.reserve(SYNC_BATCH_SIZE);
 	while (index < size)
 	{
-		chunkedHeaders.push_back(headers[index++]);
+		chunkedHeaders.push_back(newHeaders[index++]);
 		if (index % SYNC_BATCH_SIZE == 0 || index == size)
 		{
 			const EBlockChainStatus processChunkStatus = ProcessChunkedSyncHeaders(chunkedHeaders);
@@ -165,12 +210,75 @@ EBlockChainStatus BlockHeaderProcessor::ProcessSyncHeaders(const std::vector<Blo
 		}
 	}
 
+	ReportTimings(*newHeaders.front(), *newHeaders.back());
 	return EBlockChainStatus::SUCCESS;
 }
 
+void BlockHeaderProcessor::ReportTimings(const BlockHeader& firstHeader, const BlockHeader& lastHeader) const
+{
+	m_timer.Record();
+
+	const uint64_t thresholdMicros = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+		m_config.GetNodeConfig().GetSlowBlockThreshold()
+	).count();
+	if (m_timer.GetTotalMicros() > thresholdMicros)
+	{
+		LOG_WARNING_F(
+			"Slow headers: from_height={} to_height={} count={} {}",
+			firstHeader.GetHeight(),
+			lastHeader.GetHeight(),
+			lastHeader.GetHeight() - firstHeader.GetHeight() + 1,
+			m_timer.Format()
+		);
+	}
+}
+
+void BlockHeaderProcessor::PreValidateHeaders(const std::vector<BlockHeaderPtr>& headers) const
+{
+	LOG_TRACE_F("Pre-validating {} headers", headers.size());
+
+	const size_t numTasks = (std::min)(m_pTaskPool->GetNumThreads(), headers.size());
+	const size_t headersPerTask = (headers.size() + numTasks - 1) / numTasks;
+
+	std::vector<std::future<bool>> tasks;
+	for (size_t begin = 0; begin < headers.size(); begin += headersPerTask)
+	{
+		const size_t end = (std::min)(begin + headersPerTask, headers.size());
+		tasks.push_back(m_pTaskPool->Submit(ETaskPriority::HIGH, [this, &headers, begin, end] {
+			for (size_t i = begin; i < end; i++)
+			{
+				if (!BlockHeaderValidator::PreValidate(m_config, *headers[i]))
+				{
+					LOG_ERROR_F("Header invalid: {}", *headers[i]);
+					return false;
+				}
+			}
+
+			return true;
+		}));
+	}
+
+	// All tasks must finish before returning, since they reference the headers.
+	bool valid = true;
+	for (auto& task : tasks)
+	{
+		if (!m_pTaskPool->Await(task))
+		{
+			valid = false;
+		}
+	}
+
+	if (!valid)
+	{
+		throw BAD_DATA_EXCEPTION("Header invalid.");
+	}
+}
+
 EBlockChainStatus BlockHeaderProcessor::ProcessChunkedSyncHeaders(const std::vector<BlockHeaderPtr>& headers)
 {
 	auto pLockedState = m_pChainState->BatchWrite();
+	m_timer.Mark("lock_wait");
+
 	auto pHeaderMMR = pLockedState->GetHeaderMMR();
 	auto pChainStore = pLockedState->GetChainStore();
 	auto pCandidateChain = pChainStore->GetCandidateChain();
@@ -204,6 +312,7 @@ EBlockChainStatus BlockHeaderProcessor::ProcessChunkedSyncHeaders(const std::vec
 
 	// Validate the headers.
 	ValidateHeaders(pLockedState, newHeaders);
+	m_timer.Mark("validate");
 
 	// If total difficulty increases, accept sync chain as new candidate chain.
 	if (newHeaders.back()->GetTotalDifficulty() <= totalDifficulty)
@@ -216,6 +325,8 @@ EBlockChainStatus BlockHeaderProcessor::ProcessChunkedSyncHeaders(const std::vec
 	}
 
 	pLockedState->Commit();
+	m_timer.Mark("commit");
+
 	return EBlockChainStatus::SUCCESS;
 }
 
@@ -270,6 +381,10 @@ void BlockHeaderProcessor::RewindMMR(Writer<ChainState> pLockedState, const std:
 	//}
 }
 
+//
+// Performs the contextual validation of each header, and adds it to the MMR & BlockDB.
+// Headers must already have passed BlockHeaderValidator::PreValidate.
+//
 void BlockHeaderProcessor::ValidateHeaders(Writer<ChainState> pLockedState, const std::vector<BlockHeaderPtr>& headers)
 {
 	LOG_TRACE("Validating headers");
@@ -289,7 +404,7 @@ void BlockHeaderProcessor::ValidateHeaders(Writer<ChainState> pLockedState, cons
 
 	for (auto pHeader : headers)
 	{
-		if (!validator.IsValidHeader(*pHeader, *pPreviousHeader))
+		if (!validator.IsValidInContext(*pHeader, *pPreviousHeader))
 		{
 			LOG_ERROR_F("Header invalid: {}", *pHeader);
 			throw BAD_DATA_EXCEPTION("Header invalid.");
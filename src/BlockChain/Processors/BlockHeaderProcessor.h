@@ -3,13 +3,15 @@
 #include "../ChainState.h"
 
 #include <Config/Config.h>
+#include <Common/TaskPool.h>
 #include <BlockChain/BlockChainStatus.h>
 #include <Core/Models/BlockHeader.h>
+#include <Infrastructure/Metrics.h>
 
 class BlockHeaderProcessor
 {
 public:
-	BlockHeaderProcessor(const Config& config, std::shared_ptr<Locked<ChainState>> pChainState);
+	BlockHeaderProcessor(const Config& config, std::shared_ptr<Locked<ChainState>> pChainState, const TaskPool::Ptr& pTaskPool);
 
 	//
 	// Validates and adds a single header to the candidate chain.
@@ -34,6 +36,14 @@ private:
 		BlockHeaderPtr pHeader
 	);
 
+	//
+	// Performs the stateless validation (PoW, version, etc) of each header in parallel, without holding any chain locks.
+	// Throws BadDataException if any of the headers are invalid.
+	//
+	void PreValidateHeaders(
+		const std::vector<BlockHeaderPtr>& headers
+	) const;
+
 	EBlockChainStatus ProcessChunkedSyncHeaders(
 		const std::vector<BlockHeaderPtr>& headers
 	);
@@ -53,6 +63,8 @@ private:
 		const std::vector<BlockHeaderPtr>& headers
 	);
 
+	void ReportTimings(const BlockHeader& firstHeader, const BlockHeader& lastHeader) const;
+
 	//void AddSyncHeaders(
 	//	Writer<ChainState> pLockedState,
 	//	const std::vector<BlockHeaderPtr>& headers
@@ -60,4 +72,6 @@ private:
 
 	const Config& m_config;
 	std::shared_ptr<Locked<ChainState>> m_pChainState;
+	TaskPool::Ptr m_pTaskPool;
+	Metrics::StageTimer m_timer;
 };
\ No newline at end of file
@@ -11,16 +11,19 @@
 #include <Common/Util/StringUtil.h>
 #include <algorithm>
 
-BlockProcessor::BlockProcessor(const Config& config, std::shared_ptr<Locked<ChainState>> pChainState)
-	: m_config(config), m_pChainState(pChainState)
+BlockProcessor::BlockProcessor(const Config& config, std::shared_ptr<Locked<ChainState>> pChainState, const TaskPool::Ptr& pTaskPool)
+	: m_config(config), m_pChainState(pChainState), m_pTaskPool(pTaskPool), m_timer("block.process")
 {
 
 }
 
-EBlockChainStatus BlockProcessor::ProcessBlock(const FullBlock& block)
-{	
-	const uint64_t candidateHeight = m_pChainState->Read()->GetHeight(EChainType::CANDIDATE);
-	const uint64_t horizonHeight = Consensus::GetHorizonHeight(candidateHeight);
+EBlockChainStatus BlockProcessor::ProcessBlock(const FullBlock::CPtr& pBlock, const std::string& source)
+{
+	const FullBlock& block = *pBlock;
+	// Archive nodes sync every block from genesis rather than the TxHashSet, so only blocks
+	// that would reorg beyond the horizon of the confirmed chain are refused.
+	const EChainType horizonChain = m_config.GetNodeConfig().IsArchiveMode() ? EChainType::CONFIRMED : EChainType::CANDIDATE;
+	const uint64_t horizonHeight = Consensus::GetHorizonHeight(m_pChainState->Read()->GetHeight(horizonChain));
 
 	BlockHeaderPtr pHeader = block.GetBlockHeader();
 	if (pHeader->GetHeight() <= horizonHeight)
@@ -30,29 +33,64 @@ EBlockChainStatus BlockProcessor::ProcessBlock(const FullBlock& block)
 	}
 
 	// Make sure header is processed and valid before processing block.
-	const EBlockChainStatus headerStatus = BlockHeaderProcessor(m_config, m_pChainState).ProcessSingleHeader(pHeader); // TODO: Can probably ignore status, as long as no exceptions
+	const EBlockChainStatus headerStatus = BlockHeaderProcessor(m_config, m_pChainState, m_pTaskPool).ProcessSingleHeader(pHeader); // TODO: Can probably ignore status, as long as no exceptions
+	m_timer.Mark("header");
 	if (headerStatus == EBlockChainStatus::SUCCESS
 		|| headerStatus == EBlockChainStatus::ALREADY_EXISTS
 		|| headerStatus == EBlockChainStatus::ORPHANED)
 	{
-		// Verify block is self-consistent before locking
-		BlockValidator::VerifySelfConsistent(block);
+		// Verify block is self-consistent before locking.
+		// The candidate chain can change before the lock is taken, so assume-valid is checked again in ValidateAndAddBlock.
+		const bool assumeValid = m_pChainState->Read()->IsAssumedValid(*pHeader);
+		BlockValidator::VerifySelfConsistent(block, assumeValid, m_pTaskPool);
+		m_timer.Mark("self_consistent");
 
-		const EBlockChainStatus returnStatus = ProcessBlockInternal(block);
+		const EBlockChainStatus returnStatus = ProcessBlockInternal(pBlock, source);
 		if (returnStatus == EBlockChainStatus::SUCCESS)
 		{
 			LOG_DEBUG_F("Block {} successfully processed.", *pHeader);
 		}
 
+		ReportTimings(block, returnStatus);
 		return returnStatus;
 	}
 
 	return headerStatus;
 }
 
-EBlockChainStatus BlockProcessor::ProcessBlockInternal(const FullBlock& block)
+void BlockProcessor::ReportTimings(const FullBlock& block, const EBlockChainStatus status) const
+{
+	// Only blocks that were actually validated are interesting. Duplicates and orphans would just skew the histograms.
+	if (status != EBlockChainStatus::SUCCESS)
+	{
+		return;
+	}
+
+	m_timer.Record();
+
+	const uint64_t thresholdMicros = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+		m_config.GetNodeConfig().GetSlowBlockThreshold()
+	).count();
+	if (m_timer.GetTotalMicros() > thresholdMicros)
+	{
+		LOG_WARNING_F(
+			"Slow block: hash={} height={} inputs={} outputs={} kernels={} {}",
+			block.GetHash(),
+			block.GetHeight(),
+			block.GetInputs().size(),
+			block.GetOutputs().size(),
+			block.GetKernels().size(),
+			m_timer.Format()
+		);
+	}
+}
+
+EBlockChainStatus BlockProcessor::ProcessBlockInternal(const FullBlock::CPtr& pBlock, const std::string& source)
 {
+	const FullBlock& block = *pBlock;
 	auto pBatch = m_pChainState->BatchWrite();
+	m_timer.Mark("lock_wait");
+
 	auto pChainStore = pBatch->GetChainStore();
 	auto pOrphanPool = pBatch->GetOrphanPool();
 	auto pConfirmedChain = pChainStore->GetConfirmedChain();
@@ -72,7 +110,8 @@ EBlockChainStatus BlockProcessor::ProcessBlockInternal(const FullBlock& block)
 	}
 
 	// 3. Orphan if block should be processed as an orphan
-	const BlockProcessingInfo info = DetermineBlockStatus(block, pBatch);
+	const BlockProcessingInfo info = DetermineBlockStatus(pBlock, pBatch);
+	m_timer.Mark("status");
 	if (info.status == EBlockStatus::ORPHAN)
 	{
 		if (pOrphanPool->IsOrphan(block.GetHeight(), block.GetHash()))
@@ -81,7 +120,10 @@ EBlockChainStatus BlockProcessor::ProcessBlockInternal(const FullBlock& block)
 			return EBlockChainStatus::ALREADY_EXISTS;
 		}
 
-		pOrphanPool->AddOrphanBlock(block);
+		if (!pOrphanPool->AddOrphanBlock(pBlock, pConfirmedChain->GetHeight(), source))
+		{
+			LOG_DEBUG_F("Orphan {} not added to the pool.", block);
+		}
 
 		return EBlockChainStatus::ORPHANED;
 	}
@@ -94,17 +136,20 @@ EBlockChainStatus BlockProcessor::ProcessBlockInternal(const FullBlock& block)
 	{
 		assert(info.status == EBlockStatus::NEXT_BLOCK);
 
-		ValidateAndAddBlock(block, pBatch);
+		ValidateAndAddBlock(pBlock, pBatch);
 		pConfirmedChain->AddBlock(block.GetHash(), block.GetHeight());
 		pBatch->Commit();
+		m_timer.Mark("commit");
 
 		return EBlockChainStatus::SUCCESS;
 	}
 }
 
-BlockProcessor::BlockProcessingInfo BlockProcessor::DetermineBlockStatus(const FullBlock& block, Writer<ChainState> pBatch)
+BlockProcessor::BlockProcessingInfo BlockProcessor::DetermineBlockStatus(const FullBlock::CPtr& pBlock, Writer<ChainState> pBatch)
 {
+	const FullBlock& block = *pBlock;
 	auto pOrphanPool = pBatch->GetOrphanPool();
+	auto pValidatedBlockCache = pBatch->GetValidatedBlockCache();
 	auto pBlockDB = pBatch->GetBlockDB();
 	auto pChainStore = pBatch->GetChainStore();
 	auto pConfirmedChain = pChainStore->GetConfirmedChain();
@@ -122,13 +167,19 @@ BlockProcessor::BlockProcessingInfo BlockProcessor::DetermineBlockStatus(const F
 		return { EBlockStatus::NEXT_BLOCK, {} };
 	}
 
-	auto pForkBlock = std::make_shared<const FullBlock>(block);
+	FullBlock::CPtr pForkBlock = pBlock;
 
 	std::vector<FullBlock::CPtr> reorgBlocks({ pForkBlock });
 	while (!pConfirmedChain->IsOnChain(pForkBlock->GetHeight() - 1, pForkBlock->GetPreviousHash()))
 	{
 		Hash previousHash = pForkBlock->GetPreviousHash();
 		pForkBlock = pOrphanPool->GetOrphanBlock(pForkBlock->GetHeight() - 1, previousHash);
+		if (pForkBlock == nullptr)
+		{
+			// Prefer the cached copy, since it won't need to be re-validated.
+			pForkBlock = pValidatedBlockCache->GetBlock(previousHash);
+		}
+
 		if (pForkBlock == nullptr)
 		{
 			pForkBlock = pBlockDB->GetBlock(previousHash);
@@ -172,13 +223,12 @@ void BlockProcessor::HandleReorg(Writer<ChainState> pBatch, const std::vector<Fu
 		throw BLOCK_CHAIN_EXCEPTION("Failed to find header.");
 	}
 
-	// TODO: Add rewound transactions back to TxPool
-
 	pTxHashSet->Rewind(pBlockDB, *pCommonHeader);
+	m_timer.Mark("rewind");
 
 	for (const FullBlock::CPtr& pBlock : reorgBlocks)
 	{
-		ValidateAndAddBlock(*pBlock, pBatch);
+		ValidateAndAddBlock(pBlock, pBatch);
 	}
 
 	if (reorgBlocks.back()->GetTotalDifficulty() > totalDifficulty)
@@ -191,6 +241,11 @@ void BlockProcessor::HandleReorg(Writer<ChainState> pBatch, const std::vector<Fu
 		}
 
 		pBatch->Commit();
+		m_timer.Mark("commit");
+
+		// Transactions from the rewound blocks that didn't make it into the new fork go back into the mempool.
+		pBatch->GetTransactionPool()->ReconcileReorg(pBlockDB, pTxHashSet, *reorgBlocks.back()->GetHeader());
+		m_timer.Mark("tx_pool");
 	}
 	else
 	{
@@ -204,11 +259,22 @@ void BlockProcessor::HandleReorg(Writer<ChainState> pBatch, const std::vector<Fu
 		}
 
 		pBlockDB->Commit();
+		m_timer.Mark("commit");
+
+		// The pool was reconciled against the fork's blocks as they were validated, but the confirmed chain didn't change.
+		// Transactions those blocks removed go back into the mempool.
+		auto pConfirmedTip = pBlockDB->GetBlockHeader(pBatch->GetChainStore()->GetConfirmedChain()->GetTipHash());
+		if (pConfirmedTip != nullptr)
+		{
+			pBatch->GetTransactionPool()->ReconcileReorg(pBlockDB, pBatch->GetTxHashSetManager()->GetTxHashSet(), *pConfirmedTip);
+			m_timer.Mark("tx_pool");
+		}
 	}
 }
 
-void BlockProcessor::ValidateAndAddBlock(const FullBlock& block, Writer<ChainState> pBatch)
+void BlockProcessor::ValidateAndAddBlock(const FullBlock::CPtr& pBlock, Writer<ChainState> pBatch)
 {
+	const FullBlock& block = *pBlock;
 	auto pOrphanPool = pBatch->GetOrphanPool();
 	auto pBlockDB = pBatch->GetBlockDB();
 	auto pTxHashSet = pBatch->GetTxHashSetManager()->GetTxHashSet();
@@ -228,11 +294,19 @@ void BlockProcessor::ValidateAndAddBlock(const FullBlock& block, Writer<ChainSta
 		throw BAD_DATA_EXCEPTION("Failed to apply block to the TxHashSet.");
 	}
 
-	BlockSums blockSums = ContextualBlockValidator(m_config, pBlockDB, pTxHashSet).ValidateBlock(block);
+	m_timer.Mark("apply");
+
+	const bool assumeValid = pBatch->IsAssumedValid(*block.GetHeader());
+	BlockSums blockSums = ContextualBlockValidator(m_config, pBlockDB, pTxHashSet).ValidateBlock(block, assumeValid);
+	m_timer.Mark("contextual_validation");
 
 	pBlockDB->RemoveOutputPositions(block.GetInputCommitments());
 	pBlockDB->AddBlockSums(block.GetHash(), blockSums);
 	pBlockDB->AddBlock(block);
 	pOrphanPool->RemoveOrphan(block.GetHeight(), block.GetHash());
+	pBatch->GetValidatedBlockCache()->AddBlock(pBlock);
+	m_timer.Mark("db_write");
+
 	pTxPool->ReconcileBlock(pBlockDB, pTxHashSet, block);
+	m_timer.Mark("tx_pool");
 }
\ No newline at end of file
@@ -3,8 +3,10 @@
 #include "../ChainState.h"
 
 #include <Config/Config.h>
+#include <Common/TaskPool.h>
 #include <Core/Models/FullBlock.h>
 #include <BlockChain/BlockChainStatus.h>
+#include <Infrastructure/Metrics.h>
 
 enum class EBlockStatus
 {
@@ -21,17 +23,23 @@ class BlockProcessor
 		std::vector<FullBlock::CPtr> reorgBlocks;
 	};
 public:
-	BlockProcessor(const Config& config, std::shared_ptr<Locked<ChainState>> pChainState);
+	BlockProcessor(const Config& config, std::shared_ptr<Locked<ChainState>> pChainState, const TaskPool::Ptr& pTaskPool);
 
-	EBlockChainStatus ProcessBlock(const FullBlock& block);
+	//
+	// The block is shared, not copied, with the orphan pool and the validated block cache.
+	//
+	EBlockChainStatus ProcessBlock(const FullBlock::CPtr& pBlock, const std::string& source);
 
 private:
-	EBlockChainStatus ProcessBlockInternal(const FullBlock& block);
+	EBlockChainStatus ProcessBlockInternal(const FullBlock::CPtr& pBlock, const std::string& source);
 	void HandleReorg(Writer<ChainState> pBatch, const std::vector<FullBlock::CPtr>& reorgBlocks);
-	void ValidateAndAddBlock(const FullBlock& block, Writer<ChainState> pLockedState);
+	void ValidateAndAddBlock(const FullBlock::CPtr& pBlock, Writer<ChainState> pLockedState);
 
-	BlockProcessingInfo DetermineBlockStatus(const FullBlock& block, Writer<ChainState> pLockedState);
+	BlockProcessingInfo DetermineBlockStatus(const FullBlock::CPtr& pBlock, Writer<ChainState> pLockedState);
+	void ReportTimings(const FullBlock& block, const EBlockChainStatus status) const;
 
 	const Config& m_config;
 	std::shared_ptr<Locked<ChainState>> m_pChainState;
+	TaskPool::Ptr m_pTaskPool;
+	Metrics::StageTimer m_timer;
 };
\ No newline at end of file
@@ -10,10 +10,12 @@
 TxHashSetProcessor::TxHashSetProcessor(
 	const Config& config,
 	IBlockChainServer& blockChainServer,
-	std::shared_ptr<Locked<ChainState>> pChainState)
+	std::shared_ptr<Locked<ChainState>> pChainState,
+	const TaskPool::Ptr& pTaskPool)
 	: m_config(config),
 	m_blockChainServer(blockChainServer),
-	m_pChainState(pChainState)
+	m_pChainState(pChainState),
+	m_pTaskPool(pTaskPool)
 {
 
 }
@@ -39,7 +41,7 @@ bool TxHashSetProcessor::ProcessTxHashSet(const Hash& blockHash, const fs::path&
 	}
 
 	// 3. Validate entire TxHashSet
-	auto pBlockSums = pTxHashSet->ValidateTxHashSet(*pHeader, m_blockChainServer, syncStatus);
+	auto pBlockSums = pTxHashSet->ValidateTxHashSet(*pHeader, m_blockChainServer, *m_pTaskPool, syncStatus);
 	if (pBlockSums == nullptr)
 	{
 		LOG_ERROR_F("Validation of {} failed.", path);
@@ -55,6 +57,9 @@ bool TxHashSetProcessor::ProcessTxHashSet(const Hash& blockHash, const fs::path&
 	LOG_DEBUG("Saving output positions.");
 	pTxHashSet->SaveOutputPositions(pChainStateBatch->GetChainStore()->GetCandidateChain(), pChainStateBatch->GetBlockDB());
 
+	LOG_DEBUG("Saving kernel positions.");
+	pTxHashSet->SaveKernelPositions(pChainStateBatch->GetChainStore()->GetCandidateChain(), pChainStateBatch->GetBlockDB());
+
 	// 6. Store TxHashSet
 	LOG_DEBUG("Using TxHashSet.");
 	pChainStateBatch->GetTxHashSetManager()->SetTxHashSet(pTxHashSet);
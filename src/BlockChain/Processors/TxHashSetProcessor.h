@@ -4,6 +4,7 @@
 
 #include <PMMR/TxHashSet.h>
 #include <Config/Config.h>
+#include <Common/TaskPool.h>
 #include <Crypto/Hash.h>
 #include <P2P/SyncStatus.h>
 #include <filesystem.h>
@@ -17,7 +18,12 @@ class IBlockDB;
 class TxHashSetProcessor
 {
 public:
-	TxHashSetProcessor(const Config& config, IBlockChainServer& blockChainServer, std::shared_ptr<Locked<ChainState>> pChainState);
+	TxHashSetProcessor(
+		const Config& config,
+		IBlockChainServer& blockChainServer,
+		std::shared_ptr<Locked<ChainState>> pChainState,
+		const TaskPool::Ptr& pTaskPool
+	);
 
 	bool ProcessTxHashSet(const Hash& blockHash, const fs::path& path, SyncStatus& syncStatus);
 
@@ -27,4 +33,5 @@ private:
 	const Config& m_config;
 	IBlockChainServer& m_blockChainServer;
 	std::shared_ptr<Locked<ChainState>> m_pChainState;
+	TaskPool::Ptr m_pTaskPool;
 };
\ No newline at end of file
@@ -0,0 +1,27 @@
+#include "ValidatedBlockCache.h"
+
+// Enough to cover the deepest reorgs seen in practice.
+static const size_t MAX_BLOCKS = 64;
+
+ValidatedBlockCache::ValidatedBlockCache() : m_blocksByHash(MAX_BLOCKS)
+{
+
+}
+
+void ValidatedBlockCache::AddBlock(const FullBlock::CPtr& pBlock)
+{
+	if (pBlock->WasValidated() && !m_blocksByHash.Cached(pBlock->GetHash()))
+	{
+		m_blocksByHash.Put(pBlock->GetHash(), pBlock);
+	}
+}
+
+FullBlock::CPtr ValidatedBlockCache::GetBlock(const Hash& hash) const
+{
+	if (m_blocksByHash.Cached(hash))
+	{
+		return m_blocksByHash.Get(hash);
+	}
+
+	return nullptr;
+}
\ No newline at end of file
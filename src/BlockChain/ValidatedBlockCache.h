@@ -0,0 +1,31 @@
+#pragma once
+
+#include <Crypto/Hash.h>
+#include <Core/Models/FullBlock.h>
+#include <caches/Cache.h>
+
+//
+// A bounded cache of blocks that have already passed context-free validation (rangeproofs, kernel signatures, etc).
+//
+// The header hash doesn't commit to the full block body, so lookups are by hash, but the cached block itself
+// is returned. Callers must use the returned block, rather than a copy of the same block from another source,
+// to skip re-validation.
+//
+class ValidatedBlockCache
+{
+public:
+	ValidatedBlockCache();
+
+	//
+	// Caches the block, if it was validated. Evicts the least recently used block once full.
+	//
+	void AddBlock(const FullBlock::CPtr& pBlock);
+
+	//
+	// Returns the cached block with the given hash, or null if it's not cached.
+	//
+	FullBlock::CPtr GetBlock(const Hash& hash) const;
+
+private:
+	LRUCache<Hash, FullBlock::CPtr> m_blocksByHash;
+};
\ No newline at end of file
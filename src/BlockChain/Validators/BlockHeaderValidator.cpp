@@ -19,6 +19,11 @@ BlockHeaderValidator::BlockHeaderValidator(
 }
 
 bool BlockHeaderValidator::IsValidHeader(const BlockHeader& header, const BlockHeader& previousHeader) const
+{
+	return PreValidate(m_config, header) && IsValidInContext(header, previousHeader);
+}
+
+bool BlockHeaderValidator::IsValidInContext(const BlockHeader& header, const BlockHeader& previousHeader) const
 {
 	// Validate Height
 	if (header.GetHeight() != (previousHeader.GetHeight() + 1))
@@ -27,6 +32,34 @@ bool BlockHeaderValidator::IsValidHeader(const BlockHeader& header, const BlockH
 		return false;
 	}
 
+	// Validate Timestamp
+	if (header.GetTimestamp() <= previousHeader.GetTimestamp())
+	{
+		LOG_WARNING_F("Timestamp not after previous for header {}", header);
+		return false;
+	}
+
+	// Validate Difficulty
+	const bool validDifficulty = PoWManager(m_config, m_pBlockDB).IsDifficultyValid(header, previousHeader);
+	if (!validDifficulty)
+	{
+		LOG_WARNING_F("Invalid difficulty for header {}", header);
+		return false;
+	}
+
+	// Validate the previous header MMR root is correct against the local MMR.
+	if (m_pHeaderMMR->Root(header.GetHeight() - 1) != header.GetPreviousRoot())
+	{
+		LOG_WARNING_F("Invalid Header MMR Root for header {}", header);
+		return false;
+	}
+
+	LOG_TRACE_F("Header {} valid", header);
+	return true;
+}
+
+bool BlockHeaderValidator::PreValidate(const Config& config, const BlockHeader& header)
+{
 	// Validate Timestamp - Ensure timestamp not too far in the future
 	if (header.GetTimestamp() > Consensus::GetMaxBlockTime(std::chrono::system_clock::now()))
 	{
@@ -35,35 +68,20 @@ bool BlockHeaderValidator::IsValidHeader(const BlockHeader& header, const BlockH
 	}
 
 	// Validate Version
-	const uint64_t validHeaderVersion = Consensus::GetHeaderVersion(m_config.GetEnvironment().GetEnvironmentType(), header.GetHeight());
+	const uint64_t validHeaderVersion = Consensus::GetHeaderVersion(config.GetEnvironment().GetEnvironmentType(), header.GetHeight());
 	if (header.GetVersion() != validHeaderVersion)
 	{
 		LOG_WARNING_F("Invalid version for header {}", header);
 		return false;
 	}
 
-	// Validate Timestamp
-	if (header.GetTimestamp() <= previousHeader.GetTimestamp())
-	{
-		LOG_WARNING_F("Timestamp not after previous for header {}", header);
-		return false;
-	}
-
 	// Validate Proof Of Work
-	const bool validPoW = PoWManager(m_config, m_pBlockDB).IsPoWValid(header, previousHeader);
+	const bool validPoW = PoWManager::IsProofValid(config, header);
 	if (!validPoW)
 	{
 		LOG_WARNING_F("Invalid Proof of Work for header {}", header);
 		return false;
 	}
 
-	// Validate the previous header MMR root is correct against the local MMR.
-	if (m_pHeaderMMR->Root(header.GetHeight() - 1) != header.GetPreviousRoot())
-	{
-		LOG_WARNING_F("Invalid Header MMR Root for header {}", header);
-		return false;
-	}
-
-	LOG_TRACE_F("Header {} valid", header);
 	return true;
 }
\ No newline at end of file
@@ -12,8 +12,23 @@ class BlockHeaderValidator
 public:
 	BlockHeaderValidator(const Config& config, std::shared_ptr<const IBlockDB> pBlockDB, std::shared_ptr<const IHeaderMMR> pHeaderMMR);
 
+	//
+	// Performs all header validation (both PreValidate and IsValidInContext).
+	//
 	bool IsValidHeader(const BlockHeader& header, const BlockHeader& previousHeader) const;
 
+	//
+	// Performs the validation that depends on chain state (height, difficulty, header MMR root).
+	// The header must already have passed PreValidate.
+	//
+	bool IsValidInContext(const BlockHeader& header, const BlockHeader& previousHeader) const;
+
+	//
+	// Performs the validation that doesn't depend on any chain state (version, timestamp, cuckoo cycle).
+	// This is where nearly all of the cost lies, and since no chain locks are needed, it's safe to run in parallel.
+	//
+	static bool PreValidate(const Config& config, const BlockHeader& header);
+
 	const Config& m_config;
 	std::shared_ptr<const IBlockDB> m_pBlockDB;
 	std::shared_ptr<const IHeaderMMR> m_pHeaderMMR;
@@ -7,31 +7,50 @@
 #include <Core/Validation/KernelSumValidator.h>
 #include <Common/Util/FunctionalUtil.h>
 #include <Consensus/Common.h>
+#include <Infrastructure/Metrics.h>
 #include <PMMR/TxHashSet.h>
 #include <algorithm>
 
 // Validates all the elements in a block that can be checked without additional data. 
 // Includes commitment sums and kernels, reward, etc.
-void BlockValidator::VerifySelfConsistent(const FullBlock& block)
+void BlockValidator::VerifySelfConsistent(const FullBlock& block, const bool assumeValid, const TaskPool::Ptr& pTaskPool)
 {
-	if (block.WasValidated())
+	if (block.WasValidated() || (assumeValid && block.WasAssumedValid()))
 	{
 		LOG_TRACE_F("Block {} already validated", block);
 		return;
 	}
 
-	VerifyBody(block);
+	VerifyBody(block, assumeValid, pTaskPool);
 	VerifyKernelLockHeights(block);
 	VerifyCoinbase(block);
 
-	block.MarkAsValidated();
+	if (assumeValid)
+	{
+		block.MarkAsAssumedValid();
+	}
+	else
+	{
+		block.MarkAsValidated();
+	}
 }
 
-void BlockValidator::VerifyBody(const FullBlock& block)
+void BlockValidator::VerifyBody(const FullBlock& block, const bool assumeValid, const TaskPool::Ptr& pTaskPool)
 {
+	static Metrics::Counter& assumedValid = MetricsAPI::GetCounter("block.assume_valid.skipped");
+
 	try
 	{
-		TransactionBodyValidator().Validate(block.GetTransactionBody(), false);
+		if (assumeValid)
+		{
+			LOG_TRACE_F("Skipping rangeproofs and kernel signatures for assumed-valid block {}", block);
+			TransactionBodyValidator().ValidateStructure(block.GetTransactionBody(), false);
+			assumedValid.Increment();
+		}
+		else
+		{
+			TransactionBodyValidator(pTaskPool).Validate(block.GetTransactionBody(), false);
+		}
 	}
 	catch (std::exception& e)
 	{
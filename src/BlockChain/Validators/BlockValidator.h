@@ -6,15 +6,22 @@
 #include <Core/Traits/Lockable.h>
 #include <Config/Config.h>
 #include <PMMR/TxHashSet.h>
+#include <Common/TaskPool.h>
 #include <memory>
 
 class BlockValidator
 {
 public:
-	static void VerifySelfConsistent(const FullBlock& block);
+	//
+	// When assumeValid is true (the block is an ancestor of the configured assume-valid block), rangeproofs and
+	// kernel signatures are not verified, and the block is only marked as assumed-valid. A later call without
+	// assumeValid verifies it fully. Structure, lock heights and coinbase sums are always checked.
+	// When a task pool is given, large batches of kernel signatures are verified in parallel.
+	//
+	static void VerifySelfConsistent(const FullBlock& block, const bool assumeValid = false, const TaskPool::Ptr& pTaskPool = nullptr);
 
 private:
-	static void VerifyBody(const FullBlock& block);
+	static void VerifyBody(const FullBlock& block, const bool assumeValid, const TaskPool::Ptr& pTaskPool);
 	static void VerifyKernelLockHeights(const FullBlock& block);
 	static void VerifyCoinbase(const FullBlock& block);
 };
\ No newline at end of file
@@ -8,9 +8,9 @@
 #include <Consensus/Common.h>
 
 // Validates a block is self-consistent and validates the state (eg. MMRs).
-BlockSums ContextualBlockValidator::ValidateBlock(const FullBlock& block) const
+BlockSums ContextualBlockValidator::ValidateBlock(const FullBlock& block, const bool assumeValid) const
 {
-	BlockValidator::VerifySelfConsistent(block);
+	BlockValidator::VerifySelfConsistent(block, assumeValid);
 
 	// Verify coinbase maturity
 	const uint64_t maximumBlockHeight = Consensus::GetMaxCoinbaseHeight(
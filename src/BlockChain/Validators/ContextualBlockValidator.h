@@ -15,7 +15,10 @@ public:
 		const ITxHashSetConstPtr& pTxHashSet)
 	: m_config(config), m_pBlockDB(pBlockDB), m_pTxHashSet(pTxHashSet) { }
 
-	BlockSums ValidateBlock(const FullBlock& block) const;
+	//
+	// assumeValid must be evaluated under the same chain lock the block is applied with (see ChainState::IsAssumedValid).
+	//
+	BlockSums ValidateBlock(const FullBlock& block, const bool assumeValid) const;
 
 private:
 	const Config& m_config;
@@ -1,6 +1,7 @@
 #include <Core/File/AppendOnlyFile.h>
 #include <Core/Exceptions/FileException.h>
 #include <Common/Util/FileUtil.h>
+#include <algorithm>
 
 void AppendOnlyFile::Load()
 {
@@ -77,10 +78,17 @@ uint64_t AppendOnlyFile::GetSize() const noexcept
 
 bool AppendOnlyFile::Read(const uint64_t position, const uint64_t numBytes, std::vector<unsigned char>& data) const
 {
-	// TODO: Handle partial read from m_mmap and m_buffer
+	if (position + numBytes > GetSize())
+	{
+		return false;
+	}
+
 	if (position < m_bufferIndex)
 	{
-		m_pMappedFile->Read(position, numBytes, data);
+		// The range can start in the mapped file and continue into the uncommitted buffer.
+		const uint64_t numMapped = (std::min)(numBytes, m_bufferIndex - position);
+		m_pMappedFile->Read(position, numMapped, data);
+		data.insert(data.end(), m_buffer.cbegin(), m_buffer.cbegin() + (numBytes - numMapped));
 	}
 	else
 	{
@@ -1,11 +1,29 @@
 #include <Core/Models/FullBlock.h>
 
 FullBlock::FullBlock(BlockHeaderPtr pBlockHeader, TransactionBody&& transactionBody)
-	: m_pBlockHeader(pBlockHeader), m_transactionBody(std::move(transactionBody)), m_validated(false)
+	: m_pBlockHeader(pBlockHeader), m_transactionBody(std::move(transactionBody)), m_serializedSize(0), m_validated(false), m_assumedValid(false)
 {
 
 }
 
+FullBlock::FullBlock(BlockHeaderPtr pBlockHeader, TransactionBody&& transactionBody, const uint64_t serializedSize)
+	: m_pBlockHeader(pBlockHeader), m_transactionBody(std::move(transactionBody)), m_serializedSize(serializedSize), m_validated(false), m_assumedValid(false)
+{
+
+}
+
+uint64_t FullBlock::GetSerializedSize() const
+{
+	if (m_serializedSize == 0)
+	{
+		Serializer serializer;
+		Serialize(serializer);
+		m_serializedSize = serializer.size();
+	}
+
+	return m_serializedSize;
+}
+
 void FullBlock::Serialize(Serializer& serializer) const
 {
 	m_pBlockHeader->Serialize(serializer);
@@ -14,10 +32,13 @@ void FullBlock::Serialize(Serializer& serializer) const
 
 FullBlock FullBlock::Deserialize(ByteBuffer& byteBuffer)
 {
+	const size_t remainingBefore = byteBuffer.GetRemainingSize();
+
 	BlockHeaderPtr pBlockHeader = std::make_shared<const BlockHeader>(BlockHeader::Deserialize(byteBuffer));
 	TransactionBody transactionBody = TransactionBody::Deserialize(byteBuffer);
 
-	return FullBlock(pBlockHeader, std::move(transactionBody));
+	// The size is already known, so avoid reserializing the block.
+	return FullBlock(pBlockHeader, std::move(transactionBody), remainingBefore - byteBuffer.GetRemainingSize());
 }
 
 Json::Value FullBlock::ToJSON() const
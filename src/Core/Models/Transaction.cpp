@@ -12,6 +12,7 @@ Transaction::Transaction(BlindingFactor&& offset, TransactionBody&& transactionB
 	Serialize(serializer);
 
 	m_hash = Crypto::Blake2b(serializer.GetBytes());
+	m_serializedSize = serializer.size();
 }
 
 void Transaction::Serialize(Serializer& serializer) const
@@ -13,17 +13,32 @@
 // Checks the excess value against the signature as well as range proofs for each output.
 void TransactionBodyValidator::Validate(const TransactionBody& transactionBody, const bool withReward)
 {
-	ValidateWeight(transactionBody, withReward);
-	VerifySorted(transactionBody);
-	VerifyCutThrough(transactionBody);
+	ValidateStructure(transactionBody, withReward);
 	VerifyRangeProofs(transactionBody.GetOutputs());
 	
-	if (!KernelSignatureValidator::VerifyKernelSignatures(transactionBody.GetKernels()))
+	if (!VerifyKernelSignatures(transactionBody.GetKernels()))
 	{
 		throw BAD_DATA_EXCEPTION("Kernel signatures invalid");
 	}
 }
 
+bool TransactionBodyValidator::VerifyKernelSignatures(const std::vector<TransactionKernel>& kernels) const
+{
+	if (m_pTaskPool != nullptr)
+	{
+		return KernelSignatureValidator::VerifyKernelSignatures(kernels, *m_pTaskPool);
+	}
+
+	return KernelSignatureValidator::VerifyKernelSignatures(kernels);
+}
+
+void TransactionBodyValidator::ValidateStructure(const TransactionBody& transactionBody, const bool withReward)
+{
+	ValidateWeight(transactionBody, withReward);
+	VerifySorted(transactionBody);
+	VerifyCutThrough(transactionBody);
+}
+
 // Verify the body is not too big in terms of number of inputs|outputs|kernels.
 void TransactionBodyValidator::ValidateWeight(const TransactionBody& transactionBody, const bool withReward)
 {
@@ -5,38 +5,28 @@
 #include "secp256k1-zkp/include/secp256k1_commitment.h"
 #include "secp256k1-zkp/include/secp256k1_schnorrsig.h"
 #include "Pedersen.h"
+#include "SecpArray.h"
+#include "SecpContext.h"
+#include "VerifiedCache.h"
 
 #include <Infrastructure/Logger.h>
 #include <Crypto/RandomNumberGenerator.h>
 #include <Crypto/CryptoException.h>
 
-const uint64_t MAX_WIDTH = 1 << 20;
-const size_t SCRATCH_SPACE_SIZE = 256 * MAX_WIDTH;
-
 AggSig& AggSig::GetInstance()
 {
 	static AggSig instance;
 	return instance;
 }
 
-AggSig::AggSig()
-{
-	m_pContext = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
-}
-
-AggSig::~AggSig()
-{
-	secp256k1_context_destroy(m_pContext);
-}
-
 SecretKey AggSig::GenerateSecureNonce() const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	secp256k1_context* pContext = SecpContext::GetThreadInstance().Get();
 
 	std::vector<unsigned char> nonce(32);
 	const SecretKey seed = RandomNumberGenerator::GenerateRandom32();
 
-	const int result = secp256k1_aggsig_export_secnonce_single(m_pContext, nonce.data(), seed.data());
+	const int result = secp256k1_aggsig_export_secnonce_single(pContext, nonce.data(), seed.data());
 	if (result == 1)
 	{
 		return SecretKey(CBigInteger<32>(std::move(nonce)));
@@ -47,24 +37,24 @@ SecretKey AggSig::GenerateSecureNonce() const
 
 std::unique_ptr<CompactSignature> AggSig::SignMessage(const SecretKey& secretKey, const PublicKey& publicKey, const Hash& message)
 {
-	std::lock_guard<std::shared_mutex> writeLock(m_mutex);
+	SecpContext& context = SecpContext::GetThreadInstance();
+	if (!context.Randomize())
+	{
+		LOG_ERROR("Context randomization failed.");
+		return std::unique_ptr<CompactSignature>(nullptr);
+	}
 
+	secp256k1_context* pContext = context.Get();
 	const SecretKey randomSeed = RandomNumberGenerator::GenerateRandom32();
-	const int randomizeResult = secp256k1_context_randomize(m_pContext, randomSeed.data());
-	if (randomizeResult != 1)
-    {
-		LOG_ERROR("Context randomization failed.");
-        return std::unique_ptr<CompactSignature>(nullptr);
-    }
 
 	secp256k1_pubkey pubKey;
-	int pubKeyParsed = secp256k1_ec_pubkey_parse(m_pContext, &pubKey, publicKey.data(), publicKey.size());
+	int pubKeyParsed = secp256k1_ec_pubkey_parse(pContext, &pubKey, publicKey.data(), publicKey.size());
 
 	if (pubKeyParsed == 1)
 	{
 		secp256k1_ecdsa_signature signature;
 		const int signedResult = secp256k1_aggsig_sign_single(
-			m_pContext,
+			pContext,
 			&signature.data[0],
 			message.data(),
 			secretKey.data(),
@@ -79,7 +69,7 @@ std::unique_ptr<CompactSignature> AggSig::SignMessage(const SecretKey& secretKey
 		if (signedResult == 1)
 		{
 			std::vector<unsigned char> signatureBytes(64);
-			const int serializedResult = secp256k1_ecdsa_signature_serialize_compact(m_pContext, signatureBytes.data(), &signature);
+			const int serializedResult = secp256k1_ecdsa_signature_serialize_compact(pContext, signatureBytes.data(), &signature);
 			if (serializedResult == 1)
 			{
 				return std::make_unique<CompactSignature>(CompactSignature(CBigInteger<64>(std::move(signatureBytes))));
@@ -92,18 +82,18 @@ std::unique_ptr<CompactSignature> AggSig::SignMessage(const SecretKey& secretKey
 
 bool AggSig::VerifyMessageSignature(const CompactSignature& signature, const PublicKey& publicKey, const Hash& message) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	secp256k1_context* pContext = SecpContext::GetThreadInstance().Get();
 
 	secp256k1_ecdsa_signature secpSig;
-	const int parseSignatureResult = secp256k1_ecdsa_signature_parse_compact(m_pContext, &secpSig, signature.GetSignatureBytes().data());
+	const int parseSignatureResult = secp256k1_ecdsa_signature_parse_compact(pContext, &secpSig, signature.GetSignatureBytes().data());
 	if (parseSignatureResult == 1)
 	{
 		secp256k1_pubkey pubkey;
-		const int pubkeyResult = secp256k1_ec_pubkey_parse(m_pContext, &pubkey, publicKey.data(), publicKey.size());
+		const int pubkeyResult = secp256k1_ec_pubkey_parse(pContext, &pubkey, publicKey.data(), publicKey.size());
 
 		if (pubkeyResult == 1)
 		{
-			const int verifyResult = secp256k1_aggsig_verify_single(m_pContext, secpSig.data, message.data(), nullptr, &pubkey, &pubkey, nullptr, false);
+			const int verifyResult = secp256k1_aggsig_verify_single(pContext, secpSig.data, message.data(), nullptr, &pubkey, &pubkey, nullptr, false);
 			if (verifyResult == 1)
 			{
 				return true;
@@ -116,18 +106,18 @@ bool AggSig::VerifyMessageSignature(const CompactSignature& signature, const Pub
 
 std::unique_ptr<Signature> AggSig::BuildSignature(const SecretKey& secretKey, const Commitment& commitment, const Hash& message)
 {
-	std::lock_guard<std::shared_mutex> writeLock(m_mutex);
-
-	const SecretKey randomSeed = RandomNumberGenerator::GenerateRandom32();
-	const int randomizeResult = secp256k1_context_randomize(m_pContext, randomSeed.data());
-	if (randomizeResult != 1)
+	SecpContext& context = SecpContext::GetThreadInstance();
+	if (!context.Randomize())
 	{
 		LOG_ERROR("Context randomization failed");
 		return nullptr;
 	}
 
+	secp256k1_context* pContext = context.Get();
+	const SecretKey randomSeed = RandomNumberGenerator::GenerateRandom32();
+
 	secp256k1_pedersen_commitment parsedCommitment;
-	const int commitmentResult = secp256k1_pedersen_commitment_parse(m_pContext, &parsedCommitment, commitment.data());
+	const int commitmentResult = secp256k1_pedersen_commitment_parse(pContext, &parsedCommitment, commitment.data());
 	if (commitmentResult != 1)
 	{
 		LOG_ERROR("secp256k1_pedersen_commitment_parse failed");
@@ -135,7 +125,7 @@ std::unique_ptr<Signature> AggSig::BuildSignature(const SecretKey& secretKey, co
 	}
 
 	secp256k1_pubkey pubKey;
-	const int pubkeyResult = secp256k1_pedersen_commitment_to_pubkey(m_pContext, &pubKey, &parsedCommitment);
+	const int pubkeyResult = secp256k1_pedersen_commitment_to_pubkey(pContext, &pubKey, &parsedCommitment);
 	if (pubkeyResult != 1)
 	{
 		LOG_ERROR("secp256k1_pedersen_commitment_to_pubkey failed");
@@ -144,7 +134,7 @@ std::unique_ptr<Signature> AggSig::BuildSignature(const SecretKey& secretKey, co
 
 	secp256k1_ecdsa_signature signature;
 	const int signedResult = secp256k1_aggsig_sign_single(
-		m_pContext,
+		pContext,
 		&signature.data[0],
 		message.data(),
 		secretKey.data(),
@@ -167,27 +157,27 @@ std::unique_ptr<Signature> AggSig::BuildSignature(const SecretKey& secretKey, co
 
 std::unique_ptr<CompactSignature> AggSig::CalculatePartialSignature(const SecretKey& secretKey, const SecretKey& secretNonce, const PublicKey& sumPubKeys, const PublicKey& sumPubNonces, const Hash& message)
 {
-	std::lock_guard<std::shared_mutex> writeLock(m_mutex);
+	SecpContext& context = SecpContext::GetThreadInstance();
+	if (!context.Randomize())
+	{
+		LOG_ERROR("Context randomization failed");
+		return std::unique_ptr<CompactSignature>(nullptr);
+	}
 
+	secp256k1_context* pContext = context.Get();
 	const SecretKey randomSeed = RandomNumberGenerator::GenerateRandom32();
-	const int randomizeResult = secp256k1_context_randomize(m_pContext, randomSeed.data());
-    if (randomizeResult != 1)
-    {
-		LOG_ERROR("Context randomization failed");
-        return std::unique_ptr<CompactSignature>(nullptr);
-    }
 
 	secp256k1_pubkey pubKeyForE;
-	int pubKeyParsed = secp256k1_ec_pubkey_parse(m_pContext, &pubKeyForE, sumPubKeys.data(), sumPubKeys.size());
+	int pubKeyParsed = secp256k1_ec_pubkey_parse(pContext, &pubKeyForE, sumPubKeys.data(), sumPubKeys.size());
 
 	secp256k1_pubkey pubNoncesForE;
-	int noncesParsed = secp256k1_ec_pubkey_parse(m_pContext, &pubNoncesForE, sumPubNonces.data(), sumPubNonces.size());
+	int noncesParsed = secp256k1_ec_pubkey_parse(pContext, &pubNoncesForE, sumPubNonces.data(), sumPubNonces.size());
 
 	if (pubKeyParsed == 1 && noncesParsed == 1)
 	{
 		secp256k1_ecdsa_signature signature;
 		const int signedResult = secp256k1_aggsig_sign_single(
-			m_pContext,
+			pContext,
 			&signature.data[0],
 			message.data(),
 			secretKey.data(),
@@ -202,7 +192,7 @@ std::unique_ptr<CompactSignature> AggSig::CalculatePartialSignature(const Secret
 		if (signedResult == 1)
 		{
 			std::vector<unsigned char> signatureBytes(64);
-			const int serializedResult = secp256k1_ecdsa_signature_serialize_compact(m_pContext, signatureBytes.data(), &signature);
+			const int serializedResult = secp256k1_ecdsa_signature_serialize_compact(pContext, signatureBytes.data(), &signature);
 			if (serializedResult == 1)
 			{
 				return std::make_unique<CompactSignature>(CompactSignature(CBigInteger<64>(std::move(signatureBytes))));
@@ -215,25 +205,25 @@ std::unique_ptr<CompactSignature> AggSig::CalculatePartialSignature(const Secret
 
 bool AggSig::VerifyPartialSignature(const CompactSignature& partialSignature, const PublicKey& publicKey, const PublicKey& sumPubKeys, const PublicKey& sumPubNonces, const Hash& message) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	secp256k1_context* pContext = SecpContext::GetThreadInstance().Get();
 
 	secp256k1_ecdsa_signature signature;
 	
-	const int parseSignatureResult = secp256k1_ecdsa_signature_parse_compact(m_pContext, &signature, partialSignature.GetSignatureBytes().data());
+	const int parseSignatureResult = secp256k1_ecdsa_signature_parse_compact(pContext, &signature, partialSignature.GetSignatureBytes().data());
 	if (parseSignatureResult == 1)
 	{
 		secp256k1_pubkey pubkey;
-		const int pubkeyResult = secp256k1_ec_pubkey_parse(m_pContext, &pubkey, publicKey.data(), publicKey.size());
+		const int pubkeyResult = secp256k1_ec_pubkey_parse(pContext, &pubkey, publicKey.data(), publicKey.size());
 
 		secp256k1_pubkey sumPubKey;
-		const int sumPubkeysResult = secp256k1_ec_pubkey_parse(m_pContext, &sumPubKey, sumPubKeys.data(), sumPubKeys.size());
+		const int sumPubkeysResult = secp256k1_ec_pubkey_parse(pContext, &sumPubKey, sumPubKeys.data(), sumPubKeys.size());
 
 		secp256k1_pubkey sumNoncesPubKey;
-		const int sumPubNonceKeyResult = secp256k1_ec_pubkey_parse(m_pContext, &sumNoncesPubKey, sumPubNonces.data(), sumPubNonces.size());
+		const int sumPubNonceKeyResult = secp256k1_ec_pubkey_parse(pContext, &sumNoncesPubKey, sumPubNonces.data(), sumPubNonces.size());
 
 		if (pubkeyResult == 1 && sumPubkeysResult == 1 && sumPubNonceKeyResult == 1)
 		{
-			const int verifyResult = secp256k1_aggsig_verify_single(m_pContext, signature.data, message.data(), &sumNoncesPubKey, &pubkey, &sumPubKey, nullptr, true);
+			const int verifyResult = secp256k1_aggsig_verify_single(pContext, signature.data, message.data(), &sumNoncesPubKey, &pubkey, &sumPubKey, nullptr, true);
 			if (verifyResult == 1)
 			{
 				return true;
@@ -246,10 +236,10 @@ bool AggSig::VerifyPartialSignature(const CompactSignature& partialSignature, co
 
 std::unique_ptr<Signature> AggSig::AggregateSignatures(const std::vector<CompactSignature>& signatures, const PublicKey& sumPubNonces) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	secp256k1_context* pContext = SecpContext::GetThreadInstance().Get();
 
 	secp256k1_pubkey pubNonces;
-	const int noncesParsed = secp256k1_ec_pubkey_parse(m_pContext, &pubNonces, sumPubNonces.data(), sumPubNonces.size());
+	const int noncesParsed = secp256k1_ec_pubkey_parse(pContext, &pubNonces, sumPubNonces.data(), sumPubNonces.size());
 	if (noncesParsed == 1)
 	{
 		std::vector<secp256k1_ecdsa_signature> parsedSignatures = ParseCompactSignatures(signatures);
@@ -265,7 +255,7 @@ std::unique_ptr<Signature> AggSig::AggregateSignatures(const std::vector<Compact
 
 			secp256k1_ecdsa_signature aggregatedSignature;
 			const int result = secp256k1_aggsig_add_signatures_single(
-				m_pContext, 
+				pContext, 
 				aggregatedSignature.data, 
 				(const unsigned char**)signaturePointers.data(), 
 				signaturePointers.size(), 
@@ -283,24 +273,43 @@ std::unique_ptr<Signature> AggSig::AggregateSignatures(const std::vector<Compact
 	return std::unique_ptr<Signature>(nullptr);
 }
 
-bool AggSig::VerifyAggregateSignatures(const std::vector<const Signature*>& signatures, const std::vector<const Commitment*>& commitments, const std::vector<const Hash*>& messages) const
+bool AggSig::VerifyAggregateSignatures(const std::vector<const Signature*>& signatures, const std::vector<const Commitment*>& commitments, const std::vector<const Hash*>& messages, const bool addToCache) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	secp256k1_context* pContext = SecpContext::GetThreadInstance().Get();
+
+	// Kernels already verified (eg. on mempool admission) are skipped.
+	std::vector<size_t> uncached;
+	uncached.reserve(signatures.size());
+	std::vector<Hash> cacheKeys;
+	cacheKeys.reserve(signatures.size());
+	for (size_t i = 0; i < signatures.size(); i++)
+	{
+		Hash cacheKey = VerifiedCache::SignatureKey(*commitments[i], *signatures[i], *messages[i]);
+		if (!VerifiedCache::GetInstance().Contains(cacheKey))
+		{
+			uncached.push_back(i);
+			cacheKeys.emplace_back(std::move(cacheKey));
+		}
+	}
+
+	if (uncached.empty())
+	{
+		return true;
+	}
 
-	std::vector<secp256k1_pubkey> parsedPubKeys;
-	for (const Commitment* commitment : commitments)
+	SecpArray<secp256k1_pubkey> parsedPubKeys(uncached.size());
+	SecpArray<secp256k1_schnorrsig> parsedSignatures(uncached.size());
+	std::vector<const unsigned char*> messageData(uncached.size());
+	for (size_t j = 0; j < uncached.size(); j++)
 	{
+		const size_t i = uncached[j];
+		const Commitment* commitment = commitments[i];
 		secp256k1_pedersen_commitment parsedCommitment;
-		const int commitmentResult = secp256k1_pedersen_commitment_parse(m_pContext, &parsedCommitment, commitment->data());
+		const int commitmentResult = secp256k1_pedersen_commitment_parse(pContext, &parsedCommitment, commitment->data());
 		if (commitmentResult == 1)
 		{
-			secp256k1_pubkey pubKey;
-			const int pubkeyResult = secp256k1_pedersen_commitment_to_pubkey(m_pContext, &pubKey, &parsedCommitment);
-			if (pubkeyResult == 1)
-			{
-				parsedPubKeys.emplace_back(std::move(pubKey));
-			}
-			else
+			const int pubkeyResult = secp256k1_pedersen_commitment_to_pubkey(pContext, &parsedPubKeys[j], &parsedCommitment);
+			if (pubkeyResult != 1)
 			{
 				LOG_ERROR("Failed to convert commitment to pubkey: " + commitment->ToHex());
 				return false;
@@ -311,48 +320,28 @@ bool AggSig::VerifyAggregateSignatures(const std::vector<const Signature*>& sign
 			LOG_ERROR("Failed to parse commitment " + commitment->ToHex());
 			return false;
 		}
-	}
-
-	std::vector<secp256k1_pubkey*> pubKeyPtrs(parsedPubKeys.size());
-	for (size_t i = 0; i < parsedPubKeys.size(); i++)
-	{
-		pubKeyPtrs[i] = &parsedPubKeys[i];
-	}
 
-	std::vector<secp256k1_schnorrsig> parsedSignatures;
-	for (const Signature* signature : signatures)
-	{
-		secp256k1_schnorrsig parsedSig;
-		if (secp256k1_schnorrsig_parse(m_pContext, &parsedSig, signature->GetSignatureBytes().data()) == 0)
+		if (secp256k1_schnorrsig_parse(pContext, &parsedSignatures[j], signatures[i]->GetSignatureBytes().data()) == 0)
 		{
 			return false;
 		}
 
-		parsedSignatures.emplace_back(std::move(parsedSig));
+		messageData[j] = messages[i]->data();
 	}
 
-	std::vector<const secp256k1_schnorrsig*> signaturePtrs;
-	std::transform(
-		parsedSignatures.cbegin(),
-		parsedSignatures.cend(),
-		std::back_inserter(signaturePtrs),
-		[](const secp256k1_schnorrsig& parsedSig) { return &parsedSig; }
-	);
-
-	std::vector<const unsigned char*> messageData;
-	std::transform(
-		messages.cbegin(),
-		messages.cend(),
-		std::back_inserter(messageData),
-		[](const Hash* pMessage) { return pMessage->data(); }
-	);
-
-	secp256k1_scratch_space* pScratchSpace = secp256k1_scratch_space_create(m_pContext, SCRATCH_SPACE_SIZE);
-	const int verifyResult = secp256k1_schnorrsig_verify_batch(m_pContext, pScratchSpace, signaturePtrs.data(), messageData.data(), pubKeyPtrs.data(), signatures.size());
-	secp256k1_scratch_space_destroy(pScratchSpace);
+	secp256k1_scratch_space* pScratchSpace = SecpContext::GetThreadInstance().GetScratchSpace();
+	const int verifyResult = secp256k1_schnorrsig_verify_batch(pContext, pScratchSpace, parsedSignatures.pointers(), messageData.data(), parsedPubKeys.pointers(), uncached.size());
 
 	if (verifyResult == 1)
 	{
+		if (addToCache)
+		{
+			for (const Hash& cacheKey : cacheKeys)
+			{
+				VerifiedCache::GetInstance().Add(cacheKey);
+			}
+		}
+
 		return true;
 	}
 	else
@@ -364,13 +353,13 @@ bool AggSig::VerifyAggregateSignatures(const std::vector<const Signature*>& sign
 
 bool AggSig::VerifyAggregateSignature(const Signature& signature, const PublicKey& sumPubKeys, const Hash& message) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	secp256k1_context* pContext = SecpContext::GetThreadInstance().Get();
 
 	secp256k1_pubkey parsedPubKey;
-	const int parseResult = secp256k1_ec_pubkey_parse(m_pContext, &parsedPubKey, sumPubKeys.data(), sumPubKeys.size());
+	const int parseResult = secp256k1_ec_pubkey_parse(pContext, &parsedPubKey, sumPubKeys.data(), sumPubKeys.size());
 	if (parseResult == 1)
 	{
-		const int verifyResult = secp256k1_aggsig_verify_single(m_pContext, signature.GetSignatureBytes().data(), message.data(), nullptr, &parsedPubKey, &parsedPubKey, nullptr, false);
+		const int verifyResult = secp256k1_aggsig_verify_single(pContext, signature.GetSignatureBytes().data(), message.data(), nullptr, &parsedPubKey, &parsedPubKey, nullptr, false);
 		if (verifyResult == 1)
 		{
 			return true;
@@ -382,11 +371,13 @@ bool AggSig::VerifyAggregateSignature(const Signature& signature, const PublicKe
 
 std::vector<secp256k1_ecdsa_signature> AggSig::ParseCompactSignatures(const std::vector<CompactSignature>& signatures) const
 {
+	secp256k1_context* pContext = SecpContext::GetThreadInstance().Get();
+
 	std::vector<secp256k1_ecdsa_signature> parsed;
 	for (const Signature partialSignature : signatures)
 	{
 		secp256k1_ecdsa_signature signature;
-		const int parseSignatureResult = secp256k1_ecdsa_signature_parse_compact(m_pContext, &signature, partialSignature.GetSignatureBytes().data());
+		const int parseSignatureResult = secp256k1_ecdsa_signature_parse_compact(pContext, &signature, partialSignature.GetSignatureBytes().data());
 		if (parseSignatureResult == 1)
 		{
 			parsed.emplace_back(std::move(signature));
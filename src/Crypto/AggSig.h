@@ -9,7 +9,6 @@
 #include <Crypto/Hash.h>
 #include <vector>
 #include <memory>
-#include <shared_mutex>
 
 // Forward Declarations
 typedef struct secp256k1_context_struct secp256k1_context;
@@ -30,15 +29,12 @@ public:
 	bool VerifyPartialSignature(const CompactSignature& partialSignature, const PublicKey& publicKey, const PublicKey& sumPubKeys, const PublicKey& sumPubNonces, const Hash& message) const;
 
 	std::unique_ptr<Signature> AggregateSignatures(const std::vector<CompactSignature>& signatures, const PublicKey& sumPubNonces) const;
-	bool VerifyAggregateSignatures(const std::vector<const Signature*>& signatures, const std::vector<const Commitment*>& publicKeys, const std::vector<const Hash*>& messages) const;
+	bool VerifyAggregateSignatures(const std::vector<const Signature*>& signatures, const std::vector<const Commitment*>& publicKeys, const std::vector<const Hash*>& messages, const bool addToCache) const;
 	bool VerifyAggregateSignature(const Signature& signature, const PublicKey& sumPubKeys, const Hash& message) const;
 
 private:
-	AggSig();
-	~AggSig();
+	AggSig() = default;
+	~AggSig() = default;
 
 	std::vector<secp256k1_ecdsa_signature> ParseCompactSignatures(const std::vector<CompactSignature>& signatures) const;
-
-	mutable std::shared_mutex m_mutex;
-	secp256k1_context* m_pContext;
 };
\ No newline at end of file
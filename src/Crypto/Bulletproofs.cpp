@@ -1,51 +1,40 @@
 #include "Bulletproofs.h"
 #include "Pedersen.h"
+#include "SecpContext.h"
+#include "VerifiedCache.h"
 #include "secp256k1-zkp/include/secp256k1_bulletproofs.h"
 
 #include <Common/Util/FunctionalUtil.h>
 #include <Crypto/RandomNumberGenerator.h>
 #include <Crypto/CryptoException.h>
 
-const uint64_t MAX_WIDTH = 1 << 20;
-const size_t SCRATCH_SPACE_SIZE = 256 * MAX_WIDTH;
-const size_t MAX_GENERATORS = 256;
-
 Bulletproofs& Bulletproofs::GetInstance()
 {
 	static Bulletproofs instance;
 	return instance;
 }
 
-Bulletproofs::Bulletproofs()
-{
-	m_pContext = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
-	m_pGenerators = secp256k1_bulletproof_generators_create(m_pContext, &secp256k1_generator_const_g, MAX_GENERATORS);
-}
-
-Bulletproofs::~Bulletproofs()
-{
-	secp256k1_bulletproof_generators_destroy(m_pContext, m_pGenerators);
-	secp256k1_context_destroy(m_pContext);
-}
-
-bool Bulletproofs::VerifyBulletproofs(const std::vector<std::pair<Commitment, RangeProof>>& rangeProofs) const
+bool Bulletproofs::VerifyBulletproofs(const std::vector<std::pair<Commitment, RangeProof>>& rangeProofs, const bool addToCache) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
-
 	const size_t numBits = 64;
 	const size_t proofLength = rangeProofs.front().second.GetProofBytes().size();
 
-	std::vector<Commitment> commitments;
+	std::vector<const Commitment*> commitments;
 	commitments.reserve(rangeProofs.size());
 
+	std::vector<Hash> cacheKeys;
+	cacheKeys.reserve(rangeProofs.size());
+
 	std::vector<const unsigned char*> bulletproofPointers;
 	bulletproofPointers.reserve(rangeProofs.size());
 	for (const std::pair<Commitment, RangeProof>& rangeProof : rangeProofs)
 	{
-		if (!m_cache.WasAlreadyVerified(rangeProof.first))
+		Hash cacheKey = VerifiedCache::RangeProofKey(rangeProof.first, rangeProof.second);
+		if (!VerifiedCache::GetInstance().Contains(cacheKey))
 		{
-			commitments.push_back(rangeProof.first);
+			commitments.push_back(&rangeProof.first);
 			bulletproofPointers.emplace_back(rangeProof.second.GetProofBytes().data());
+			cacheKeys.emplace_back(std::move(cacheKey));
 		}
 	}
 
@@ -55,25 +44,20 @@ bool Bulletproofs::VerifyBulletproofs(const std::vector<std::pair<Commitment, Ra
 	}
 
 	// array of generator multiplied by value in pedersen commitments (cannot be NULL)
-	std::vector<secp256k1_generator> valueGenerators;
-	for (size_t i = 0; i < commitments.size(); i++)
-	{
-		valueGenerators.push_back(secp256k1_generator_const_h);
-	}
-
-	std::vector<secp256k1_pedersen_commitment*> commitmentPointers = Pedersen::ConvertCommitments(*m_pContext, commitments);
+	std::vector<secp256k1_generator> valueGenerators(commitments.size(), secp256k1_generator_const_h);
 
-	secp256k1_scratch_space* pScratchSpace = secp256k1_scratch_space_create(m_pContext, SCRATCH_SPACE_SIZE);
-	const int result = secp256k1_bulletproof_rangeproof_verify_multi(m_pContext, pScratchSpace, m_pGenerators, bulletproofPointers.data(), commitments.size(), proofLength, NULL, commitmentPointers.data(), 1, numBits, valueGenerators.data(), NULL, NULL);
-	secp256k1_scratch_space_destroy(pScratchSpace);
+	SecpContext& context = SecpContext::GetThreadInstance();
+	secp256k1_context* pContext = context.Get();
+	SecpArray<secp256k1_pedersen_commitment> parsedCommitments(commitments.size());
+	Pedersen::ParseCommitments(*pContext, commitments, parsedCommitments);
 
-	Pedersen::CleanupCommitments(commitmentPointers);
+	const int result = secp256k1_bulletproof_rangeproof_verify_multi(pContext, context.GetScratchSpace(), context.GetGenerators(), bulletproofPointers.data(), commitments.size(), proofLength, NULL, parsedCommitments.pointers(), 1, numBits, valueGenerators.data(), NULL, NULL);
 
-	if (result == 1)
+	if (result == 1 && addToCache)
 	{
-		for (const Commitment& commitment : commitments)
+		for (const Hash& cacheKey : cacheKeys)
 		{
-			m_cache.AddToCache(commitment);
+			VerifiedCache::GetInstance().Add(cacheKey);
 		}
 	}
 
@@ -82,25 +66,22 @@ bool Bulletproofs::VerifyBulletproofs(const std::vector<std::pair<Commitment, Ra
 
 RangeProof Bulletproofs::GenerateRangeProof(const uint64_t amount, const SecretKey& key, const SecretKey& privateNonce, const SecretKey& rewindNonce, const ProofMessage& proofMessage) const
 {
-	std::unique_lock<std::shared_mutex> writeLock(m_mutex);
-
-	const SecretKey randomSeed = RandomNumberGenerator::GenerateRandom32();
-	const int randomizeResult = secp256k1_context_randomize(m_pContext, randomSeed.data());
-	if (randomizeResult != 1)
+	SecpContext& context = SecpContext::GetThreadInstance();
+	if (!context.Randomize())
 	{
-		throw CryptoException("secp256k1_context_randomize failed with error: " + std::to_string(randomizeResult));
+		throw CryptoException("secp256k1_context_randomize failed");
 	}
 
+	secp256k1_context* pContext = context.Get();
+
 	std::vector<unsigned char> proofBytes(MAX_PROOF_SIZE, 0);
 	size_t proofLen = MAX_PROOF_SIZE;
 
-	secp256k1_scratch_space* pScratchSpace = secp256k1_scratch_space_create(m_pContext, SCRATCH_SPACE_SIZE);
-
 	std::vector<const unsigned char*> blindingFactors({ key.data() });
 	int result = secp256k1_bulletproof_rangeproof_prove(
-		m_pContext,
-		pScratchSpace,
-		m_pGenerators,
+		pContext,
+		context.GetScratchSpace(),
+		context.GetGenerators(),
 		&proofBytes[0],
 		&proofLen,
 		NULL,
@@ -119,7 +100,6 @@ RangeProof Bulletproofs::GenerateRangeProof(const uint64_t amount, const SecretK
 		0,
 		proofMessage.data()
 	);
-	secp256k1_scratch_space_destroy(pScratchSpace);
 
 	if (result == 1)
 	{
@@ -132,40 +112,37 @@ RangeProof Bulletproofs::GenerateRangeProof(const uint64_t amount, const SecretK
 
 std::unique_ptr<RewoundProof> Bulletproofs::RewindProof(const Commitment& commitment, const RangeProof& rangeProof, const SecretKey& nonce) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	secp256k1_context* pContext = SecpContext::GetThreadInstance().Get();
+
+	secp256k1_pedersen_commitment parsedCommitment;
+	Pedersen::ParseCommitment(*pContext, commitment, parsedCommitment);
 
-	std::vector<secp256k1_pedersen_commitment*> commitmentPointers = Pedersen::ConvertCommitments(*m_pContext, std::vector<Commitment>({ commitment }));
+	uint64_t value;
+	std::vector<unsigned char> blindingFactorBytes(32);
+	std::vector<unsigned char> message(20, 0);
 
-	if (!commitmentPointers.empty())
+	int result = secp256k1_bulletproof_rangeproof_rewind(
+		pContext,
+		&value,
+		blindingFactorBytes.data(),
+		rangeProof.GetProofBytes().data(),
+		rangeProof.GetProofBytes().size(),
+		0,
+		&parsedCommitment,
+		&secp256k1_generator_const_h,
+		nonce.data(),
+		NULL,
+		0,
+		message.data()
+	);
+
+	if (result == 1)
 	{
-		uint64_t value;
-		std::vector<unsigned char> blindingFactorBytes(32);
-		std::vector<unsigned char> message(20, 0);
-
-		int result = secp256k1_bulletproof_rangeproof_rewind(
-			m_pContext,
-			&value,
-			blindingFactorBytes.data(),
-			rangeProof.GetProofBytes().data(),
-			rangeProof.GetProofBytes().size(),
-			0,
-			commitmentPointers.front(),
-			&secp256k1_generator_const_h,
-			nonce.data(),
-			NULL,
-			0,
-			message.data()
-		);
-		Pedersen::CleanupCommitments(commitmentPointers);
-
-		if (result == 1)
-		{
-			return std::make_unique<RewoundProof>(RewoundProof(
-				value, 
-				std::make_unique<SecretKey>(SecretKey(std::move(blindingFactorBytes))), 
-				ProofMessage(std::move(message))
-			));
-		}
+		return std::make_unique<RewoundProof>(RewoundProof(
+			value, 
+			std::make_unique<SecretKey>(SecretKey(std::move(blindingFactorBytes))), 
+			ProofMessage(std::move(message))
+		));
 	}
 
 	return std::unique_ptr<RewoundProof>(nullptr);
@@ -1,24 +1,20 @@
 #pragma once
 
-#include "BulletProofsCache.h"
-
 #include <Crypto/Commitment.h>
 #include <Crypto/RangeProof.h>
 #include <Crypto/BlindingFactor.h>
 #include <Crypto/ProofMessage.h>
 #include <Crypto/RewoundProof.h>
-#include <shared_mutex>
 
 // Forward Declarations
 typedef struct secp256k1_context_struct secp256k1_context;
-struct secp256k1_bulletproof_generators;
 
 class Bulletproofs
 {
 public:
 	static Bulletproofs& GetInstance();
 
-	bool VerifyBulletproofs(const std::vector<std::pair<Commitment, RangeProof>>& rangeProofs) const;
+	bool VerifyBulletproofs(const std::vector<std::pair<Commitment, RangeProof>>& rangeProofs, const bool addToCache) const;
 
 	RangeProof GenerateRangeProof(
 		const uint64_t amount,
@@ -35,11 +31,6 @@ public:
 	) const;
 
 private:
-	Bulletproofs();
-	~Bulletproofs();
-
-	mutable std::shared_mutex m_mutex;
-	secp256k1_context* m_pContext;
-	secp256k1_bulletproof_generators* m_pGenerators;
-	mutable BulletProofsCache m_cache;
+	Bulletproofs() = default;
+	~Bulletproofs() = default;
 };
\ No newline at end of file
@@ -16,6 +16,8 @@
 #include "Bulletproofs.h"
 #include "Pedersen.h"
 #include "PublicKeys.h"
+#include "SecpContext.h"
+#include "VerifiedCache.h"
 
 #ifdef _WIN32
 #pragma comment(lib, "crypt32")
@@ -98,25 +100,8 @@ Commitment Crypto::CommitBlinded(const uint64_t value, const BlindingFactor& bli
 
 Commitment Crypto::AddCommitments(const std::vector<Commitment>& positive, const std::vector<Commitment>& negative)
 {
-	const Commitment zeroCommitment(CBigInteger<33>::ValueOf(0));
-
-	std::vector<Commitment> sanitizedPositive;
-	std::copy_if(
-		positive.cbegin(),
-		positive.cend(),
-		std::back_inserter(sanitizedPositive),
-		[&zeroCommitment](const Commitment& positiveCommitment) { return positiveCommitment != zeroCommitment; }
-	);
-
-	std::vector<Commitment> sanitizedNegative;
-	std::copy_if(
-		negative.cbegin(),
-		negative.cend(),
-		std::back_inserter(sanitizedNegative),
-		[&zeroCommitment](const Commitment& negativeCommitment) { return negativeCommitment != zeroCommitment; }
-	);
-
-	return Pedersen::GetInstance().PedersenCommitSum(sanitizedPositive, sanitizedNegative);
+	// Zero commitments are skipped while parsing, so the vectors don't need to be copied and filtered first.
+	return Pedersen::GetInstance().PedersenCommitSum(positive, negative);
 }
 
 BlindingFactor Crypto::AddBlindingFactors(const std::vector<BlindingFactor>& positive, const std::vector<BlindingFactor>& negative)
@@ -154,7 +139,7 @@ SecretKey Crypto::BlindSwitch(const SecretKey& secretKey, const uint64_t amount)
 
 SecretKey Crypto::AddPrivateKeys(const SecretKey& secretKey1, const SecretKey& secretKey2)
 {
-	secp256k1_context* pContext = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+	secp256k1_context* pContext = SecpContext::GetThreadInstance().Get();
 
 	CBigInteger<32> result(secretKey1.GetVec());
 	if (secp256k1_ec_privkey_tweak_add(pContext, (unsigned char*)result.data(), secretKey2.data()) == 1)
@@ -165,6 +150,16 @@ SecretKey Crypto::AddPrivateKeys(const SecretKey& secretKey1, const SecretKey& s
 	throw CryptoException("secp256k1_ec_privkey_tweak_add failed");
 }
 
+void Crypto::ConfigureScratchSpace(const size_t maxBytes, const size_t retainBytes)
+{
+	SecpContext::ConfigureScratchSpace(maxBytes, retainBytes);
+}
+
+void Crypto::ConfigureVerifiedCache(const size_t capacity)
+{
+	VerifiedCache::GetInstance().SetCapacity(capacity);
+}
+
 RangeProof Crypto::GenerateRangeProof(const uint64_t amount, const SecretKey& key, const SecretKey& privateNonce, const SecretKey& rewindNonce, const ProofMessage& proofMessage)
 {
 	return Bulletproofs::GetInstance().GenerateRangeProof(amount, key, privateNonce, rewindNonce, proofMessage);
@@ -175,9 +170,9 @@ std::unique_ptr<RewoundProof> Crypto::RewindRangeProof(const Commitment& commitm
 	return Bulletproofs::GetInstance().RewindProof(commitment, rangeProof, nonce);
 }
 
-bool Crypto::VerifyRangeProofs(const std::vector<std::pair<Commitment, RangeProof>>& rangeProofs)
+bool Crypto::VerifyRangeProofs(const std::vector<std::pair<Commitment, RangeProof>>& rangeProofs, const bool addToCache)
 {
-	return Bulletproofs::GetInstance().VerifyBulletproofs(rangeProofs);
+	return Bulletproofs::GetInstance().VerifyBulletproofs(rangeProofs, addToCache);
 }
 
 uint64_t Crypto::SipHash24(const uint64_t k0, const uint64_t k1, const std::vector<unsigned char>& data)
@@ -289,9 +284,9 @@ bool Crypto::VerifyAggregateSignature(const Signature& aggregateSignature, const
 	return AggSig::GetInstance().VerifyAggregateSignature(aggregateSignature, sumPubKeys, message);
 }
 
-bool Crypto::VerifyKernelSignatures(const std::vector<const Signature*>& signatures, const std::vector<const Commitment*>& publicKeys, const std::vector<const Hash*>& messages)
+bool Crypto::VerifyKernelSignatures(const std::vector<const Signature*>& signatures, const std::vector<const Commitment*>& publicKeys, const std::vector<const Hash*>& messages, const bool addToCache)
 {
-	return AggSig::GetInstance().VerifyAggregateSignatures(signatures, publicKeys, messages);
+	return AggSig::GetInstance().VerifyAggregateSignatures(signatures, publicKeys, messages, addToCache);
 }
 
 SecretKey Crypto::GenerateSecureNonce()
@@ -2,9 +2,11 @@
 
 #include "secp256k1-zkp/include/secp256k1_commitment.h"
 #include "SwitchGeneratorPoint.h"
+#include "SecpContext.h"
 
 #include <Crypto/CryptoException.h>
 #include <Infrastructure/Logger.h>
+#include <algorithm>
 
 Pedersen& Pedersen::GetInstance()
 {
@@ -12,26 +14,16 @@ Pedersen& Pedersen::GetInstance()
 	return instance;
 }
 
-Pedersen::Pedersen()
-{
-	m_pContext = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
-}
-
-Pedersen::~Pedersen()
-{
-	secp256k1_context_destroy(m_pContext);
-}
-
 Commitment Pedersen::PedersenCommit(const uint64_t value, const BlindingFactor& blindingFactor) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	secp256k1_context* pContext = SecpContext::GetThreadInstance().Get();
 
 	secp256k1_pedersen_commitment commitment;
-	const int result = secp256k1_pedersen_commit(m_pContext, &commitment, &blindingFactor.GetBytes()[0], value, &secp256k1_generator_const_h, &secp256k1_generator_const_g);
+	const int result = secp256k1_pedersen_commit(pContext, &commitment, &blindingFactor.GetBytes()[0], value, &secp256k1_generator_const_h, &secp256k1_generator_const_g);
 	if (result == 1)
 	{
 		std::vector<unsigned char> serializedCommitment(33);
-		secp256k1_pedersen_commitment_serialize(m_pContext, &serializedCommitment[0], &commitment);
+		secp256k1_pedersen_commitment_serialize(pContext, &serializedCommitment[0], &commitment);
 
 		return Commitment(CBigInteger<33>(std::move(serializedCommitment)));
 	}
@@ -42,33 +34,51 @@ Commitment Pedersen::PedersenCommit(const uint64_t value, const BlindingFactor&
 
 Commitment Pedersen::PedersenCommitSum(const std::vector<Commitment>& positive, const std::vector<Commitment>& negative) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	secp256k1_context* pContext = SecpContext::GetThreadInstance().Get();
+
+	// Zero commitments aren't valid curve points, and don't change the sum, so they're skipped.
+	static const Commitment ZERO_COMMITMENT(CBigInteger<33>::ValueOf(0));
+	auto parseNonZero = [pContext](const std::vector<Commitment>& commitments, SecpArray<secp256k1_pedersen_commitment>& parsed)
+	{
+		size_t index = 0;
+		for (const Commitment& commitment : commitments)
+		{
+			if (commitment != ZERO_COMMITMENT)
+			{
+				ParseCommitment(*pContext, commitment, parsed[index++]);
+			}
+		}
+	};
+
+	auto countNonZero = [](const std::vector<Commitment>& commitments) -> size_t
+	{
+		return std::count_if(commitments.cbegin(), commitments.cend(), [](const Commitment& commitment) { return commitment != ZERO_COMMITMENT; });
+	};
+
+	SecpArray<secp256k1_pedersen_commitment> positiveCommitments(countNonZero(positive));
+	parseNonZero(positive, positiveCommitments);
 
-	std::vector<secp256k1_pedersen_commitment*> positiveCommitments = Pedersen::ConvertCommitments(*m_pContext, positive);
-	std::vector<secp256k1_pedersen_commitment*> negativeCommitments = Pedersen::ConvertCommitments(*m_pContext, negative);
+	SecpArray<secp256k1_pedersen_commitment> negativeCommitments(countNonZero(negative));
+	parseNonZero(negative, negativeCommitments);
 
 	secp256k1_pedersen_commitment commitment;
 	const int result = secp256k1_pedersen_commit_sum(
-		m_pContext,
+		pContext,
 		&commitment,
-		positiveCommitments.empty() ? nullptr : &positiveCommitments[0],
+		positiveCommitments.pointers(),
 		positiveCommitments.size(),
-		negativeCommitments.empty() ? nullptr : &negativeCommitments[0],
+		negativeCommitments.pointers(),
 		negativeCommitments.size()
 	);
 
-	Pedersen::CleanupCommitments(positiveCommitments);
-	Pedersen::CleanupCommitments(negativeCommitments);
-
 	if (result != 1)
 	{
 		LOG_ERROR_F("secp256k1_pedersen_commit_sum returned result: {}", result);
 		throw CryptoException("secp256k1_pedersen_commit_sum error");
 	}
 
-
 	std::vector<unsigned char> serializedCommitment(33);
-	const int serializeResult = secp256k1_pedersen_commitment_serialize(m_pContext, &serializedCommitment[0], &commitment);
+	const int serializeResult = secp256k1_pedersen_commitment_serialize(pContext, &serializedCommitment[0], &commitment);
 	if (serializeResult != 1)
 	{
 		LOG_ERROR_F("secp256k1_pedersen_commitment_serialize returned result: {}", serializeResult);
@@ -80,7 +90,7 @@ Commitment Pedersen::PedersenCommitSum(const std::vector<Commitment>& positive,
 
 BlindingFactor Pedersen::PedersenBlindSum(const std::vector<BlindingFactor>& positive, const std::vector<BlindingFactor>& negative) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	secp256k1_context* pContext = SecpContext::GetThreadInstance().Get();
 
 	std::vector<const unsigned char*> blindingFactors;
 	for (const BlindingFactor& positiveFactor : positive)
@@ -95,7 +105,7 @@ BlindingFactor Pedersen::PedersenBlindSum(const std::vector<BlindingFactor>& pos
 
 	CBigInteger<32> blindingFactorBytes;
 	const int result = secp256k1_pedersen_blind_sum(
-		m_pContext,
+		pContext,
 		blindingFactorBytes.data(),
 		blindingFactors.data(),
 		blindingFactors.size(),
@@ -113,11 +123,11 @@ BlindingFactor Pedersen::PedersenBlindSum(const std::vector<BlindingFactor>& pos
 
 SecretKey Pedersen::BlindSwitch(const SecretKey& blindingFactor, const uint64_t amount) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	secp256k1_context* pContext = SecpContext::GetThreadInstance().Get();
 
 	std::vector<unsigned char> blindSwitch(32);
 	const int result = secp256k1_blind_switch(
-		m_pContext,
+		pContext,
 		blindSwitch.data(),
 		blindingFactor.data(),
 		amount,
@@ -133,34 +143,20 @@ SecretKey Pedersen::BlindSwitch(const SecretKey& blindingFactor, const uint64_t
 	throw CryptoException("secp256k1_blind_switch failed with error: " + std::to_string(result));
 }
 
-std::vector<secp256k1_pedersen_commitment*> Pedersen::ConvertCommitments(const secp256k1_context& context, const std::vector<Commitment>& commitments)
+void Pedersen::ParseCommitment(const secp256k1_context& context, const Commitment& commitment, secp256k1_pedersen_commitment& parsed)
 {
-	std::vector<secp256k1_pedersen_commitment*> convertedCommitments(commitments.size(), NULL);
-	for (int i = 0; i < commitments.size(); i++)
+	const int result = secp256k1_pedersen_commitment_parse(&context, &parsed, commitment.data());
+	if (result != 1)
 	{
-		const std::vector<unsigned char>& commitmentBytes = commitments[i].GetVec();
-
-		secp256k1_pedersen_commitment* pCommitment = new secp256k1_pedersen_commitment();
-		const int parsed = secp256k1_pedersen_commitment_parse(&context, pCommitment, &commitmentBytes[0]);
-		convertedCommitments[i] = pCommitment;
-
-		if (parsed != 1)
-		{
-			// TODO: Log failue
-			CleanupCommitments(convertedCommitments);
-			throw CryptoException("secp256k1_pedersen_commitment_parse failed with error: " + std::to_string(parsed));
-		}
+		LOG_ERROR_F("Failed to parse commitment {}", commitment);
+		throw CryptoException("secp256k1_pedersen_commitment_parse failed with error: " + std::to_string(result));
 	}
-
-	return convertedCommitments;
 }
 
-void Pedersen::CleanupCommitments(std::vector<secp256k1_pedersen_commitment*>& commitments)
+void Pedersen::ParseCommitments(const secp256k1_context& context, const std::vector<const Commitment*>& commitments, SecpArray<secp256k1_pedersen_commitment>& parsed)
 {
-	for (secp256k1_pedersen_commitment* pCommitment : commitments)
+	for (size_t i = 0; i < commitments.size(); i++)
 	{
-		delete pCommitment;
+		ParseCommitment(context, *commitments[i], parsed[i]);
 	}
-
-	commitments.clear();
 }
\ No newline at end of file
@@ -1,11 +1,11 @@
 #pragma once
 
 #include "secp256k1-zkp/include/secp256k1_commitment.h"
+#include "SecpArray.h"
 
 #include <Crypto/BlindingFactor.h>
 #include <Crypto/SecretKey.h>
 #include <Crypto/Commitment.h>
-#include <shared_mutex>
 
 // Forward Declarations
 typedef struct secp256k1_context_struct secp256k1_context;
@@ -21,13 +21,19 @@ public:
 
 	SecretKey BlindSwitch(const SecretKey& secretKey, const uint64_t amount) const;
 
-	static std::vector<secp256k1_pedersen_commitment*> ConvertCommitments(const secp256k1_context& context, const std::vector<Commitment>& commitments);
-	static void CleanupCommitments(std::vector<secp256k1_pedersen_commitment*>& commitments);
+	//
+	// Parses the commitment into its secp256k1 representation.
+	// Throws CryptoException if the commitment is invalid.
+	//
+	static void ParseCommitment(const secp256k1_context& context, const Commitment& commitment, secp256k1_pedersen_commitment& parsed);
 
-private:
-	Pedersen();
-	~Pedersen();
+	//
+	// Parses the commitments into the array, which must have the same size.
+	// Throws CryptoException if any commitment is invalid.
+	//
+	static void ParseCommitments(const secp256k1_context& context, const std::vector<const Commitment*>& commitments, SecpArray<secp256k1_pedersen_commitment>& parsed);
 
-	mutable std::shared_mutex m_mutex;
-	secp256k1_context* m_pContext;
+private:
+	Pedersen() = default;
+	~Pedersen() = default;
 };
\ No newline at end of file
@@ -2,7 +2,6 @@
 
 #include <Crypto/SecretKey.h>
 #include <Crypto/PublicKey.h>
-#include <shared_mutex>
 
 // Forward Declarations
 typedef struct secp256k1_context_struct secp256k1_context;
@@ -16,9 +15,6 @@ public:
 	PublicKey PublicKeySum(const std::vector<PublicKey>& publicKeys) const;
 
 private:
-	PublicKeys();
-	~PublicKeys();
-
-	mutable std::shared_mutex m_mutex;
-	secp256k1_context* m_pContext;
+	PublicKeys() = default;
+	~PublicKeys() = default;
 };
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <cstddef>
+
+//
+// Contiguous storage for parsed secp256k1 structs, along with the array of pointers to them that the batch functions take.
+// Small arrays live on the stack. Larger ones use a single allocation for all elements, instead of one allocation per element.
+//
+template<typename T, size_t STACK_SIZE = 16>
+class SecpArray
+{
+public:
+	explicit SecpArray(const size_t size)
+		: m_size(size)
+	{
+		if (size > STACK_SIZE)
+		{
+			m_pHeapItems = std::make_unique<T[]>(size);
+			m_pHeapPointers = std::make_unique<const T*[]>(size);
+			m_pItems = m_pHeapItems.get();
+			m_pPointers = m_pHeapPointers.get();
+		}
+		else
+		{
+			m_pItems = m_stackItems.data();
+			m_pPointers = m_stackPointers.data();
+		}
+
+		for (size_t i = 0; i < size; i++)
+		{
+			m_pPointers[i] = &m_pItems[i];
+		}
+	}
+
+	// The pointers refer to the stack storage, so the array can't be copied or moved.
+	SecpArray(const SecpArray&) = delete;
+	SecpArray& operator=(const SecpArray&) = delete;
+
+	size_t size() const noexcept { return m_size; }
+	bool empty() const noexcept { return m_size == 0; }
+
+	T& operator[](const size_t index) noexcept { return m_pItems[index]; }
+	const T& operator[](const size_t index) const noexcept { return m_pItems[index]; }
+
+	T* data() noexcept { return m_pItems; }
+
+	// Null when empty, since the secp256k1 functions accept NULL for empty arrays.
+	const T* const* pointers() const noexcept { return m_size == 0 ? nullptr : m_pPointers; }
+
+private:
+	size_t m_size;
+
+	std::array<T, STACK_SIZE> m_stackItems;
+	std::array<const T*, STACK_SIZE> m_stackPointers;
+	std::unique_ptr<T[]> m_pHeapItems;
+	std::unique_ptr<const T*[]> m_pHeapPointers;
+
+	T* m_pItems;
+	const T** m_pPointers;
+};
\ No newline at end of file
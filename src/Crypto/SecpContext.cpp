@@ -0,0 +1,96 @@
+#include "SecpContext.h"
+
+#include "secp256k1-zkp/include/secp256k1.h"
+#include "secp256k1-zkp/include/secp256k1_generator.h"
+#include "secp256k1-zkp/include/secp256k1_bulletproofs.h"
+
+#include <Crypto/RandomNumberGenerator.h>
+#include <Crypto/SecretKey.h>
+#include <Infrastructure/Logger.h>
+#include <atomic>
+
+static const size_t MAX_GENERATORS = 256;
+
+static std::atomic<size_t> s_scratchSpaceSize{ 256 * (1 << 20) };
+static std::atomic<size_t> s_scratchRetainSize{ 16 * (1 << 20) };
+
+// Building the precomputed tables is slow, so they're built once and each thread clones them.
+static const secp256k1_context* GetPrototype()
+{
+	static const struct Prototype
+	{
+		Prototype() : m_pContext(secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY)) { }
+		~Prototype() { secp256k1_context_destroy(m_pContext); }
+
+		secp256k1_context* m_pContext;
+	} prototype;
+
+	return prototype.m_pContext;
+}
+
+SecpContext& SecpContext::GetThreadInstance()
+{
+	thread_local SecpContext instance;
+	return instance;
+}
+
+void SecpContext::ConfigureScratchSpace(const size_t maxBytes, const size_t retainBytes)
+{
+	s_scratchSpaceSize = maxBytes;
+	s_scratchRetainSize = retainBytes;
+}
+
+SecpContext::SecpContext()
+	: m_pContext(secp256k1_context_clone(GetPrototype())), m_pGenerators(nullptr), m_pScratchSpace(nullptr)
+{
+	// Signing randomizes again anyway, so a failure here only loses the initial blinding.
+	Randomize();
+}
+
+SecpContext::~SecpContext()
+{
+	if (m_pScratchSpace != nullptr)
+	{
+		secp256k1_scratch_space_destroy(m_pScratchSpace);
+	}
+
+	if (m_pGenerators != nullptr)
+	{
+		secp256k1_bulletproof_generators_destroy(m_pContext, m_pGenerators);
+	}
+
+	secp256k1_context_destroy(m_pContext);
+}
+
+const secp256k1_bulletproof_generators* SecpContext::GetGenerators()
+{
+	if (m_pGenerators == nullptr)
+	{
+		m_pGenerators = secp256k1_bulletproof_generators_create(m_pContext, &secp256k1_generator_const_g, MAX_GENERATORS);
+	}
+
+	return m_pGenerators;
+}
+
+secp256k1_scratch_space* SecpContext::GetScratchSpace()
+{
+	if (m_pScratchSpace == nullptr)
+	{
+		m_pScratchSpace = secp256k1_scratch_space_create_retained(m_pContext, s_scratchSpaceSize, s_scratchRetainSize);
+	}
+
+	return m_pScratchSpace;
+}
+
+bool SecpContext::Randomize()
+{
+	const SecretKey randomSeed = RandomNumberGenerator::GenerateRandom32();
+	const int randomizeResult = secp256k1_context_randomize(m_pContext, randomSeed.data());
+	if (randomizeResult != 1)
+	{
+		LOG_ERROR_F("secp256k1_context_randomize failed with error: {}", randomizeResult);
+		return false;
+	}
+
+	return true;
+}
\ No newline at end of file
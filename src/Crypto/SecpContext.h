@@ -0,0 +1,53 @@
+#pragma once
+
+// Forward Declarations
+typedef struct secp256k1_context_struct secp256k1_context;
+typedef struct secp256k1_scratch_space_struct secp256k1_scratch_space;
+struct secp256k1_bulletproof_generators;
+
+#include <cstddef>
+
+//
+// Owns the secp256k1 context and bulletproof generators of the calling thread.
+// Every thread lazily gets its own randomized copy on first use, so crypto operations never lock or wait on each other.
+//
+class SecpContext
+{
+public:
+	static SecpContext& GetThreadInstance();
+
+	//
+	// Sets the maximum size of scratch spaces created afterwards, and how much memory each keeps between operations.
+	//
+	static void ConfigureScratchSpace(const size_t maxBytes, const size_t retainBytes);
+
+	SecpContext(const SecpContext&) = delete;
+	SecpContext& operator=(const SecpContext&) = delete;
+	~SecpContext();
+
+	secp256k1_context* Get() noexcept { return m_pContext; }
+
+	//
+	// Created on first use, since only threads that build or verify rangeproofs need them.
+	//
+	const secp256k1_bulletproof_generators* GetGenerators();
+
+	//
+	// Scratch space for rangeproof and batch signature operations, created on first use.
+	// Its memory is reused across calls instead of being allocated and freed by every operation.
+	//
+	secp256k1_scratch_space* GetScratchSpace();
+
+	//
+	// Re-blinds the context with a fresh random seed. Call before signing or creating proofs with secret data.
+	// Returns false if randomization failed.
+	//
+	bool Randomize();
+
+private:
+	SecpContext();
+
+	secp256k1_context* m_pContext;
+	secp256k1_bulletproof_generators* m_pGenerators;
+	secp256k1_scratch_space* m_pScratchSpace;
+};
\ No newline at end of file
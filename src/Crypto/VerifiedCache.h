@@ -0,0 +1,99 @@
+#pragma once
+
+#include <Crypto/Crypto.h>
+#include <Crypto/Hash.h>
+#include <Crypto/Commitment.h>
+#include <Crypto/RangeProof.h>
+#include <Crypto/Signature.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <unordered_set>
+
+//
+// A bounded set of hashes of rangeproofs and kernel signatures that have already been verified, so transactions
+// verified on mempool admission aren't verified again when they show up in a block.
+//
+// Entries are spread over independently locked shards, so concurrent lookups from different threads rarely contend.
+// Each shard evicts its oldest entries once it holds more than its share of the capacity.
+//
+class VerifiedCache
+{
+public:
+	static constexpr size_t NUM_SHARDS = 32;
+
+	explicit VerifiedCache(const size_t capacity) : m_shardCapacity((std::max)(capacity / NUM_SHARDS, (size_t)1)) { }
+
+	static VerifiedCache& GetInstance()
+	{
+		static VerifiedCache instance(100'000);
+		return instance;
+	}
+
+	//
+	// Sets the maximum number of entries kept across all shards. Shrinking takes effect as new entries are added.
+	//
+	void SetCapacity(const size_t capacity) noexcept
+	{
+		m_shardCapacity = (std::max)(capacity / NUM_SHARDS, (size_t)1);
+	}
+
+	void Add(const Hash& hash)
+	{
+		Shard& shard = GetShard(hash);
+		std::unique_lock<std::mutex> lock(shard.mutex);
+
+		if (shard.hashes.insert(hash).second)
+		{
+			shard.order.push_back(hash);
+			while (shard.order.size() > m_shardCapacity)
+			{
+				shard.hashes.erase(shard.order.front());
+				shard.order.pop_front();
+			}
+		}
+	}
+
+	//
+	// Keys commit to everything that was verified, so a different proof or signature for the same commitment is never a hit.
+	//
+	static Hash RangeProofKey(const Commitment& commitment, const RangeProof& rangeProof)
+	{
+		std::vector<unsigned char> data(commitment.GetVec());
+		data.insert(data.end(), rangeProof.GetProofBytes().cbegin(), rangeProof.GetProofBytes().cend());
+		return Crypto::Blake2b(data);
+	}
+
+	static Hash SignatureKey(const Commitment& excess, const Signature& signature, const Hash& message)
+	{
+		std::vector<unsigned char> data(excess.GetVec());
+		data.insert(data.end(), signature.GetSignatureBytes().GetData().cbegin(), signature.GetSignatureBytes().GetData().cend());
+		data.insert(data.end(), message.GetData().cbegin(), message.GetData().cend());
+		return Crypto::Blake2b(data);
+	}
+
+	bool Contains(const Hash& hash) const
+	{
+		const Shard& shard = GetShard(hash);
+		std::unique_lock<std::mutex> lock(shard.mutex);
+
+		return shard.hashes.count(hash) > 0;
+	}
+
+private:
+	struct Shard
+	{
+		mutable std::mutex mutex;
+		std::unordered_set<Hash> hashes;
+		std::deque<Hash> order;
+	};
+
+	// The keys are Blake2b hashes, so any byte is uniformly distributed.
+	Shard& GetShard(const Hash& hash) { return m_shards[hash[31] % NUM_SHARDS]; }
+	const Shard& GetShard(const Hash& hash) const { return m_shards[hash[31] % NUM_SHARDS]; }
+
+	std::array<Shard, NUM_SHARDS> m_shards;
+	std::atomic<size_t> m_shardCapacity;
+};
\ No newline at end of file
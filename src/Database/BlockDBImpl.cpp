@@ -10,6 +10,29 @@
 
 using namespace rocksdb;
 
+// Value type of the BLOCK_HEIGHT archive table.
+class ArchivedBlockHash : public Traits::ISerializable
+{
+public:
+	ArchivedBlockHash(const Hash& hash) : m_hash(hash) { }
+
+	const Hash& GetHash() const noexcept { return m_hash; }
+
+	void Serialize(Serializer& serializer) const final { serializer.AppendBigInteger(m_hash); }
+	static ArchivedBlockHash Deserialize(ByteBuffer& byteBuffer) { return ArchivedBlockHash(byteBuffer.ReadBigInteger<32>()); }
+
+private:
+	Hash m_hash;
+};
+
+// Heights are stored big-endian so the BLOCK_HEIGHT table iterates in height order.
+static std::vector<unsigned char> HeightKey(const uint64_t height)
+{
+	Serializer serializer;
+	serializer.Append<uint64_t>(height);
+	return serializer.GetBytes();
+}
+
 std::shared_ptr<BlockDB> BlockDB::OpenDB(const Config& config)
 {
 	fs::path dbPath = config.GetNodeConfig().GetDatabasePath() / "CHAIN/";
@@ -20,9 +43,26 @@ std::shared_ptr<BlockDB> BlockDB::OpenDB(const Config& config)
 	ColumnFamilyDescriptor OUTPUT_POS_COLUMN = ColumnFamilyDescriptor("OUTPUT_POS", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
 	ColumnFamilyDescriptor INPUT_BITMAP_COLUMN = ColumnFamilyDescriptor("INPUT_BITMAP", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
 	ColumnFamilyDescriptor SPENT_OUTPUTS_COLUMN = ColumnFamilyDescriptor("SPENT_OUTPUTS", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
-
-	std::vector<ColumnFamilyDescriptor> tableNames = { ColumnFamilyDescriptor(), BLOCK_COLUMN, HEADER_COLUMN, BLOCK_SUMS_COLUMN, OUTPUT_POS_COLUMN, INPUT_BITMAP_COLUMN, SPENT_OUTPUTS_COLUMN };
-	std::shared_ptr<RocksDB> pRocksDB = RocksDBFactory::Open(dbPath, tableNames);
+	ColumnFamilyDescriptor KERNEL_POS_COLUMN = ColumnFamilyDescriptor("KERNEL_POS", *ColumnFamilyOptions().OptimizeForPointLookup(1024));
+
+	// The archive tables are append-mostly and rarely read, so they use universal compaction
+	// to keep write amplification low, rather than the point-lookup tuning of the other tables.
+	ColumnFamilyDescriptor OUTPUT_HISTORY_COLUMN = ColumnFamilyDescriptor("OUTPUT_HISTORY", *ColumnFamilyOptions().OptimizeUniversalStyleCompaction());
+	ColumnFamilyDescriptor BLOCK_HEIGHT_COLUMN = ColumnFamilyDescriptor("BLOCK_HEIGHT", *ColumnFamilyOptions().OptimizeUniversalStyleCompaction());
+
+	std::vector<ColumnFamilyDescriptor> tableNames = {
+		ColumnFamilyDescriptor(),
+		BLOCK_COLUMN,
+		HEADER_COLUMN,
+		BLOCK_SUMS_COLUMN,
+		OUTPUT_POS_COLUMN,
+		INPUT_BITMAP_COLUMN,
+		SPENT_OUTPUTS_COLUMN,
+		KERNEL_POS_COLUMN,
+		OUTPUT_HISTORY_COLUMN,
+		BLOCK_HEIGHT_COLUMN
+	};
+	std::shared_ptr<RocksDB> pRocksDB = RocksDBFactory::Open(dbPath, tableNames, "chain");
 	pRocksDB->DeleteAll("INPUT_BITMAP");
 
 	return std::make_shared<BlockDB>(config, pRocksDB);
@@ -195,4 +235,128 @@ void BlockDB::ClearSpentPositions()
 	LOG_WARNING("Deleting all spent positions.");
 
 	m_pRocksDB->DeleteAll("SPENT_OUTPUTS");
+}
+
+void BlockDB::AddKernelPosition(const Commitment& excessCommitment, const KernelLocation& location)
+{
+	rocksdb::Slice key((const char*)excessCommitment.data(), excessCommitment.size());
+
+	m_pRocksDB->Put("KERNEL_POS", DBEntry<KernelLocation>(key, location));
+}
+
+std::unique_ptr<KernelLocation> BlockDB::GetKernelPosition(const Commitment& excessCommitment) const
+{
+	rocksdb::Slice key((const char*)excessCommitment.data(), excessCommitment.size());
+	return m_pRocksDB->Get<KernelLocation>("KERNEL_POS", key);
+}
+
+void BlockDB::RemoveKernelPositions(const std::vector<Commitment>& excessCommitments)
+{
+	std::vector<std::string> keys;
+	std::transform(
+		excessCommitments.begin(), excessCommitments.end(),
+		std::back_inserter(keys),
+		[](const Commitment& commit) { return std::string((const char*)commit.data(), commit.size()); }
+	);
+
+	m_pRocksDB->Delete("KERNEL_POS", keys);
+}
+
+void BlockDB::ClearKernelPositions()
+{
+	LOG_WARNING("Deleting all kernel positions.");
+
+	m_pRocksDB->DeleteAll("KERNEL_POS");
+}
+
+void BlockDB::AddArchiveEntries(const FullBlock& block, const std::vector<SpentOutput>& spentOutputs)
+{
+	if (!m_config.GetNodeConfig().IsArchiveMode())
+	{
+		return;
+	}
+
+	if (!spentOutputs.empty())
+	{
+		std::vector<DBEntry<OutputHistory>> entries;
+		entries.reserve(spentOutputs.size());
+
+		for (const SpentOutput& spentOutput : spentOutputs)
+		{
+			const Commitment& commitment = spentOutput.GetCommitment();
+			rocksdb::Slice key((const char*)commitment.data(), commitment.size());
+			entries.push_back({ key, OutputHistory(spentOutput.GetLocation(), std::make_optional(block.GetHeight())) });
+		}
+
+		m_pRocksDB->Put("OUTPUT_HISTORY", entries);
+	}
+
+	const std::vector<unsigned char> heightKey = HeightKey(block.GetHeight());
+	rocksdb::Slice key((const char*)heightKey.data(), heightKey.size());
+	m_pRocksDB->Put("BLOCK_HEIGHT", DBEntry<ArchivedBlockHash>(key, ArchivedBlockHash(block.GetHash())));
+}
+
+void BlockDB::RemoveArchiveEntries(const FullBlock& block)
+{
+	if (!m_config.GetNodeConfig().IsArchiveMode())
+	{
+		return;
+	}
+
+	// The block's inputs are unspent again, so their current location lives in OUTPUT_POS.
+	std::vector<std::string> keys;
+	std::transform(
+		block.GetInputs().cbegin(), block.GetInputs().cend(),
+		std::back_inserter(keys),
+		[](const TransactionInput& input) { return std::string((const char*)input.GetCommitment().data(), input.GetCommitment().size()); }
+	);
+
+	m_pRocksDB->Delete("OUTPUT_HISTORY", keys);
+
+	const std::vector<unsigned char> heightKey = HeightKey(block.GetHeight());
+	m_pRocksDB->Delete("BLOCK_HEIGHT", rocksdb::Slice((const char*)heightKey.data(), heightKey.size()));
+}
+
+void BlockDB::ClearArchiveEntries()
+{
+	LOG_WARNING("Deleting all archive entries.");
+
+	m_pRocksDB->DeleteAll("OUTPUT_HISTORY");
+	m_pRocksDB->DeleteAll("BLOCK_HEIGHT");
+}
+
+std::unique_ptr<OutputHistory> BlockDB::GetOutputHistory(const Commitment& outputCommitment) const
+{
+	std::unique_ptr<OutputLocation> pLocation = GetOutputPosition(outputCommitment);
+	if (pLocation != nullptr)
+	{
+		return std::make_unique<OutputHistory>(*pLocation, std::nullopt);
+	}
+
+	if (!m_config.GetNodeConfig().IsArchiveMode())
+	{
+		return nullptr;
+	}
+
+	rocksdb::Slice key((const char*)outputCommitment.data(), outputCommitment.size());
+	return m_pRocksDB->Get<OutputHistory>("OUTPUT_HISTORY", key);
+}
+
+std::unique_ptr<Hash> BlockDB::GetArchivedBlockHash(const uint64_t height) const
+{
+	if (!m_config.GetNodeConfig().IsArchiveMode())
+	{
+		return nullptr;
+	}
+
+	const std::vector<unsigned char> heightKey = HeightKey(height);
+	rocksdb::Slice key((const char*)heightKey.data(), heightKey.size());
+
+	auto pEntry = m_pRocksDB->Get<ArchivedBlockHash>("BLOCK_HEIGHT", key);
+	if (pEntry != nullptr)
+	{
+		return std::make_unique<Hash>(pEntry->GetHash());
+	}
+
+	return nullptr;
 }
\ No newline at end of file
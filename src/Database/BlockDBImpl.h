@@ -43,6 +43,17 @@ public:
 	std::unordered_map<Commitment, OutputLocation> GetSpentPositions(const Hash& blockHash) const final;
 	void ClearSpentPositions() final;
 
+	void AddKernelPosition(const Commitment& excessCommitment, const KernelLocation& location) final;
+	std::unique_ptr<KernelLocation> GetKernelPosition(const Commitment& excessCommitment) const final;
+	void RemoveKernelPositions(const std::vector<Commitment>& excessCommitments) final;
+	void ClearKernelPositions() final;
+
+	void AddArchiveEntries(const FullBlock& block, const std::vector<SpentOutput>& spentOutputs) final;
+	void RemoveArchiveEntries(const FullBlock& block) final;
+	void ClearArchiveEntries() final;
+	std::unique_ptr<OutputHistory> GetOutputHistory(const Commitment& outputCommitment) const final;
+	std::unique_ptr<Hash> GetArchivedBlockHash(const uint64_t height) const final;
+
 private:
 	//Status Read(ColumnFamilyHandle* pFamilyHandle, const Slice& key, std::string* pValue) const;
 	//Status Write(ColumnFamilyHandle* pFamilyHandle, const Slice& key, const Slice& value);
@@ -5,11 +5,13 @@
 #include <Core/Traits/Batchable.h>
 #include <Database/DatabaseException.h>
 #include <Infrastructure/Logger.h>
+#include <Infrastructure/Metrics.h>
 #include <Core/Serialization/ByteBuffer.h>
 
 #include <rocksdb/db.h>
 #include <rocksdb/slice.h>
 #include <rocksdb/options.h>
+#include <rocksdb/statistics.h>
 #include <rocksdb/utilities/optimistic_transaction_db.h>
 #include <rocksdb/utilities/transaction.h>
 #include <filesystem.h>
@@ -20,11 +22,20 @@
 class RocksDB : public Traits::IBatchable
 {
 public:
-	RocksDB(const std::shared_ptr<rocksdb::OptimisticTransactionDB>& pTransactionDB, const std::vector<RocksDBTable>& tables)
-		: m_pTransactionDB(pTransactionDB), m_tables(tables) { }
+	RocksDB(
+		const std::shared_ptr<rocksdb::OptimisticTransactionDB>& pTransactionDB,
+		const std::vector<RocksDBTable>& tables,
+		const std::shared_ptr<rocksdb::Statistics>& pStatistics,
+		const std::string& metricsName)
+		: m_pTransactionDB(pTransactionDB), m_tables(tables), m_pStatistics(pStatistics)
+	{
+		m_collectorId = MetricsAPI::RegisterCollector([this, metricsName]() { CollectMetrics("rocksdb." + metricsName + "."); });
+	}
 
 	virtual ~RocksDB()
 	{
+		MetricsAPI::UnregisterCollector(m_collectorId);
+
 		for (RocksDBTable& table : m_tables)
 		{
 			table.CloseHandle();
@@ -160,6 +171,17 @@ public:
 				throw DATABASE_EXCEPTION(errorMessage);
 			}
 		}
+
+		// Outside of a batch, the entries are written together as a single bulk write.
+		if (pTempTransaction != nullptr)
+		{
+			status = pTempTransaction->Commit();
+			if (!status.ok())
+			{
+				LOG_ERROR_F("Bulk write to table {} failed with error {}", table, status.getState());
+				throw DATABASE_EXCEPTION_F("Bulk write to table {} failed with error {}", table, status.getState());
+			}
+		}
 	}
 
 	template<typename T,
@@ -297,6 +319,55 @@ public:
 	}
 
 private:
+	//
+	// Copies the RocksDB statistics into the metrics registry as gauges.
+	//
+	void CollectMetrics(const std::string& prefix) const
+	{
+		if (m_pStatistics == nullptr)
+		{
+			return;
+		}
+
+		static const std::vector<std::pair<rocksdb::Tickers, std::string>> TICKERS = {
+			{ rocksdb::BLOCK_CACHE_HIT, "block_cache_hit" },
+			{ rocksdb::BLOCK_CACHE_MISS, "block_cache_miss" },
+			{ rocksdb::BLOOM_FILTER_USEFUL, "bloom_filter_useful" },
+			{ rocksdb::MEMTABLE_HIT, "memtable_hit" },
+			{ rocksdb::MEMTABLE_MISS, "memtable_miss" },
+			{ rocksdb::GET_HIT_L0, "get_hit_l0" },
+			{ rocksdb::GET_HIT_L1, "get_hit_l1" },
+			{ rocksdb::GET_HIT_L2_AND_UP, "get_hit_l2_and_up" },
+			{ rocksdb::NUMBER_KEYS_READ, "keys_read" },
+			{ rocksdb::NUMBER_KEYS_WRITTEN, "keys_written" },
+			{ rocksdb::BYTES_READ, "bytes_read" },
+			{ rocksdb::BYTES_WRITTEN, "bytes_written" },
+			{ rocksdb::COMPACT_READ_BYTES, "compact_read_bytes" },
+			{ rocksdb::COMPACT_WRITE_BYTES, "compact_write_bytes" },
+			{ rocksdb::STALL_MICROS, "stall_micros" }
+		};
+
+		for (const auto& ticker : TICKERS)
+		{
+			MetricsAPI::GetGauge(prefix + ticker.second).Set((int64_t)m_pStatistics->getTickerCount(ticker.first));
+		}
+
+		static const std::vector<std::pair<rocksdb::Histograms, std::string>> HISTOGRAMS = {
+			{ rocksdb::DB_GET, "get_micros" },
+			{ rocksdb::DB_WRITE, "write_micros" },
+			{ rocksdb::COMPACTION_TIME, "compaction_micros" }
+		};
+
+		for (const auto& histogram : HISTOGRAMS)
+		{
+			rocksdb::HistogramData data;
+			m_pStatistics->histogramData(histogram.first, &data);
+			MetricsAPI::GetGauge(prefix + histogram.second + ".p50").Set((int64_t)data.median);
+			MetricsAPI::GetGauge(prefix + histogram.second + ".p99").Set((int64_t)data.percentile99);
+			MetricsAPI::GetGauge(prefix + histogram.second + ".max").Set((int64_t)data.max);
+		}
+	}
+
 	const RocksDBTable& GetTable(const std::string& name) const
 	{
 		for (const RocksDBTable& table : m_tables)
@@ -313,6 +384,8 @@ private:
 
 	std::shared_ptr<rocksdb::OptimisticTransactionDB> m_pTransactionDB;
 	std::vector<RocksDBTable> m_tables;
+	std::shared_ptr<rocksdb::Statistics> m_pStatistics;
+	uint64_t m_collectorId;
 
 	std::shared_ptr<rocksdb::Transaction> m_pTransaction;
 };
\ No newline at end of file
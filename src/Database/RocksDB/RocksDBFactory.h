@@ -14,8 +14,9 @@ class RocksDBFactory
 public:
 	//
 	// tableNames - First table name is the default table, so must be empty
+	// metricsName - Used to prefix the RocksDB statistics published to the metrics registry (eg. "rocksdb.chain.")
 	//
-    static std::shared_ptr<RocksDB> Open(const fs::path& dbPath, const std::vector<rocksdb::ColumnFamilyDescriptor>& tableNames)
+    static std::shared_ptr<RocksDB> Open(const fs::path& dbPath, const std::vector<rocksdb::ColumnFamilyDescriptor>& tableNames, const std::string& metricsName)
     {
 		fs::create_directories(dbPath);
 
@@ -23,6 +24,7 @@ public:
 		options.IncreaseParallelism();
 		options.create_if_missing = true;
 		options.compression = rocksdb::kNoCompression;
+		options.statistics = rocksdb::CreateDBStatistics();
 
 		std::vector<rocksdb::ColumnFamilyDescriptor> columnDescriptors = CreateDescriptors(options, dbPath, tableNames);
 
@@ -36,7 +38,12 @@ public:
 
 		std::vector<RocksDBTable> tables = CreateTables(pTransactionDB, tableNames, columnHandles);
 
-		return std::make_shared<RocksDB>(std::shared_ptr<rocksdb::OptimisticTransactionDB>(pTransactionDB), tables);
+		return std::make_shared<RocksDB>(
+			std::shared_ptr<rocksdb::OptimisticTransactionDB>(pTransactionDB),
+			tables,
+			options.statistics,
+			metricsName
+		);
     }
 
 private:
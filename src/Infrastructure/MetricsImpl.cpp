@@ -0,0 +1,249 @@
+#include <Infrastructure/Metrics.h>
+#include <Infrastructure/Logger.h>
+
+#include <memory>
+#include <mutex>
+#include <fstream>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+class MetricsRegistry
+{
+public:
+	static MetricsRegistry& GetInstance()
+	{
+		static MetricsRegistry instance;
+		return instance;
+	}
+
+	template<typename T>
+	T& GetOrCreate(std::map<std::string, std::unique_ptr<T>>& metrics, const std::string& name)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		auto iter = metrics.find(name);
+		if (iter == metrics.end())
+		{
+			iter = metrics.emplace(name, std::make_unique<T>()).first;
+		}
+
+		return *iter->second;
+	}
+
+	uint64_t RegisterCollector(const std::function<void()>& collector)
+	{
+		std::lock_guard<std::mutex> lock(m_collectorsMutex);
+
+		const uint64_t collectorId = m_nextCollectorId++;
+		m_collectors.insert({ collectorId, collector });
+		return collectorId;
+	}
+
+	void UnregisterCollector(const uint64_t collectorId)
+	{
+		std::lock_guard<std::mutex> lock(m_collectorsMutex);
+		m_collectors.erase(collectorId);
+	}
+
+	void RunCollectors()
+	{
+		std::lock_guard<std::mutex> lock(m_collectorsMutex);
+		for (auto& collector : m_collectors)
+		{
+			try
+			{
+				collector.second();
+			}
+			catch (std::exception& e)
+			{
+				LOG_WARNING_F("Metrics collector failed: {}", e.what());
+			}
+		}
+	}
+
+	std::map<std::string, uint64_t> GetCounters()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		std::map<std::string, uint64_t> counters;
+		for (const auto& iter : m_counters)
+		{
+			counters.insert({ iter.first, iter.second->GetValue() });
+		}
+
+		return counters;
+	}
+
+	std::map<std::string, int64_t> GetGauges()
+	{
+		RunCollectors();
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		std::map<std::string, int64_t> gauges;
+		for (const auto& iter : m_gauges)
+		{
+			gauges.insert({ iter.first, iter.second->GetValue() });
+		}
+
+		return gauges;
+	}
+
+	std::map<std::string, Metrics::HistogramSnapshot> GetHistograms()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		std::map<std::string, Metrics::HistogramSnapshot> histograms;
+		for (const auto& iter : m_histograms)
+		{
+			histograms.insert({ iter.first, iter.second->GetSnapshot() });
+		}
+
+		return histograms;
+	}
+
+	std::map<std::string, std::unique_ptr<Metrics::Counter>> m_counters;
+	std::map<std::string, std::unique_ptr<Metrics::Gauge>> m_gauges;
+	std::map<std::string, std::unique_ptr<Metrics::Histogram>> m_histograms;
+
+private:
+	MetricsRegistry() = default;
+
+	std::mutex m_mutex;
+
+	std::mutex m_collectorsMutex;
+	uint64_t m_nextCollectorId = 0;
+	std::map<uint64_t, std::function<void()>> m_collectors;
+};
+
+namespace MetricsAPI
+{
+	METRICS_API Metrics::Counter& GetCounter(const std::string& name)
+	{
+		MetricsRegistry& registry = MetricsRegistry::GetInstance();
+		return registry.GetOrCreate(registry.m_counters, name);
+	}
+
+	METRICS_API Metrics::Gauge& GetGauge(const std::string& name)
+	{
+		MetricsRegistry& registry = MetricsRegistry::GetInstance();
+		return registry.GetOrCreate(registry.m_gauges, name);
+	}
+
+	METRICS_API Metrics::Histogram& GetHistogram(const std::string& name)
+	{
+		MetricsRegistry& registry = MetricsRegistry::GetInstance();
+		return registry.GetOrCreate(registry.m_histograms, name);
+	}
+
+	METRICS_API uint64_t RegisterCollector(const std::function<void()>& collector)
+	{
+		return MetricsRegistry::GetInstance().RegisterCollector(collector);
+	}
+
+	METRICS_API void UnregisterCollector(const uint64_t collectorId)
+	{
+		MetricsRegistry::GetInstance().UnregisterCollector(collectorId);
+	}
+
+	METRICS_API std::map<std::string, uint64_t> GetCounters()
+	{
+		return MetricsRegistry::GetInstance().GetCounters();
+	}
+
+	METRICS_API std::map<std::string, int64_t> GetGauges()
+	{
+		return MetricsRegistry::GetInstance().GetGauges();
+	}
+
+	METRICS_API std::map<std::string, Metrics::HistogramSnapshot> GetHistograms()
+	{
+		return MetricsRegistry::GetInstance().GetHistograms();
+	}
+
+	METRICS_API Metrics::ProcessStats GetProcessStats()
+	{
+		Metrics::ProcessStats stats{ 0, 0, 0 };
+
+#ifdef _WIN32
+		PROCESS_MEMORY_COUNTERS memoryCounters;
+		if (GetProcessMemoryInfo(GetCurrentProcess(), &memoryCounters, sizeof(memoryCounters)))
+		{
+			stats.peakMemoryBytes = memoryCounters.PeakWorkingSetSize;
+		}
+
+		IO_COUNTERS ioCounters;
+		if (GetProcessIoCounters(GetCurrentProcess(), &ioCounters))
+		{
+			stats.readBytes = ioCounters.ReadTransferCount;
+			stats.writeBytes = ioCounters.WriteTransferCount;
+		}
+#else
+		struct rusage usage;
+		if (getrusage(RUSAGE_SELF, &usage) == 0)
+		{
+#ifdef __APPLE__
+			stats.peakMemoryBytes = (uint64_t)usage.ru_maxrss;
+#else
+			stats.peakMemoryBytes = (uint64_t)usage.ru_maxrss * 1024;
+#endif
+		}
+
+		// Bytes actually fetched from or sent to the storage layer, so page cache hits don't count as reads.
+		std::ifstream io("/proc/self/io");
+		std::string key;
+		uint64_t value = 0;
+		while (io >> key >> value)
+		{
+			if (key == "read_bytes:")
+			{
+				stats.readBytes = value;
+			}
+			else if (key == "write_bytes:")
+			{
+				stats.writeBytes = value;
+			}
+		}
+#endif
+
+		return stats;
+	}
+
+	METRICS_API void LogSummary()
+	{
+		for (const auto& counter : GetCounters())
+		{
+			if (counter.second > 0)
+			{
+				LOG_INFO_F("{}: {}", counter.first, counter.second);
+			}
+		}
+
+		for (const auto& gauge : GetGauges())
+		{
+			LOG_INFO_F("{}: {}", gauge.first, gauge.second);
+		}
+
+		for (const auto& histogram : GetHistograms())
+		{
+			const Metrics::HistogramSnapshot& snapshot = histogram.second;
+			if (snapshot.count > 0)
+			{
+				LOG_INFO_F(
+					"{}: count={} mean={}us p50={}us p99={}us max={}us",
+					histogram.first,
+					snapshot.count,
+					snapshot.Mean(),
+					snapshot.p50,
+					snapshot.p99,
+					snapshot.max
+				);
+			}
+		}
+	}
+}
\ No newline at end of file
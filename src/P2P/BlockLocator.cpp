@@ -83,16 +83,45 @@ std::vector<BlockHeaderPtr> BlockLocator::LocateHeaders(const std::vector<Hash>&
 	return blockHeaders;
 }
 
+//
+// Locators are sorted from highest to lowest, and once one of them is on our candidate chain, so are all that follow.
+// The highest common locator is therefore found with a binary search, rather than by looking up every locator.
+//
 BlockHeaderPtr BlockLocator::FindCommonHeader(const std::vector<Hash>& locatorHashes) const
 {
-	for (const Hash& locatorHash : locatorHashes)
+	auto getCandidateHeader = [this](const Hash& hash) -> BlockHeaderPtr
 	{
-		auto pHeader = m_pBlockChainServer->GetBlockHeaderByHash(locatorHash);
+		auto pHeader = m_pBlockChainServer->GetBlockHeaderByHash(hash);
 		if (pHeader != nullptr)
 		{
-			return pHeader;
+			auto pCandidateHeader = m_pBlockChainServer->GetBlockHeaderByHeight(pHeader->GetHeight(), EChainType::CANDIDATE);
+			if (pCandidateHeader != nullptr && pCandidateHeader->GetHash() == hash)
+			{
+				return pCandidateHeader;
+			}
+		}
+
+		return nullptr;
+	};
+
+	BlockHeaderPtr pCommonHeader = nullptr;
+
+	size_t low = 0;
+	size_t high = locatorHashes.size();
+	while (low < high)
+	{
+		const size_t middle = low + ((high - low) / 2);
+		auto pHeader = getCandidateHeader(locatorHashes[middle]);
+		if (pHeader != nullptr)
+		{
+			pCommonHeader = pHeader;
+			high = middle;
+		}
+		else
+		{
+			low = middle + 1;
 		}
 	}
 
-	return nullptr;
+	return pCommonHeader;
 }
\ No newline at end of file
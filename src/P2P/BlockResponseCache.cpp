@@ -0,0 +1,93 @@
+#include "BlockResponseCache.h"
+#include "Messages/BlockMessage.h"
+#include "Messages/CompactBlockMessage.h"
+
+#include <Infrastructure/Metrics.h>
+
+// Full blocks can be over a megabyte, so only the most recent few are kept.
+static const size_t MAX_BLOCKS = 16;
+static const size_t MAX_COMPACT_BLOCKS = 64;
+
+BlockResponseCache::BlockResponseCache()
+	: m_blocks(MAX_BLOCKS), m_compactBlocks(MAX_COMPACT_BLOCKS)
+{
+
+}
+
+std::shared_ptr<const SerializedMessage> BlockResponseCache::GetBlockMessage(const IBlockChainServer& blockChainServer, const Hash& hash)
+{
+	auto pCached = Find(MessageTypes::Block, hash);
+	if (pCached != nullptr)
+	{
+		return pCached;
+	}
+
+	std::unique_ptr<FullBlock> pBlock = blockChainServer.GetBlockByHash(hash);
+	if (pBlock == nullptr)
+	{
+		return nullptr;
+	}
+
+	auto pMessage = std::make_shared<const SerializedMessage>(SerializedMessage::FromMessage(BlockMessage(std::move(*pBlock))));
+	Add(hash, pMessage);
+	return pMessage;
+}
+
+std::shared_ptr<const SerializedMessage> BlockResponseCache::GetCompactBlockMessage(const IBlockChainServer& blockChainServer, const Hash& hash)
+{
+	auto pCached = Find(MessageTypes::CompactBlockMsg, hash);
+	if (pCached != nullptr)
+	{
+		return pCached;
+	}
+
+	std::unique_ptr<CompactBlock> pCompactBlock = blockChainServer.GetCompactBlockByHash(hash);
+	if (pCompactBlock == nullptr)
+	{
+		return nullptr;
+	}
+
+	auto pMessage = std::make_shared<const SerializedMessage>(SerializedMessage::FromMessage(CompactBlockMessage(std::move(*pCompactBlock))));
+	Add(hash, pMessage);
+	return pMessage;
+}
+
+void BlockResponseCache::AddPayload(const MessageTypes::EMessageType messageType, const Hash& hash, const std::vector<unsigned char>& payload)
+{
+	Add(hash, std::make_shared<const SerializedMessage>(messageType, std::vector<unsigned char>(payload)));
+}
+
+LRUCache<Hash, std::shared_ptr<const SerializedMessage>>& BlockResponseCache::GetCache(const MessageTypes::EMessageType messageType)
+{
+	return messageType == MessageTypes::Block ? m_blocks : m_compactBlocks;
+}
+
+std::shared_ptr<const SerializedMessage> BlockResponseCache::Find(const MessageTypes::EMessageType messageType, const Hash& hash)
+{
+	static Metrics::Counter& hits = MetricsAPI::GetCounter("p2p.block_response_cache.hits");
+	static Metrics::Counter& misses = MetricsAPI::GetCounter("p2p.block_response_cache.misses");
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	auto& cache = GetCache(messageType);
+	if (cache.Cached(hash))
+	{
+		hits.Increment();
+		return cache.Get(hash);
+	}
+
+	misses.Increment();
+	return nullptr;
+}
+
+void BlockResponseCache::Add(const Hash& hash, const std::shared_ptr<const SerializedMessage>& pMessage)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	// Keep the first copy, so every peer keeps getting the same bytes (and compact block nonce).
+	auto& cache = GetCache(pMessage->GetMessageType());
+	if (!cache.Cached(hash))
+	{
+		cache.Put(hash, pMessage);
+	}
+}
\ No newline at end of file
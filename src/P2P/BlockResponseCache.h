@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Messages/SerializedMessage.h"
+
+#include <BlockChain/BlockChainServer.h>
+#include <Crypto/Hash.h>
+#include <caches/Cache.h>
+#include <memory>
+#include <mutex>
+
+//
+// An LRU cache of serialized Block and CompactBlock messages for recent blocks, keyed by block hash.
+//
+// When a new block is relayed, every peer requests it at about the same time.
+// Serving all of them from one cached copy means the block is only loaded from the DB and serialized once.
+// Compact blocks carry a random nonce, so serving the same cached one to every peer is also what keeps their
+// short ids consistent across the network.
+//
+class BlockResponseCache
+{
+public:
+	BlockResponseCache();
+
+	//
+	// Returns the Block message for the given hash, loading and serializing it on a cache miss.
+	// This will be null if the block is not found.
+	//
+	std::shared_ptr<const SerializedMessage> GetBlockMessage(const IBlockChainServer& blockChainServer, const Hash& hash);
+
+	//
+	// Returns the CompactBlock message for the given hash, building and serializing it on a cache miss.
+	// This will be null if the block is not found.
+	//
+	std::shared_ptr<const SerializedMessage> GetCompactBlockMessage(const IBlockChainServer& blockChainServer, const Hash& hash);
+
+	//
+	// Caches the payload of a Block or CompactBlock message received from a peer, so it can be relayed as-is.
+	//
+	void AddPayload(const MessageTypes::EMessageType messageType, const Hash& hash, const std::vector<unsigned char>& payload);
+
+private:
+	LRUCache<Hash, std::shared_ptr<const SerializedMessage>>& GetCache(const MessageTypes::EMessageType messageType);
+	std::shared_ptr<const SerializedMessage> Find(const MessageTypes::EMessageType messageType, const Hash& hash);
+	void Add(const Hash& hash, const std::shared_ptr<const SerializedMessage>& pMessage);
+
+	std::mutex m_mutex;
+	LRUCache<Hash, std::shared_ptr<const SerializedMessage>> m_blocks;
+	LRUCache<Hash, std::shared_ptr<const SerializedMessage>> m_compactBlocks;
+};
\ No newline at end of file
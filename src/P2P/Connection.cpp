@@ -8,8 +8,6 @@
 #include "Seed/HandShake.h"
 
 #include <Net/SocketException.h>
-#include <Common/Util/ThreadUtil.h>
-#include <Infrastructure/ThreadManager.h>
 #include <Infrastructure/Logger.h>
 #include <thread>
 #include <chrono>
@@ -24,7 +22,9 @@ Connection::Connection(
 	std::shared_ptr<HandShake> pHandShake,
 	const std::weak_ptr<MessageProcessor>& pMessageProcessor,
 	std::shared_ptr<MessageRetriever> pMessageRetriever,
-	std::shared_ptr<MessageSender> pMessageSender)
+	std::shared_ptr<MessageSender> pMessageSender,
+	const TaskGroup::Ptr& pPeerGroup,
+	const TaskGroup::Ptr& pTransferGroup)
 	: m_pSocket(pSocket),
 	m_connectionId(connectionId),
 	m_connectionManager(connectionManager),
@@ -34,6 +34,8 @@ Connection::Connection(
 	m_pMessageProcessor(pMessageProcessor),
 	m_pMessageRetriever(pMessageRetriever),
 	m_pMessageSender(pMessageSender),
+	m_pPeerGroup(pPeerGroup),
+	m_pTransferGroup(pTransferGroup),
 	m_terminate(false)
 {
 
@@ -47,7 +49,9 @@ Connection::~Connection()
 void Connection::Disconnect()
 {
 	m_terminate = true;
-	ThreadUtil::Join(m_connectionThread);
+
+	// Waits for an in-progress tick to finish. The lock is recursive, since a tick can trigger a disconnect.
+	std::unique_lock<std::recursive_mutex> lock(m_tickMutex);
 	m_connectedPeer.GetPeer()->SetConnected(false);
 	m_pSocket.reset();
 }
@@ -60,7 +64,10 @@ std::shared_ptr<Connection> Connection::Create(
 	IBlockChainServerPtr pBlockChainServer,
 	const ConnectedPeer& connectedPeer,
 	const std::weak_ptr<MessageProcessor>& pMessageProcessor,
-	SyncStatusConstPtr pSyncStatus)
+	SyncStatusConstPtr pSyncStatus,
+	const TaskGroup::Ptr& pConnectGroup,
+	const TaskGroup::Ptr& pPeerGroup,
+	const TaskGroup::Ptr& pTransferGroup)
 {
 	auto pHandShake = std::make_shared<HandShake>(config, connectionManager, pBlockChainServer);
 	auto pMessageRetriever = std::make_shared<MessageRetriever>(config, connectionManager);
@@ -75,10 +82,11 @@ std::shared_ptr<Connection> Connection::Create(
 		pHandShake,
 		pMessageProcessor,
 		pMessageRetriever,
-		pMessageSender
+		pMessageSender,
+		pPeerGroup,
+		pTransferGroup
 	));
-	pConnection->m_connectionThread = std::thread(Thread_ProcessConnection, pConnection);
-	ThreadManagerAPI::SetThreadName(pConnection->m_connectionThread.get_id(), "PEER");
+	pConnectGroup->Post(ETaskPriority::NORMAL, [pConnection] { Task_Connect(pConnection); });
 	return pConnection;
 }
 
@@ -104,10 +112,10 @@ bool Connection::ExceedsRateLimit() const
 }
 
 //
-// Continuously checks for messages to send and/or receive until the connection is terminated.
-// This function runs in its own thread.
+// Connects (for outbound connections) and performs the handshake.
+// On success, the connection's first tick is posted to the peer group.
 //
-void Connection::Thread_ProcessConnection(std::shared_ptr<Connection> pConnection)
+void Connection::Task_Connect(std::shared_ptr<Connection> pConnection)
 {
 	try
 	{
@@ -140,41 +148,97 @@ void Connection::Thread_ProcessConnection(std::shared_ptr<Connection> pConnectio
 		{
 			pConnection->m_pSocket->CloseSocket();
 			pConnection->m_terminate = true;
-			ThreadUtil::Detach(pConnection->m_connectionThread);
 			return;
 		}
 	}
 	catch (...)
 	{
-        LOG_ERROR("Exception caught");
-        pConnection->m_terminate = true;
-		ThreadUtil::Detach(pConnection->m_connectionThread);
+		LOG_ERROR("Exception caught");
+		pConnection->m_terminate = true;
 		return;
 	}
 
 	pConnection->m_connectedPeer.GetPeer()->SetConnected(true);
 
-	SyncStatusConstPtr pSyncStatus = pConnection->m_pSyncStatus;
+	pConnection->m_lastPingTime = std::chrono::system_clock::now();
+	pConnection->m_lastReceivedMessageTime = std::chrono::system_clock::now();
+	pConnection->m_pPeerGroup->Post(ETaskPriority::NORMAL, [pConnection] { Task_ProcessConnection(pConnection); });
+}
+
+//
+// Runs one tick of the connection, then reposts itself until the connection is terminated.
+//
+void Connection::Task_ProcessConnection(std::shared_ptr<Connection> pConnection)
+{
+	Reschedule(pConnection, pConnection->ProcessConnection());
+}
 
-	std::chrono::system_clock::time_point lastPingTime = std::chrono::system_clock::now();
-	std::chrono::system_clock::time_point lastReceivedMessageTime = std::chrono::system_clock::now();
+//
+// Sends or receives a TxHashSet, then resumes the connection's ticks.
+//
+void Connection::Task_ProcessTransfer(std::shared_ptr<Connection> pConnection)
+{
+	Reschedule(pConnection, pConnection->ProcessTransfer());
+}
 
-	while (!pConnection->m_terminate && !pConnection->GetPeer()->IsBanned())
+//
+// Busy connections are reposted immediately, while idle connections wait a few milliseconds before checking again.
+// Pending TxHashSet transfers are posted to the transfer group, so they never hold up the ticks of other peers.
+//
+void Connection::Reschedule(const std::shared_ptr<Connection>& pConnection, const ETickResult result)
+{
+	if (result == ETickResult::BUSY)
 	{
-		if (pConnection->ExceedsRateLimit())
+		pConnection->m_pPeerGroup->Post(ETaskPriority::NORMAL, [pConnection] { Task_ProcessConnection(pConnection); });
+	}
+	else if (result == ETickResult::IDLE)
+	{
+		pConnection->m_pPeerGroup->PostAfter(
+			std::chrono::milliseconds(5),
+			ETaskPriority::NORMAL,
+			[pConnection] { Task_ProcessConnection(pConnection); }
+		);
+	}
+	else if (result == ETickResult::TRANSFER)
+	{
+		pConnection->m_pTransferGroup->Post(ETaskPriority::NORMAL, [pConnection] { Task_ProcessTransfer(pConnection); });
+	}
+}
+
+//
+// Checks for messages to send and/or receive, for a bounded number of iterations so one busy peer can't hold a worker.
+//
+Connection::ETickResult Connection::ProcessConnection()
+{
+	static const size_t MAX_ITERATIONS_PER_TICK = 16;
+
+	std::unique_lock<std::recursive_mutex> lock(m_tickMutex);
+	if (m_terminate)
+	{
+		return ETickResult::CLOSED;
+	}
+
+	for (size_t i = 0; i < MAX_ITERATIONS_PER_TICK; i++)
+	{
+		if (m_terminate || GetPeer()->IsBanned())
 		{
-			LOG_WARNING_F("Banning peer ({}) for exceeding rate limit.", pConnection->GetIPAddress());
-			pConnection->GetPeer()->Ban(EBanReason::Abusive);
+			break;
+		}
+
+		if (ExceedsRateLimit())
+		{
+			LOG_WARNING_F("Banning peer ({}) for exceeding rate limit.", GetIPAddress());
+			GetPeer()->Ban(EBanReason::Abusive);
 			break;
 		}
 
 		auto now = std::chrono::system_clock::now();
-		if (lastPingTime + std::chrono::seconds(10) < now)
+		if (m_lastPingTime + std::chrono::seconds(10) < now)
 		{
-			const PingMessage pingMessage(pSyncStatus->GetBlockDifficulty(), pSyncStatus->GetBlockHeight());
-			pConnection->Send(pingMessage);
+			const PingMessage pingMessage(m_pSyncStatus->GetBlockDifficulty(), m_pSyncStatus->GetBlockHeight());
+			Send(pingMessage);
 
-			lastPingTime = now;
+			m_lastPingTime = now;
 		}
 
 		try
@@ -182,57 +246,56 @@ void Connection::Thread_ProcessConnection(std::shared_ptr<Connection> pConnectio
 			bool messageSentOrReceived = false;
 
 			// Check for received messages and if there is a new message, process it.
-			std::unique_ptr<RawMessage> pRawMessage = pConnection->m_pMessageRetriever->RetrieveMessage(
-				*pConnection->m_pSocket,
-				pConnection->m_connectedPeer,
+			std::unique_ptr<RawMessage> pRawMessage = m_pMessageRetriever->RetrieveMessage(
+				*m_pSocket,
+				m_connectedPeer,
 				MessageRetriever::NON_BLOCKING
 			);
 
 			if (pRawMessage != nullptr)
 			{
-				auto pMessageProcessor = pConnection->m_pMessageProcessor.lock();
-				if (pMessageProcessor != nullptr)
+				const MessageTypes::EMessageType messageType = pRawMessage->GetMessageHeader().GetMessageType();
+				if (messageType == MessageTypes::TxHashSetRequest || messageType == MessageTypes::TxHashSetArchive)
+				{
+					m_lastReceivedMessageTime = std::chrono::system_clock::now();
+					m_pTransferMessage = std::move(pRawMessage);
+					return ETickResult::TRANSFER;
+				}
+
+				if (!ProcessMessage(*pRawMessage))
 				{
-					const MessageProcessor::EStatus status = pMessageProcessor->ProcessMessage(
-						pConnection->m_connectionId,
-						*pConnection->m_pSocket,
-						pConnection->m_connectedPeer,
-						*pRawMessage
-					);
-
-					if (status == MessageProcessor::EStatus::BAN_PEER)
-					{
-						EBanReason banReason = EBanReason::Abusive; // TODO: Determine real reason.
-						LOG_WARNING_F("Banning peer ({}) for ({}).", pConnection->GetIPAddress(), BanReason::Format(banReason));
-						pConnection->GetPeer()->Ban(banReason);
-						break;
-					}
+					break;
 				}
-                
-                lastReceivedMessageTime = std::chrono::system_clock::now();
+
+				m_lastReceivedMessageTime = std::chrono::system_clock::now();
 				messageSentOrReceived = true;
+
+				if (m_terminate)
+				{
+					break;
+				}
 			}
 
 			// Send the next message in the queue, if one exists.
-			auto pMessageToSend = pConnection->m_sendQueue.copy_front();
+			auto pMessageToSend = m_sendQueue.copy_front();
 			if (pMessageToSend != nullptr)
 			{
 				IMessagePtr pMessage = *pMessageToSend;
-				pConnection->m_sendQueue.pop_front(1);
+				m_sendQueue.pop_front(1);
 
-				pConnection->m_pMessageSender->Send(*pConnection->m_pSocket, *pMessage);
+				m_pMessageSender->Send(*m_pSocket, *pMessage);
 
 				messageSentOrReceived = true;
 			}
-			
+
 			if (!messageSentOrReceived)
 			{
-				if ((lastReceivedMessageTime + std::chrono::seconds(30)) < std::chrono::system_clock::now())
+				if ((m_lastReceivedMessageTime + std::chrono::seconds(30)) < std::chrono::system_clock::now())
 				{
 					break;
 				}
 
-				ThreadUtil::SleepFor(std::chrono::milliseconds(5), pConnection->m_terminate);
+				return ETickResult::IDLE;
 			}
 		}
 		catch (const DeserializationException&)
@@ -266,8 +329,74 @@ void Connection::Thread_ProcessConnection(std::shared_ptr<Connection> pConnectio
 			LOG_ERROR("Unknown error occurred.");
 			break;
 		}
+
+		if (i + 1 == MAX_ITERATIONS_PER_TICK)
+		{
+			return ETickResult::BUSY;
+		}
 	}
 
-	pConnection->GetSocket()->CloseSocket();
-	pConnection->m_connectedPeer.GetPeer()->SetConnected(false);
+	Close();
+	return ETickResult::CLOSED;
 }
+
+Connection::ETickResult Connection::ProcessTransfer()
+{
+	std::unique_lock<std::recursive_mutex> lock(m_tickMutex);
+	std::unique_ptr<RawMessage> pRawMessage = std::move(m_pTransferMessage);
+	if (m_terminate || pRawMessage == nullptr)
+	{
+		return ETickResult::CLOSED;
+	}
+
+	try
+	{
+		if (ProcessMessage(*pRawMessage))
+		{
+			m_lastReceivedMessageTime = std::chrono::system_clock::now();
+			return ETickResult::BUSY;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		LOG_ERROR_F("Exception occurred during TxHashSet transfer with {}: {}", GetIPAddress(), e.what());
+	}
+
+	Close();
+	return ETickResult::CLOSED;
+}
+
+bool Connection::ProcessMessage(const RawMessage& rawMessage)
+{
+	auto pMessageProcessor = m_pMessageProcessor.lock();
+	if (pMessageProcessor != nullptr)
+	{
+		const MessageProcessor::EStatus status = pMessageProcessor->ProcessMessage(
+			m_connectionId,
+			*m_pSocket,
+			m_connectedPeer,
+			rawMessage
+		);
+
+		if (status == MessageProcessor::EStatus::BAN_PEER)
+		{
+			EBanReason banReason = EBanReason::Abusive; // TODO: Determine real reason.
+			LOG_WARNING_F("Banning peer ({}) for ({}).", GetIPAddress(), BanReason::Format(banReason));
+			GetPeer()->Ban(banReason);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void Connection::Close()
+{
+	if (m_pSocket != nullptr)
+	{
+		m_pSocket->CloseSocket();
+	}
+
+	m_terminate = true;
+	m_connectedPeer.GetPeer()->SetConnected(false);
+}
\ No newline at end of file
@@ -1,13 +1,17 @@
 #pragma once
 
 #include "Messages/Message.h"
+#include "Messages/RawMessage.h"
 
 #include <Common/ConcurrentQueue.h>
+#include <Common/TaskPool.h>
 #include <BlockChain/BlockChainServer.h>
 #include <Net/Socket.h>
 #include <P2P/ConnectedPeer.h>
 #include <Config/Config.h>
 #include <atomic>
+#include <chrono>
+#include <mutex>
 #include <queue>
 
 // Forward Declarations
@@ -21,8 +25,10 @@ class MessageSender;
 
 //
 // A Connection will be created for each ConnectedPeer.
-// Each Connection will run on its own thread, and will watch the socket for messages,
-// and will ping the peer when it hasn't been heard from in a while.
+// Each Connection connects and handshakes as a task in the connect group, then repeatedly posts short ticks
+// to the peer group that watch the socket for messages, and ping the peer when it hasn't been heard from in a while.
+// TxHashSet requests and archives stream hundreds of MB over the socket, so they are handled in the transfer group instead,
+// and the connection's ticks resume once the transfer is done.
 //
 class Connection
 {
@@ -36,7 +42,9 @@ public:
 		std::shared_ptr<HandShake> pHandShake,
 		const std::weak_ptr<MessageProcessor>& pMessageProcessor,
 		std::shared_ptr<MessageRetriever> pMessageRetriever,
-		std::shared_ptr<MessageSender> pMessageSender
+		std::shared_ptr<MessageSender> pMessageSender,
+		const TaskGroup::Ptr& pPeerGroup,
+		const TaskGroup::Ptr& pTransferGroup
 	);
 	Connection(const Connection&) = delete;
 	Connection& operator=(const Connection&) = delete;
@@ -51,7 +59,10 @@ public:
 		IBlockChainServerPtr pBlockChainServer,
 		const ConnectedPeer& connectedPeer,
 		const std::weak_ptr<MessageProcessor>& pMessageProcessor,
-		SyncStatusConstPtr pSyncStatus
+		SyncStatusConstPtr pSyncStatus,
+		const TaskGroup::Ptr& pConnectGroup,
+		const TaskGroup::Ptr& pPeerGroup,
+		const TaskGroup::Ptr& pTransferGroup
 	);
 
 	void Disconnect();
@@ -73,7 +84,26 @@ public:
 	bool ExceedsRateLimit() const;
 
 private:
-	static void Thread_ProcessConnection(std::shared_ptr<Connection> pConnection);
+	static void Task_Connect(std::shared_ptr<Connection> pConnection);
+	static void Task_ProcessConnection(std::shared_ptr<Connection> pConnection);
+	static void Task_ProcessTransfer(std::shared_ptr<Connection> pConnection);
+
+	enum class ETickResult
+	{
+		BUSY,
+		IDLE,
+		TRANSFER,
+		CLOSED
+	};
+
+	static void Reschedule(const std::shared_ptr<Connection>& pConnection, const ETickResult result);
+
+	ETickResult ProcessConnection();
+	ETickResult ProcessTransfer();
+
+	// Returns false if the peer was banned.
+	bool ProcessMessage(const RawMessage& rawMessage);
+	void Close();
 
 	ConnectionManager& m_connectionManager;
 	SyncStatusConstPtr m_pSyncStatus;
@@ -84,7 +114,12 @@ private:
 	std::shared_ptr<MessageSender> m_pMessageSender;
 
 	std::atomic<bool> m_terminate = true;
-	std::thread m_connectionThread;
+	TaskGroup::Ptr m_pPeerGroup;
+	TaskGroup::Ptr m_pTransferGroup;
+	std::unique_ptr<RawMessage> m_pTransferMessage;
+	std::recursive_mutex m_tickMutex;
+	std::chrono::system_clock::time_point m_lastPingTime;
+	std::chrono::system_clock::time_point m_lastReceivedMessageTime;
 	const uint64_t m_connectionId;
 
 	ConnectedPeer m_connectedPeer;
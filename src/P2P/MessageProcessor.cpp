@@ -218,26 +218,22 @@ MessageProcessor::EStatus MessageProcessor::ProcessMessageInternal(
 			}
 			case Headers:
 			{
-				IBlockChainServerPtr pBlockChainServer = m_pBlockChainServer;
-
 				const HeadersMessage headersMessage = HeadersMessage::Deserialize(byteBuffer);
-				const std::vector<BlockHeaderPtr>& blockHeaders = headersMessage.GetHeaders();
+				std::vector<BlockHeaderPtr> blockHeaders = headersMessage.GetHeaders();
 
 				LOG_DEBUG_F("{} headers received from {}", blockHeaders.size(), formattedIPAddress);
 
-				const EBlockChainStatus status = pBlockChainServer->AddBlockHeaders(blockHeaders);
-				LOG_DEBUG_F("Headers message from {} finished processing", formattedIPAddress);
-
-				return status == EBlockChainStatus::INVALID ? EStatus::BAN_PEER : EStatus::SUCCESS;
+				// Headers are validated asynchronously, in order. The header pipe bans the peer if they're invalid.
+				const bool accepted = m_pPipeline->GetHeaderPipe()->AddHeadersToProcess(connectedPeer.GetPeer(), std::move(blockHeaders));
+				return accepted ? EStatus::SUCCESS : EStatus::BAN_PEER;
 			}
 			case GetBlock:
 			{
 				const GetBlockMessage getBlockMessage = GetBlockMessage::Deserialize(byteBuffer);
-				std::unique_ptr<FullBlock> pBlock = m_pBlockChainServer->GetBlockByHash(getBlockMessage.GetHash());
-				if (pBlock != nullptr)
+				auto pBlockMessage = m_blockResponseCache.GetBlockMessage(*m_pBlockChainServer, getBlockMessage.GetHash());
+				if (pBlockMessage != nullptr)
 				{
-					BlockMessage blockMessage(std::move(*pBlock));
-					return MessageSender(m_config).Send(socket, blockMessage) ? EStatus::SUCCESS : EStatus::SOCKET_FAILURE;
+					return MessageSender(m_config).Send(socket, *pBlockMessage) ? EStatus::SUCCESS : EStatus::SOCKET_FAILURE;
 				}
 
 				return EStatus::RESOURCE_NOT_FOUND;
@@ -251,13 +247,16 @@ MessageProcessor::EStatus MessageProcessor::ProcessMessageInternal(
 
 				if (m_pSyncStatus->GetStatus() == ESyncStatus::SYNCING_BLOCKS)
 				{
-					m_pPipeline->GetBlockPipe()->AddBlockToProcess(connectedPeer.GetPeer(), block);
+					m_pPipeline->GetBlockPipe()->AddBlockToProcess(connectedPeer.GetPeer(), blockMessage.GetBlockPtr(), header.GetMessageLength());
 				}
 				else
 				{
-					const EBlockChainStatus added = m_pBlockChainServer->AddBlock(block);
+					const EBlockChainStatus added = m_pBlockChainServer->AddBlock(blockMessage.GetBlockPtr(), connectedPeer.GetPeer()->GetIPAddress().Format());
 					if (added == EBlockChainStatus::SUCCESS)
 					{
+						// Peers will request the block after seeing the header, so keep the bytes we received to serve them.
+						m_blockResponseCache.AddPayload(Block, block.GetHash(), rawMessage.GetPayload());
+
 						const HeaderMessage headerMessage(block.GetBlockHeader());
 						m_connectionManager.BroadcastMessage(headerMessage, connectionId);
 						return EStatus::SUCCESS;
@@ -281,11 +280,10 @@ MessageProcessor::EStatus MessageProcessor::ProcessMessageInternal(
 			case GetCompactBlock:
 			{
 				const GetCompactBlockMessage getCompactBlockMessage = GetCompactBlockMessage::Deserialize(byteBuffer);
-				std::unique_ptr<CompactBlock> pCompactBlock = m_pBlockChainServer->GetCompactBlockByHash(getCompactBlockMessage.GetHash());
-				if (pCompactBlock != nullptr)
+				auto pCompactBlockMessage = m_blockResponseCache.GetCompactBlockMessage(*m_pBlockChainServer, getCompactBlockMessage.GetHash());
+				if (pCompactBlockMessage != nullptr)
 				{
-					const CompactBlockMessage compactBlockMessage(*pCompactBlock);
-					return MessageSender(m_config).Send(socket, compactBlockMessage) ? EStatus::SUCCESS : EStatus::SOCKET_FAILURE;
+					return MessageSender(m_config).Send(socket, *pCompactBlockMessage) ? EStatus::SUCCESS : EStatus::SOCKET_FAILURE;
 				}
 
 				return EStatus::RESOURCE_NOT_FOUND;
@@ -298,6 +296,8 @@ MessageProcessor::EStatus MessageProcessor::ProcessMessageInternal(
 				const EBlockChainStatus added = m_pBlockChainServer->AddCompactBlock(compactBlock);
 				if (added == EBlockChainStatus::SUCCESS)
 				{
+					m_blockResponseCache.AddPayload(CompactBlockMsg, compactBlock.GetHash(), rawMessage.GetPayload());
+
 					const HeaderMessage headerMessage(compactBlock.GetBlockHeader());
 					m_connectionManager.BroadcastMessage(headerMessage, connectionId);
 					return EStatus::SUCCESS;
@@ -2,6 +2,7 @@
 
 #include "Messages/RawMessage.h"
 #include "Seed/PeerManager.h"
+#include "BlockResponseCache.h"
 
 #include <BlockChain/BlockChainServer.h>
 #include <P2P/ConnectedPeer.h>
@@ -52,4 +53,5 @@ private:
 	IBlockChainServerPtr m_pBlockChainServer;
 	std::shared_ptr<Pipeline> m_pPipeline;
 	SyncStatusConstPtr m_pSyncStatus;
+	BlockResponseCache m_blockResponseCache;
 };
\ No newline at end of file
@@ -11,7 +11,12 @@ public:
 	// Constructors
 	//
 	BlockMessage(FullBlock&& block)
-		: m_block(std::move(block))
+		: m_pBlock(std::make_shared<const FullBlock>(std::move(block)))
+	{
+
+	}
+	BlockMessage(const FullBlock::CPtr& pBlock)
+		: m_pBlock(pBlock)
 	{
 
 	}
@@ -38,7 +43,12 @@ public:
 	// Getters
 	//
 	virtual MessageTypes::EMessageType GetMessageType() const override final { return MessageTypes::Block; }
-	const FullBlock& GetBlock() const { return m_block; }
+	const FullBlock& GetBlock() const { return *m_pBlock; }
+
+	//
+	// Returns the shared block, so it can be handed to the pipeline and block chain without copying it.
+	//
+	const FullBlock::CPtr& GetBlockPtr() const { return m_pBlock; }
 
 	//
 	// Deserialization
@@ -52,9 +62,9 @@ public:
 protected:
 	virtual void SerializeBody(Serializer& serializer) const override final
 	{
-		m_block.Serialize(serializer);
+		m_pBlock->Serialize(serializer);
 	}
 
 private:
-	FullBlock m_block;
+	FullBlock::CPtr m_pBlock;
 };
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Message.h"
+
+#include <memory>
+#include <vector>
+
+//
+// A message whose body was serialized once up front, so it can be sent to any number of peers without re-serializing.
+// Copies share the same underlying bytes.
+//
+class SerializedMessage : public IMessage
+{
+public:
+	//
+	// Constructors
+	//
+	SerializedMessage(const MessageTypes::EMessageType messageType, std::vector<unsigned char>&& body)
+		: m_messageType(messageType), m_pBody(std::make_shared<const std::vector<unsigned char>>(std::move(body)))
+	{
+
+	}
+	SerializedMessage(const SerializedMessage& other) = default;
+	SerializedMessage(SerializedMessage&& other) noexcept = default;
+
+	//
+	// Destructor
+	//
+	virtual ~SerializedMessage() = default;
+
+	//
+	// Operators
+	//
+	SerializedMessage& operator=(const SerializedMessage& other) = default;
+	SerializedMessage& operator=(SerializedMessage&& other) noexcept = default;
+
+	//
+	// Clone
+	//
+	virtual IMessagePtr Clone() const override final { return IMessagePtr(new SerializedMessage(*this)); }
+
+	//
+	// Getters
+	//
+	virtual MessageTypes::EMessageType GetMessageType() const override final { return m_messageType; }
+	size_t GetBodySize() const { return m_pBody->size(); }
+
+	//
+	// Serializes the given message's body, so it can be sent repeatedly.
+	//
+	static SerializedMessage FromMessage(const IMessage& message)
+	{
+		Serializer serializer;
+		message.SerializeBody(serializer);
+		return SerializedMessage(message.GetMessageType(), std::vector<unsigned char>(serializer.GetBytes()));
+	}
+
+protected:
+	virtual void SerializeBody(Serializer& serializer) const override final
+	{
+		serializer.AppendByteVector(*m_pBody);
+	}
+
+private:
+	MessageTypes::EMessageType m_messageType;
+	std::shared_ptr<const std::vector<unsigned char>> m_pBody;
+};
\ No newline at end of file
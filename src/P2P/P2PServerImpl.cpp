@@ -61,7 +61,8 @@ std::shared_ptr<P2PServer> P2PServer::Create(
 		config,
 		pConnectionManager,
 		pBlockChainServer,
-		pSyncStatus
+		pSyncStatus,
+		pContext->GetTaskPool()
 	);
 
 	// Seeder
@@ -76,6 +77,7 @@ std::shared_ptr<P2PServer> P2PServer::Create(
 
 	// Syncer
 	std::shared_ptr<Syncer> pSyncer = Syncer::Create(
+		config,
 		pConnectionManager,
 		pBlockChainServer,
 		pPipeline,
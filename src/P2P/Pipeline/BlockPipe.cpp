@@ -2,13 +2,19 @@
 #include "../Messages/TransactionKernelMessage.h"
 #include "../ConnectionManager.h"
 
-#include <Common/Util/ThreadUtil.h>
-#include <Infrastructure/ThreadManager.h>
 #include <Infrastructure/Logger.h>
 #include <BlockChain/BlockChainServer.h>
 
-BlockPipe::BlockPipe(const Config& config, IBlockChainServerPtr pBlockChainServer)
-	: m_config(config), m_pBlockChainServer(pBlockChainServer), m_terminate(false)
+// Enough to cover every block in flight, plus the hedged copies.
+static const size_t MAX_RECEIPTS = 4096;
+
+BlockPipe::BlockPipe(const Config& config, IBlockChainServerPtr pBlockChainServer, const TaskPool::Ptr& pTaskPool)
+	: m_config(config),
+	m_pBlockChainServer(pBlockChainServer),
+	m_pLoopGroup(pTaskPool->CreateGroup("BLOCK_PIPE_LOOP", 2)),
+	m_pVerifyGroup(pTaskPool->CreateGroup("BLOCK_PIPE_VERIFY", pTaskPool->GetNumThreads())),
+	m_queuedBytes(0),
+	m_terminate(false)
 {
 }
 
@@ -16,104 +22,158 @@ BlockPipe::~BlockPipe()
 {
 	m_terminate = true;
 
-	ThreadUtil::Join(m_blockThread);
-	ThreadUtil::Join(m_processThread);
+	m_pLoopGroup->Cancel();
+	m_pLoopGroup->Wait();
+	m_pVerifyGroup->Cancel();
+	m_pVerifyGroup->Wait();
 }
 
-std::shared_ptr<BlockPipe> BlockPipe::Create(const Config& config, IBlockChainServerPtr pBlockChainServer)
+std::shared_ptr<BlockPipe> BlockPipe::Create(const Config& config, IBlockChainServerPtr pBlockChainServer, const TaskPool::Ptr& pTaskPool)
 {
-	std::shared_ptr<BlockPipe> pBlockPipe = std::shared_ptr<BlockPipe>(new BlockPipe(config, pBlockChainServer));
-	pBlockPipe->m_blockThread = std::thread(Thread_ProcessNewBlocks, std::ref(*pBlockPipe.get()));
-	pBlockPipe->m_processThread = std::thread(Thread_PostProcessBlocks, std::ref(*pBlockPipe.get()));
+	std::shared_ptr<BlockPipe> pBlockPipe = std::shared_ptr<BlockPipe>(new BlockPipe(config, pBlockChainServer, pTaskPool));
+
+	BlockPipe* pPipeline = pBlockPipe.get();
+	pBlockPipe->m_pLoopGroup->Post(ETaskPriority::HIGH, [pPipeline] { pPipeline->Task_ProcessNewBlocks(); });
+	pBlockPipe->m_pLoopGroup->Post(ETaskPriority::NORMAL, [pPipeline] { pPipeline->Task_PostProcessBlocks(); });
 
 	return pBlockPipe;
 }
 
-void BlockPipe::Thread_ProcessNewBlocks(BlockPipe& pipeline)
+//
+// Applies the block at the front of the queue, then reschedules itself.
+// Blocks are applied one at a time, since they're serialized by the chain lock anyway, while the verify group
+// checks the blocks queued behind them in parallel. The destructor cancels and waits on the loop group, so 'this' outlives every tick.
+//
+void BlockPipe::Task_ProcessNewBlocks()
 {
-	ThreadManagerAPI::SetCurrentThreadName("BLOCK_PREPROCESS_PIPE");
-	LOG_TRACE("BEGIN");
-
-	while (!pipeline.m_terminate)
+	if (m_terminate)
 	{
-		std::vector<BlockEntry> blocksToProcess = pipeline.m_blocksToProcess.copy_front(8); // TODO: Use number of CPU threads.
-		if (!blocksToProcess.empty())
-		{
-			if (blocksToProcess.size() == 1)
-			{
-				ProcessNewBlock(pipeline, blocksToProcess.front());
-			}
-			else
-			{
-				std::vector<std::thread> tasks;
-				for (const BlockEntry& blockEntry : blocksToProcess)
-				{
-					tasks.push_back(std::thread([&pipeline, blockEntry] { ProcessNewBlock(pipeline, blockEntry); }));
-				}
-
-				ThreadUtil::JoinAll(tasks);
-			}
-
-			pipeline.m_blocksToProcess.pop_front(blocksToProcess.size());
-		}
-		else
-		{
-			ThreadUtil::SleepFor(std::chrono::milliseconds(5), pipeline.m_terminate);
-		}
+		return;
 	}
 
-	LOG_TRACE("END");
+	std::vector<BlockEntry> blocksToProcess = m_blocksToProcess.copy_front(1);
+	if (!blocksToProcess.empty())
+	{
+		const BlockEntry& blockEntry = blocksToProcess.front();
+		ProcessNewBlock(blockEntry);
+
+		m_blocksToProcess.pop_front(1);
+		m_queuedBytes -= blockEntry.m_numBytes;
+		m_pLoopGroup->Post(ETaskPriority::HIGH, [this] { Task_ProcessNewBlocks(); });
+	}
+	else
+	{
+		m_pLoopGroup->PostAfter(std::chrono::milliseconds(5), ETaskPriority::HIGH, [this] { Task_ProcessNewBlocks(); });
+	}
 }
 
-void BlockPipe::ProcessNewBlock(BlockPipe& pipeline, const BlockEntry& blockEntry)
+void BlockPipe::ProcessNewBlock(const BlockEntry& blockEntry)
 {
+	const FullBlock& block = *blockEntry.m_pBlock;
+
 	try
 	{
-		const EBlockChainStatus status = pipeline.m_pBlockChainServer->AddBlock(blockEntry.m_block);
+		// Usually finished by now. If not, the pool runs other verification tasks while we wait.
+		if (!m_pVerifyGroup->Await(*blockEntry.m_pVerified))
+		{
+			blockEntry.m_peer->Ban(EBanReason::BadBlock);
+			return;
+		}
+
+		// The block was marked as validated, so only the contextual checks remain.
+		const EBlockChainStatus status = m_pBlockChainServer->AddBlock(blockEntry.m_pBlock, blockEntry.m_peer->GetIPAddress().Format());
 		if (status == EBlockChainStatus::INVALID)
 		{
 			blockEntry.m_peer->Ban(EBanReason::BadBlock);
 		}
 	}
+	catch (std::future_error&)
+	{
+		// Verification was discarded because the pipe is shutting down.
+	}
 	catch (std::exception& e)
 	{
-		LOG_ERROR_F("Exception ({}) caught while attempting to add block {}.", e.what(), blockEntry.m_block);
+		LOG_ERROR_F("Exception ({}) caught while attempting to add block {}.", e.what(), block);
 		blockEntry.m_peer->Ban(EBanReason::BadBlock);
 	}
 }
 
-void BlockPipe::Thread_PostProcessBlocks(BlockPipe& pipeline)
+void BlockPipe::Task_PostProcessBlocks()
+{
+	if (m_terminate)
+	{
+		return;
+	}
+
+	if (m_pBlockChainServer->ProcessNextOrphanBlock())
+	{
+		m_pLoopGroup->Post(ETaskPriority::NORMAL, [this] { Task_PostProcessBlocks(); });
+	}
+	else
+	{
+		m_pLoopGroup->PostAfter(std::chrono::milliseconds(5), ETaskPriority::NORMAL, [this] { Task_PostProcessBlocks(); });
+	}
+}
+
+bool BlockPipe::AddBlockToProcess(PeerPtr pPeer, const FullBlock::CPtr& pBlock, const uint64_t numBytes)
 {
-	ThreadManagerAPI::SetCurrentThreadName("BLOCK_POSTPROCESS_PIPE");
-	LOG_TRACE("BEGIN");
+	const FullBlock& block = *pBlock;
 
-	while (!pipeline.m_terminate)
 	{
-		if (!pipeline.m_pBlockChainServer->ProcessNextOrphanBlock())
+		std::unique_lock<std::mutex> lock(m_receiptsMutex);
+		m_receipts.push_back(Receipt{ block.GetHash(), pPeer->GetIPAddress(), numBytes, std::chrono::steady_clock::now() });
+		if (m_receipts.size() > MAX_RECEIPTS)
 		{
-			ThreadUtil::SleepFor(std::chrono::milliseconds(5), pipeline.m_terminate);
+			m_receipts.pop_front();
 		}
 	}
 
-	LOG_TRACE("END");
-}
+	if (IsProcessingBlock(block.GetHash()))
+	{
+		return false;
+	}
 
-bool BlockPipe::AddBlockToProcess(PeerPtr pPeer, const FullBlock& block)
-{
 	std::function<bool(const BlockEntry&, const BlockEntry&)> comparator = [](const BlockEntry& blockEntry1, const BlockEntry& blockEntry2)
 	{
-		return blockEntry1.m_block.GetHash() == blockEntry2.m_block.GetHash();
+		return blockEntry1.m_pBlock->GetHash() == blockEntry2.m_pBlock->GetHash();
 	};
 
-	return m_blocksToProcess.push_back_unique(BlockEntry(pPeer, block), comparator);
+	// Start verifying right away, so it overlaps with the blocks ahead of it being applied.
+	auto pVerified = std::make_shared<std::future<bool>>(m_pVerifyGroup->Submit(
+		ETaskPriority::HIGH,
+		[this, pBlock] { return m_pBlockChainServer->VerifyBlock(*pBlock); }
+	));
+
+	// Count the bytes before queueing, so the processing task never subtracts more than was added.
+	m_queuedBytes += numBytes;
+	if (!m_blocksToProcess.push_back_unique(BlockEntry(pPeer, pBlock, numBytes, pVerified), comparator))
+	{
+		m_queuedBytes -= numBytes;
+		return false;
+	}
+
+	return true;
 }
 
 bool BlockPipe::IsProcessingBlock(const Hash& hash) const
 {
 	std::function<bool(const BlockEntry&, const Hash&)> comparator = [](const BlockEntry& blockEntry, const Hash& hash)
 	{
-		return blockEntry.m_block.GetHash() == hash;
+		return blockEntry.m_pBlock->GetHash() == hash;
 	};
 
 	return m_blocksToProcess.contains<Hash>(hash, comparator);
+}
+
+std::vector<BlockPipe::Receipt> BlockPipe::GetReceiptsSince(const std::chrono::steady_clock::time_point& time) const
+{
+	std::unique_lock<std::mutex> lock(m_receiptsMutex);
+
+	auto iter = m_receipts.cend();
+	while (iter != m_receipts.cbegin() && std::prev(iter)->receivedTime > time)
+	{
+		iter--;
+	}
+
+	return std::vector<Receipt>(iter, m_receipts.cend());
 }
\ No newline at end of file
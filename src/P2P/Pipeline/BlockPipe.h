@@ -5,10 +5,14 @@
 #include <Core/Models/FullBlock.h>
 #include <BlockChain/BlockChainServer.h>
 #include <Common/ConcurrentQueue.h>
+#include <Common/TaskPool.h>
 #include <string>
 #include <cstdint>
 #include <atomic>
-#include <thread>
+#include <chrono>
+#include <deque>
+#include <future>
+#include <mutex>
 
 // Forward Declarations
 class Config;
@@ -20,40 +24,77 @@ class BlockPipe
 public:
 	static std::shared_ptr<BlockPipe> Create(
 		const Config& config,
-		IBlockChainServerPtr pBlockChainServer
+		IBlockChainServerPtr pBlockChainServer,
+		const TaskPool::Ptr& pTaskPool
 	);
 	~BlockPipe();
 
-	bool AddBlockToProcess(PeerPtr pPeer, const FullBlock& block);
+	//
+	// Queues the block for validation, and records a receipt so the BlockSyncer can measure the peer that sent it.
+	// numBytes is the size of the block message on the wire.
+	// The block is shared with the verification task and the block chain, not copied.
+	//
+	bool AddBlockToProcess(PeerPtr pPeer, const FullBlock::CPtr& pBlock, const uint64_t numBytes);
 	bool IsProcessingBlock(const Hash& hash) const;
 
+	//
+	// Returns the total size of the blocks waiting to be validated.
+	//
+	uint64_t GetQueuedBytes() const { return m_queuedBytes; }
+
+	struct Receipt
+	{
+		Hash blockHash;
+		IPAddress peerAddress;
+		uint64_t numBytes;
+		std::chrono::steady_clock::time_point receivedTime;
+	};
+
+	//
+	// Returns the receipts of all blocks received after the given time, oldest first.
+	// The same block can appear more than once when it was requested from multiple peers.
+	//
+	std::vector<Receipt> GetReceiptsSince(const std::chrono::steady_clock::time_point& time) const;
+
 private:
-	BlockPipe(const Config& config, IBlockChainServerPtr pBlockChainServer);
+	BlockPipe(const Config& config, IBlockChainServerPtr pBlockChainServer, const TaskPool::Ptr& pTaskPool);
 
 	const Config& m_config;
 	IBlockChainServerPtr m_pBlockChainServer;
 
+	// Runs the two pipeline loops below, one tick at a time.
+	TaskGroup::Ptr m_pLoopGroup;
+
+	// Verifies the bodies (rangeproofs, kernel signatures, etc) of queued blocks in parallel, ahead of them being applied.
+	TaskGroup::Ptr m_pVerifyGroup;
+
 	struct BlockEntry
 	{
-		BlockEntry(PeerPtr pPeer, const FullBlock& fullBlock)
-			: m_peer(pPeer), m_block(fullBlock)
+		BlockEntry(PeerPtr pPeer, const FullBlock::CPtr& pBlock, const uint64_t numBytes, const std::shared_ptr<std::future<bool>>& pVerified)
+			: m_peer(pPeer), m_pBlock(pBlock), m_numBytes(numBytes), m_pVerified(pVerified)
 		{
 
 		}
 
 		PeerPtr m_peer;
-		FullBlock m_block;
+		FullBlock::CPtr m_pBlock;
+		uint64_t m_numBytes;
+
+		// Result of the lookahead verification, which starts as soon as the block is queued.
+		std::shared_ptr<std::future<bool>> m_pVerified;
 	};
 
-	// Pre-Process New Blocks
-	static void Thread_ProcessNewBlocks(BlockPipe& pipeline);
-	static void ProcessNewBlock(BlockPipe& pipeline, const BlockEntry& blockEntry);
-	std::thread m_blockThread;
+	// Process New Blocks
+	void Task_ProcessNewBlocks();
+	void ProcessNewBlock(const BlockEntry& blockEntry);
 	ConcurrentQueue<BlockEntry> m_blocksToProcess;
+	std::atomic<uint64_t> m_queuedBytes;
+
+	mutable std::mutex m_receiptsMutex;
+	std::deque<Receipt> m_receipts;
 
 	// Process Next Block
-	std::thread m_processThread;
-	static void Thread_PostProcessBlocks(BlockPipe& pipeline);
+	void Task_PostProcessBlocks();
 
 	std::atomic_bool m_terminate;
 };
\ No newline at end of file
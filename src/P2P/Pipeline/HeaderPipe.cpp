@@ -0,0 +1,274 @@
+#include "HeaderPipe.h"
+
+#include <PoW/PoWManager.h>
+#include <Infrastructure/Logger.h>
+#include <algorithm>
+
+// Limits the memory used by headers that are waiting on their predecessors.
+static const size_t MAX_QUEUED_BATCHES = 32;
+static const size_t MAX_RECEIPTS = 64;
+static const size_t MAX_EXPECTATIONS = 64;
+static const auto BATCH_EXPIRATION = std::chrono::minutes(2);
+static const auto EXPECTATION_EXPIRATION = std::chrono::minutes(1);
+
+HeaderPipe::HeaderPipe(const Config& config, IBlockChainServerPtr pBlockChainServer, const TaskPool::Ptr& pTaskPool)
+	: m_config(config),
+	m_pBlockChainServer(pBlockChainServer),
+	m_pTaskGroup(pTaskPool->CreateGroup("HEADER_PIPE", 1)),
+	m_processing(false)
+{
+
+}
+
+HeaderPipe::~HeaderPipe()
+{
+	m_pTaskGroup->Cancel();
+	m_pTaskGroup->Wait();
+}
+
+std::shared_ptr<HeaderPipe> HeaderPipe::Create(const Config& config, IBlockChainServerPtr pBlockChainServer, const TaskPool::Ptr& pTaskPool)
+{
+	return std::shared_ptr<HeaderPipe>(new HeaderPipe(config, pBlockChainServer, pTaskPool));
+}
+
+void HeaderPipe::ExpectHeaders(const PeerPtr& pPeer, const std::vector<Hash>& locators)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	m_expectations.push_back(Expectation{ pPeer->GetIPAddress(), locators, std::chrono::steady_clock::now() });
+	if (m_expectations.size() > MAX_EXPECTATIONS)
+	{
+		m_expectations.pop_front();
+	}
+}
+
+bool HeaderPipe::AddHeadersToProcess(PeerPtr pPeer, std::vector<BlockHeaderPtr>&& headers)
+{
+	if (headers.empty())
+	{
+		return true;
+	}
+
+	for (size_t i = 1; i < headers.size(); i++)
+	{
+		if (headers[i]->GetPreviousHash() != headers[i - 1]->GetHash())
+		{
+			LOG_WARNING_F("Headers from {} are not sorted.", pPeer);
+			return false;
+		}
+	}
+
+	const Hash& anchorHash = headers.front()->GetPreviousHash();
+	const Hash& lastHash = headers.back()->GetHash();
+
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (!ConsumeExpectation(pPeer->GetIPAddress(), anchorHash))
+		{
+			LOG_DEBUG_F("Ignoring unrequested headers {} to {} from {}.", *headers.front(), *headers.back(), pPeer);
+			return true;
+		}
+	}
+
+	// Only the cycles are checked here. Difficulty and everything else needs chain state, so it's checked when processed.
+	for (const BlockHeaderPtr& pHeader : headers)
+	{
+		if (!PoWManager::IsProofValid(m_config, *pHeader))
+		{
+			LOG_WARNING_F("Header {} from {} has an invalid proof of work.", *pHeader, pPeer);
+			return false;
+		}
+	}
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	auto iter = std::find_if(
+		m_batches.cbegin(),
+		m_batches.cend(),
+		[&anchorHash, &lastHash](const Batch& batch) {
+			return batch.headers.front()->GetPreviousHash() == anchorHash && batch.headers.back()->GetHash() == lastHash;
+		}
+	);
+	if (iter != m_batches.cend())
+	{
+		LOG_DEBUG_F("Headers {} to {} already queued.", *headers.front(), *headers.back());
+		return true;
+	}
+
+	if (m_batches.size() >= MAX_QUEUED_BATCHES)
+	{
+		LOG_DEBUG_F("Header queue full. Dropping headers from {}.", pPeer);
+		return true;
+	}
+
+	const auto now = std::chrono::steady_clock::now();
+	m_receipts.push_back(Receipt{ anchorHash, lastHash, headers.back()->GetHeight(), pPeer->GetIPAddress(), now });
+	if (m_receipts.size() > MAX_RECEIPTS)
+	{
+		m_receipts.pop_front();
+	}
+
+	m_batches.push_back(Batch{ pPeer, std::move(headers), now });
+
+	if (!m_processing)
+	{
+		m_processing = true;
+		m_pTaskGroup->Post(ETaskPriority::HIGH, [this] { Task_ProcessHeaders(); });
+	}
+
+	return true;
+}
+
+std::pair<Hash, uint64_t> HeaderPipe::GetFrontier(const BlockHeader& tipHeader) const
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	Hash frontierHash = tipHeader.GetHash();
+	uint64_t frontierHeight = tipHeader.GetHeight();
+
+	bool extended = true;
+	while (extended)
+	{
+		extended = false;
+		for (auto iter = m_receipts.crbegin(); iter != m_receipts.crend(); iter++)
+		{
+			if (iter->anchorHash == frontierHash && iter->lastHeight > frontierHeight)
+			{
+				frontierHash = iter->lastHash;
+				frontierHeight = iter->lastHeight;
+				extended = true;
+				break;
+			}
+		}
+	}
+
+	return std::make_pair(frontierHash, frontierHeight);
+}
+
+std::unique_ptr<HeaderPipe::Receipt> HeaderPipe::GetReceipt(const Hash& anchorHash) const
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	for (auto iter = m_receipts.crbegin(); iter != m_receipts.crend(); iter++)
+	{
+		if (iter->anchorHash == anchorHash)
+		{
+			return std::make_unique<Receipt>(*iter);
+		}
+	}
+
+	return nullptr;
+}
+
+//
+// Processes batches until none are left whose anchor is known.
+// Batches that are still waiting on their predecessor are picked up by the task that processes that predecessor.
+//
+void HeaderPipe::Task_ProcessHeaders()
+{
+	std::unique_ptr<Batch> pBatch = PopReadyBatch();
+	while (pBatch != nullptr)
+	{
+		LOG_DEBUG_F("Processing headers {} to {} from {}", *pBatch->headers.front(), *pBatch->headers.back(), pBatch->pPeer);
+
+		const EBlockChainStatus status = m_pBlockChainServer->AddBlockHeaders(pBatch->headers);
+		if (status != EBlockChainStatus::SUCCESS && status != EBlockChainStatus::ALREADY_EXISTS)
+		{
+			// The frontier must not keep following headers that weren't added.
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				DropReceipt(*pBatch);
+			}
+
+			if (status == EBlockChainStatus::INVALID)
+			{
+				LOG_WARNING_F("Banning peer {} for sending invalid headers.", pBatch->pPeer);
+				pBatch->pPeer->Ban(EBanReason::BadBlockHeader);
+			}
+		}
+
+		if (m_pTaskGroup->IsCancelled())
+		{
+			return;
+		}
+
+		pBatch = PopReadyBatch();
+	}
+}
+
+std::unique_ptr<HeaderPipe::Batch> HeaderPipe::PopReadyBatch()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	const auto now = std::chrono::steady_clock::now();
+	auto expired = std::stable_partition(
+		m_batches.begin(),
+		m_batches.end(),
+		[&now](const Batch& batch) { return batch.receivedTime + BATCH_EXPIRATION >= now; }
+	);
+	for (auto iter = expired; iter != m_batches.end(); iter++)
+	{
+		DropReceipt(*iter);
+	}
+	m_batches.erase(expired, m_batches.end());
+
+	// Lowest batches first, so a fork batch never gets processed ahead of the batches it builds on.
+	std::sort(
+		m_batches.begin(),
+		m_batches.end(),
+		[](const Batch& lhs, const Batch& rhs) { return lhs.headers.front()->GetHeight() < rhs.headers.front()->GetHeight(); }
+	);
+
+	for (auto iter = m_batches.begin(); iter != m_batches.end(); iter++)
+	{
+		if (m_pBlockChainServer->GetBlockHeaderByHash(iter->headers.front()->GetPreviousHash()) != nullptr)
+		{
+			auto pBatch = std::make_unique<Batch>(std::move(*iter));
+			m_batches.erase(iter);
+			return pBatch;
+		}
+	}
+
+	m_processing = false;
+	return nullptr;
+}
+
+bool HeaderPipe::ConsumeExpectation(const IPAddress& peerAddress, const Hash& anchorHash)
+{
+	const auto now = std::chrono::steady_clock::now();
+	while (!m_expectations.empty() && m_expectations.front().sentTime + EXPECTATION_EXPIRATION < now)
+	{
+		m_expectations.pop_front();
+	}
+
+	auto iter = std::find_if(
+		m_expectations.begin(),
+		m_expectations.end(),
+		[&peerAddress, &anchorHash](const Expectation& expectation) {
+			return expectation.peerAddress == peerAddress
+				&& std::find(expectation.locators.cbegin(), expectation.locators.cend(), anchorHash) != expectation.locators.cend();
+		}
+	);
+	if (iter == m_expectations.end())
+	{
+		return false;
+	}
+
+	// Each request is answered by one batch.
+	m_expectations.erase(iter);
+	return true;
+}
+
+void HeaderPipe::DropReceipt(const Batch& batch)
+{
+	const Hash& anchorHash = batch.headers.front()->GetPreviousHash();
+	const Hash& lastHash = batch.headers.back()->GetHash();
+	m_receipts.erase(
+		std::remove_if(
+			m_receipts.begin(),
+			m_receipts.end(),
+			[&anchorHash, &lastHash](const Receipt& receipt) { return receipt.anchorHash == anchorHash && receipt.lastHash == lastHash; }
+		),
+		m_receipts.end()
+	);
+}
\ No newline at end of file
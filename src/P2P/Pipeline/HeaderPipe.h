@@ -0,0 +1,101 @@
+#pragma once
+
+#include <Crypto/Hash.h>
+#include <P2P/Peer.h>
+#include <Core/Models/BlockHeader.h>
+#include <BlockChain/BlockChainServer.h>
+#include <Common/TaskPool.h>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+// Forward Declarations
+class Config;
+
+//
+// Reassembles batches of headers received from different peers, and feeds them to the chain in order.
+//
+// Batches are keyed by their anchor (the previous hash of their first header). A batch is only processed once
+// its anchor header is known to the chain, so batches that arrive out of order simply wait for their predecessor.
+// Processing runs as a single task on the pool, so peer connections never block on header validation.
+//
+// Only batches answering an outstanding request (see ExpectHeaders) are queued, one per request, and only after
+// the cuckoo cycle of every header is checked. Receipts of batches that fail validation or expire are dropped,
+// so the frontier never follows headers that turned out to be invalid.
+//
+class HeaderPipe
+{
+public:
+	static std::shared_ptr<HeaderPipe> Create(
+		const Config& config,
+		IBlockChainServerPtr pBlockChainServer,
+		const TaskPool::Ptr& pTaskPool
+	);
+	~HeaderPipe();
+
+	//
+	// Records a GetHeaders request sent to the peer, so a batch anchored at one of its locators will be accepted.
+	//
+	void ExpectHeaders(const PeerPtr& pPeer, const std::vector<Hash>& locators);
+
+	//
+	// Queues the headers for processing, if they answer an outstanding request from the peer.
+	// Unsolicited or duplicate batches are ignored. The peer will be banned if the headers turn out to be invalid.
+	// Returns false if the peer should be banned, because the headers are not sorted or have an invalid proof of work.
+	//
+	bool AddHeadersToProcess(PeerPtr pPeer, std::vector<BlockHeaderPtr>&& headers);
+
+	struct Receipt
+	{
+		Hash anchorHash;
+		Hash lastHash;
+		uint64_t lastHeight;
+		IPAddress peerAddress;
+		std::chrono::steady_clock::time_point receivedTime;
+	};
+
+	//
+	// Follows recently received batches, starting at the given header, and returns the hash & height
+	// of the last header known to extend it (whether or not that header has been processed yet).
+	// Only batches whose proofs of work were checked, and which haven't failed validation, are followed.
+	//
+	std::pair<Hash, uint64_t> GetFrontier(const BlockHeader& tipHeader) const;
+
+	//
+	// Returns the receipt for the most recently received batch with the given anchor, if there is one.
+	//
+	std::unique_ptr<Receipt> GetReceipt(const Hash& anchorHash) const;
+
+private:
+	HeaderPipe(const Config& config, IBlockChainServerPtr pBlockChainServer, const TaskPool::Ptr& pTaskPool);
+
+	struct Batch
+	{
+		PeerPtr pPeer;
+		std::vector<BlockHeaderPtr> headers;
+		std::chrono::steady_clock::time_point receivedTime;
+	};
+
+	struct Expectation
+	{
+		IPAddress peerAddress;
+		std::vector<Hash> locators;
+		std::chrono::steady_clock::time_point sentTime;
+	};
+
+	void Task_ProcessHeaders();
+	std::unique_ptr<Batch> PopReadyBatch();
+	bool ConsumeExpectation(const IPAddress& peerAddress, const Hash& anchorHash);
+	void DropReceipt(const Batch& batch);
+
+	const Config& m_config;
+	IBlockChainServerPtr m_pBlockChainServer;
+	TaskGroup::Ptr m_pTaskGroup;
+
+	mutable std::mutex m_mutex;
+	std::vector<Batch> m_batches;
+	std::deque<Receipt> m_receipts;
+	std::deque<Expectation> m_expectations;
+	bool m_processing;
+};
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "../ConnectionManager.h"
 #include "BlockPipe.h"
+#include "HeaderPipe.h"
 #include "TransactionPipe.h"
 #include "TxHashSetPipe.h"
 
@@ -16,31 +17,37 @@ public:
 		const Config& config,
 		ConnectionManagerPtr pConnectionManager,
 		IBlockChainServerPtr pBlockChainServer,
-		SyncStatusPtr pSyncStatus)
+		SyncStatusPtr pSyncStatus,
+		const TaskPool::Ptr& pTaskPool)
 	{
-		std::shared_ptr<BlockPipe> pBlockPipe = BlockPipe::Create(config, pBlockChainServer);
+		std::shared_ptr<HeaderPipe> pHeaderPipe = HeaderPipe::Create(config, pBlockChainServer, pTaskPool);
+		std::shared_ptr<BlockPipe> pBlockPipe = BlockPipe::Create(config, pBlockChainServer, pTaskPool);
 		std::shared_ptr<TransactionPipe> pTransactionPipe = TransactionPipe::Create(config, pConnectionManager, pBlockChainServer);
 		std::shared_ptr<TxHashSetPipe> pTxHashSetPipe = TxHashSetPipe::Create(config, pBlockChainServer, pSyncStatus);
 
-		return std::shared_ptr<Pipeline>(new Pipeline(pBlockPipe, pTransactionPipe, pTxHashSetPipe));
+		return std::shared_ptr<Pipeline>(new Pipeline(pHeaderPipe, pBlockPipe, pTransactionPipe, pTxHashSetPipe));
 	}
 
+	std::shared_ptr<HeaderPipe> GetHeaderPipe() { return m_pHeaderPipe; }
 	std::shared_ptr<BlockPipe> GetBlockPipe() { return m_pBlockPipe; }
 	std::shared_ptr<TransactionPipe> GetTransactionPipe() { return m_pTransactionPipe; }
 	std::shared_ptr<TxHashSetPipe> GetTxHashSetPipe() { return m_pTxHashSetPipe; }
 
 private:
 	Pipeline(
+		std::shared_ptr<HeaderPipe> pHeaderPipe,
 		std::shared_ptr<BlockPipe> pBlockPipe,
 		std::shared_ptr<TransactionPipe> pTransactionPipe,
 		std::shared_ptr<TxHashSetPipe> pTxHashSetPipe)
-		: m_pBlockPipe(pBlockPipe),
+		: m_pHeaderPipe(pHeaderPipe),
+		m_pBlockPipe(pBlockPipe),
 		m_pTransactionPipe(pTransactionPipe),
 		m_pTxHashSetPipe(pTxHashSetPipe)
 	{
 
 	}
 
+	std::shared_ptr<HeaderPipe> m_pHeaderPipe;
 	std::shared_ptr<BlockPipe> m_pBlockPipe;
 	std::shared_ptr<TransactionPipe> m_pTransactionPipe;
 	std::shared_ptr<TxHashSetPipe> m_pTxHashSetPipe;
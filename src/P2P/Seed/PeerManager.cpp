@@ -5,7 +5,6 @@
 #include <Common/Util/ThreadUtil.h>
 #include <Config/Config.h>
 #include <Infrastructure/Logger.h>
-#include <Infrastructure/ThreadManager.h>
 #include <Crypto/RandomNumberGenerator.h>
 
 PeerManager::PeerManager(const Context::Ptr& pContext, std::shared_ptr<Locked<IPeerDB>> pPeerDB)
@@ -18,7 +17,7 @@ PeerManager::~PeerManager()
 {
 	LOG_INFO("Shutting down peer manager");
 
-	m_pContext->GetScheduler()->RemoveTask(m_taskId);
+	m_pContext->GetTaskPool()->CancelInterval(m_taskId);
 	Thread_ManagePeers(*this);
 }
 
@@ -36,7 +35,7 @@ std::shared_ptr<Locked<PeerManager>> PeerManager::Create(const Context::Ptr& pCo
 	std::shared_ptr<Locked<PeerManager>> pLocked = std::make_shared<Locked<PeerManager>>(Locked<PeerManager>(pPeerManager));
 
 	std::weak_ptr<Locked<PeerManager>> pLockedWeak(pLocked);
-	const uint64_t taskId = pContext->GetScheduler()->interval(std::chrono::seconds(15), [pLockedWeak]() {
+	const uint64_t taskId = pContext->GetTaskPool()->ScheduleInterval(std::chrono::seconds(15), ETaskPriority::LOW, [pLockedWeak]() {
 		auto pLocked = pLockedWeak.lock();
 		if (pLocked != nullptr)
 		{
@@ -52,7 +51,6 @@ std::shared_ptr<Locked<PeerManager>> PeerManager::Create(const Context::Ptr& pCo
 
 void PeerManager::Thread_ManagePeers(PeerManager& peerManager)
 {
-	ThreadManagerAPI::SetCurrentThreadName("PEER_MANAGER");
 	LOG_TRACE("BEGIN");
 
 	try
@@ -27,6 +27,9 @@ Seeder::Seeder(
 	m_pBlockChainServer(pBlockChainServer),
 	m_pMessageProcessor(pMessageProcessor),
 	m_pSyncStatus(pSyncStatus),
+	m_pConnectGroup(pContext->GetTaskPool()->CreateGroup("PEER_CONNECT", (std::max)(pContext->GetTaskPool()->GetNumThreads() / 4, (size_t)1))),
+	m_pPeerGroup(pContext->GetTaskPool()->CreateGroup("PEERS", (std::max)(pContext->GetTaskPool()->GetNumThreads() / 2, (size_t)2))),
+	m_pTransferGroup(pContext->GetTaskPool()->CreateGroup("TXHASHSET", 1)),
 	m_pAsioContext(std::make_shared<asio::io_context>()),
 	m_terminate(false)
 {
@@ -39,6 +42,13 @@ Seeder::~Seeder()
 	m_terminate = true;
 	ThreadUtil::Join(m_listenerThread);
 	ThreadUtil::Join(m_seedThread);
+
+	m_pConnectGroup->Cancel();
+	m_pConnectGroup->Wait();
+	m_pPeerGroup->Cancel();
+	m_pPeerGroup->Wait();
+	m_pTransferGroup->Cancel();
+	m_pTransferGroup->Wait();
 }
 
 std::unique_ptr<Seeder> Seeder::Create(
@@ -147,7 +157,10 @@ void Seeder::Thread_Listener(Seeder& seeder)
 						seeder.m_pBlockChainServer,
 						ConnectedPeer(pPeer, EDirection::INBOUND, pSocket->GetPort()),
 						seeder.m_pMessageProcessor,
-						seeder.m_pSyncStatus
+						seeder.m_pSyncStatus,
+						seeder.m_pConnectGroup,
+						seeder.m_pPeerGroup,
+						seeder.m_pTransferGroup
 					);
 				}
 			}
@@ -181,7 +194,10 @@ ConnectionPtr Seeder::SeedNewConnection()
 			m_pBlockChainServer,
 			connectedPeer,
 			m_pMessageProcessor,
-			m_pSyncStatus
+			m_pSyncStatus,
+			m_pConnectGroup,
+			m_pPeerGroup,
+			m_pTransferGroup
 		);
 
 		return pConnection;
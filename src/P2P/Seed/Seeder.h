@@ -56,6 +56,15 @@ private:
 
 	std::atomic<bool> m_terminate = true;
 
+	// Connects and handshakes with new peers. These tasks block on the socket, so they get their own, smaller limit.
+	TaskGroup::Ptr m_pConnectGroup;
+
+	// Runs the ticks of all connected peers.
+	TaskGroup::Ptr m_pPeerGroup;
+
+	// Sends and receives TxHashSet archives. Each transfer blocks a worker for minutes, so only one runs at a time.
+	TaskGroup::Ptr m_pTransferGroup;
+
 	std::shared_ptr<asio::io_context> m_pAsioContext;
 	std::thread m_seedThread;
 	std::thread m_listenerThread;
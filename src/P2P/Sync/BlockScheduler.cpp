@@ -0,0 +1,308 @@
+#include "BlockScheduler.h"
+
+#include <Infrastructure/Logger.h>
+#include <algorithm>
+#include <cmath>
+
+// Assumed for peers (and blocks) that haven't been measured yet.
+static const auto DEFAULT_LATENCY = std::chrono::milliseconds(1000);
+static const double DEFAULT_BYTES_PER_SECOND = 128.0 * 1024;
+static const double DEFAULT_BLOCK_SIZE = 32.0 * 1024;
+
+// Floors that keep the delivery estimates finite, no matter how often a peer stalls or how small blocks get.
+static const double MIN_BYTES_PER_SECOND = 1024.0;
+static const double MIN_BLOCK_SIZE = 1.0;
+
+BlockScheduler::BlockScheduler(const SendRequest& sendRequest)
+	: m_sendRequest(sendRequest), m_averageBlockSize(DEFAULT_BLOCK_SIZE)
+{
+
+}
+
+void BlockScheduler::OnBlockReceived(const Hash& blockHash, const IPAddress& peerAddress, const size_t numBytes, const Clock::time_point receivedTime)
+{
+	m_averageBlockSize = (std::max)(((m_averageBlockSize * 7) + numBytes) / 8, MIN_BLOCK_SIZE);
+
+	auto requestIter = std::find_if(
+		m_requests.begin(),
+		m_requests.end(),
+		[&blockHash](const std::pair<const uint64_t, Request>& entry) { return entry.second.blockHash == blockHash; }
+	);
+	if (requestIter == m_requests.end())
+	{
+		return;
+	}
+
+	const std::vector<Attempt>& attempts = requestIter->second.attempts;
+	auto attemptIter = std::find_if(
+		attempts.cbegin(),
+		attempts.cend(),
+		[&peerAddress](const Attempt& attempt) { return attempt.pPeer->GetIPAddress() == peerAddress; }
+	);
+	if (attemptIter != attempts.cend() && attemptIter->sentTime <= receivedTime)
+	{
+		PeerStats& stats = GetStats(peerAddress);
+		if (attemptIter->sentTime >= stats.lastReceived)
+		{
+			const auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(receivedTime - attemptIter->sentTime);
+			stats.latency = (stats.latency * 3 + latency) / 4;
+		}
+		else
+		{
+			const auto transferTime = std::chrono::duration_cast<std::chrono::microseconds>(receivedTime - stats.lastReceived);
+			const double seconds = (std::max)(transferTime.count(), (int64_t)1000) / 1000000.0;
+			stats.bytesPerSecond = (std::max)(((stats.bytesPerSecond * 3) + (numBytes / seconds)) / 4, MIN_BYTES_PER_SECOND);
+		}
+
+		stats.lastReceived = receivedTime;
+		stats.timeouts = 0;
+	}
+
+	CancelAttempts(requestIter->second);
+	m_requests.erase(requestIter);
+}
+
+void BlockScheduler::RemoveRequests(const std::function<bool(const uint64_t, const Hash&)>& isObsolete)
+{
+	auto iter = m_requests.begin();
+	while (iter != m_requests.end())
+	{
+		if (isObsolete(iter->first, iter->second.blockHash))
+		{
+			CancelAttempts(iter->second);
+			iter = m_requests.erase(iter);
+		}
+		else
+		{
+			iter++;
+		}
+	}
+}
+
+void BlockScheduler::ExpireRequests(const std::vector<PeerPtr>& peers, const Clock::time_point now)
+{
+	// A peer with several blocks in flight usually times out on all of them at once, which is still a single stall.
+	std::unordered_map<IPAddress, PeerPtr> timedOutPeers;
+
+	auto iter = m_requests.begin();
+	while (iter != m_requests.end())
+	{
+		Request& request = iter->second;
+
+		auto attemptIter = request.attempts.begin();
+		while (attemptIter != request.attempts.end())
+		{
+			if (attemptIter->sentTime + REQUEST_TIMEOUT < now)
+			{
+				LOG_DEBUG_F("Block request to {} timed out.", attemptIter->pPeer);
+
+				GetStats(attemptIter->pPeer->GetIPAddress()).inFlight--;
+				timedOutPeers.insert({ attemptIter->pPeer->GetIPAddress(), attemptIter->pPeer });
+				attemptIter = request.attempts.erase(attemptIter);
+			}
+			else
+			{
+				attemptIter++;
+			}
+		}
+
+		if (request.attempts.empty())
+		{
+			// Requested again by the BlockSyncer, from whichever peer has room.
+			iter = m_requests.erase(iter);
+			continue;
+		}
+
+		// Only the first attempt can stall; once the block has been re-requested, it's left to the hard timeout.
+		// So each stalled block halves its peer's bandwidth estimate at most once.
+		if (request.attempts.size() < MAX_ATTEMPTS)
+		{
+			const PeerPtr pStalledPeer = request.attempts.back().pPeer;
+			const Clock::time_point sentTime = request.attempts.back().sentTime;
+			if (sentTime + GetStallTimeout(GetStats(pStalledPeer->GetIPAddress())) < now)
+			{
+				if (RequestBlock(iter->first, request.blockHash, peers, now))
+				{
+					LOG_DEBUG_F("Block {} from {} is stalled. Requested from another peer.", iter->first, pStalledPeer);
+
+					PeerStats& stats = GetStats(pStalledPeer->GetIPAddress());
+					stats.bytesPerSecond = (std::max)(stats.bytesPerSecond / 2, MIN_BYTES_PER_SECOND);
+				}
+			}
+		}
+
+		iter++;
+	}
+
+	for (const auto& timedOutPeer : timedOutPeers)
+	{
+		PeerStats& stats = GetStats(timedOutPeer.first);
+		stats.timeouts++;
+		stats.bytesPerSecond = (std::max)(stats.bytesPerSecond / 2, MIN_BYTES_PER_SECOND);
+
+		// The peer claims more work than us, but repeatedly fails to send the blocks.
+		if (stats.timeouts >= 2 && !timedOutPeer.second->IsBanned())
+		{
+			LOG_ERROR_F("Banning peer {} for fraud height.", timedOutPeer.second);
+			timedOutPeer.second->Ban(EBanReason::FraudHeight);
+		}
+	}
+}
+
+bool BlockScheduler::RequestBlock(const uint64_t height, const Hash& blockHash, const std::vector<PeerPtr>& peers, const Clock::time_point now)
+{
+	Request& request = m_requests.insert({ height, Request{ blockHash, {} } }).first->second;
+
+	PeerPtr pBestPeer = nullptr;
+	double bestDelivery = 0.0;
+	for (const PeerPtr& pPeer : peers)
+	{
+		const bool alreadyRequested = std::any_of(
+			request.attempts.cbegin(),
+			request.attempts.cend(),
+			[&pPeer](const Attempt& attempt) { return attempt.pPeer->GetIPAddress() == pPeer->GetIPAddress(); }
+		);
+		if (alreadyRequested)
+		{
+			continue;
+		}
+
+		const PeerStats& stats = GetStats(pPeer->GetIPAddress());
+		if (stats.inFlight >= GetWindow(stats))
+		{
+			continue;
+		}
+
+		const double delivery = GetDeliverySeconds(stats, stats.inFlight + 1);
+		if (pBestPeer == nullptr || delivery < bestDelivery)
+		{
+			pBestPeer = pPeer;
+			bestDelivery = delivery;
+		}
+	}
+
+	if (pBestPeer != nullptr && m_sendRequest(pBestPeer, blockHash))
+	{
+		request.attempts.push_back(Attempt{ pBestPeer, now });
+		GetStats(pBestPeer->GetIPAddress()).inFlight++;
+		return true;
+	}
+
+	if (request.attempts.empty())
+	{
+		m_requests.erase(height);
+	}
+
+	return false;
+}
+
+bool BlockScheduler::IsRequested(const uint64_t height, const Hash& blockHash)
+{
+	auto iter = m_requests.find(height);
+	if (iter == m_requests.end())
+	{
+		return false;
+	}
+
+	if (iter->second.blockHash == blockHash)
+	{
+		return true;
+	}
+
+	// The candidate chain was reorged, so the old request is for the wrong block.
+	CancelAttempts(iter->second);
+	m_requests.erase(iter);
+	return false;
+}
+
+size_t BlockScheduler::GetCapacity(const std::vector<PeerPtr>& peers)
+{
+	size_t capacity = 0;
+	for (const PeerPtr& pPeer : peers)
+	{
+		const PeerStats& stats = GetStats(pPeer->GetIPAddress());
+		const size_t window = GetWindow(stats);
+		capacity += window - (std::min)(stats.inFlight, window);
+	}
+
+	return capacity;
+}
+
+void BlockScheduler::Clear()
+{
+	m_requests.clear();
+	for (auto& stats : m_peerStats)
+	{
+		stats.second.inFlight = 0;
+	}
+}
+
+size_t BlockScheduler::GetNumAttempts(const uint64_t height) const
+{
+	auto iter = m_requests.find(height);
+	return iter != m_requests.end() ? iter->second.attempts.size() : 0;
+}
+
+size_t BlockScheduler::GetWindow(const IPAddress& address)
+{
+	return GetWindow(GetStats(address));
+}
+
+std::chrono::milliseconds BlockScheduler::GetStallTimeout(const IPAddress& address)
+{
+	return GetStallTimeout(GetStats(address));
+}
+
+BlockScheduler::PeerStats& BlockScheduler::GetStats(const IPAddress& address)
+{
+	const PeerStats defaultStats{ DEFAULT_LATENCY, DEFAULT_BYTES_PER_SECOND, Clock::time_point(), 0, 0 };
+	return m_peerStats.insert({ address, defaultStats }).first->second;
+}
+
+//
+// Twice the bandwidth-delay product (in blocks), so the peer's link stays full even when latency jitters.
+//
+size_t BlockScheduler::GetWindow(const PeerStats& stats) const
+{
+	const double bandwidthDelay = (stats.bytesPerSecond * (stats.latency.count() / 1000.0)) / m_averageBlockSize;
+	const double window = std::ceil(bandwidthDelay * 2);
+	if (!std::isfinite(window) || window >= MAX_WINDOW)
+	{
+		return MAX_WINDOW;
+	}
+
+	return (std::max)(MIN_WINDOW, (size_t)(std::max)(window, 0.0));
+}
+
+//
+// Twice the time the peer should need to deliver everything it has in flight, within [MIN_STALL_TIMEOUT, REQUEST_TIMEOUT / 2].
+//
+std::chrono::milliseconds BlockScheduler::GetStallTimeout(const PeerStats& stats) const
+{
+	const double maxSeconds = (REQUEST_TIMEOUT / 2).count() / 1000.0;
+	double seconds = GetDeliverySeconds(stats, stats.inFlight) * 2;
+	if (!std::isfinite(seconds) || seconds > maxSeconds)
+	{
+		seconds = maxSeconds;
+	}
+
+	const auto timeout = std::chrono::milliseconds((int64_t)(seconds * 1000));
+	return (std::max)(MIN_STALL_TIMEOUT, timeout);
+}
+
+//
+// Expected time (in seconds) for the peer to deliver the given number of blocks.
+//
+double BlockScheduler::GetDeliverySeconds(const PeerStats& stats, const size_t numBlocks) const
+{
+	const double bytesPerSecond = (std::max)(stats.bytesPerSecond, MIN_BYTES_PER_SECOND);
+	return (stats.latency.count() / 1000.0) + ((numBlocks * m_averageBlockSize) / bytesPerSecond);
+}
+
+void BlockScheduler::CancelAttempts(const Request& request)
+{
+	for (const Attempt& attempt : request.attempts)
+	{
+		GetStats(attempt.pPeer->GetIPAddress()).inFlight--;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <Crypto/Hash.h>
+#include <Net/IPAddress.h>
+#include <P2P/Peer.h>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <stdint.h>
+
+//
+// Tracks outstanding block requests and per-peer delivery statistics for the BlockSyncer.
+//
+// Each peer gets an in-flight window sized from its measured bandwidth-delay product, so fast peers are kept busy
+// and slow peers aren't handed more blocks than they can deliver. A block that takes much longer than its peer's
+// expected delivery time is re-requested from another peer long before the hard timeout, so stragglers never stall
+// the chain. Peers that hit the hard timeout in two separate passes, without delivering a block in between, are banned.
+//
+// The current time is always passed in, so the scheduler doesn't depend on the clock or the network.
+//
+class BlockScheduler
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	// Sends a request for the block to the peer. Returns false if the request couldn't be sent.
+	using SendRequest = std::function<bool(const PeerPtr&, const Hash&)>;
+
+	// Bounds on the number of blocks a single peer can have in flight.
+	static constexpr size_t MIN_WINDOW = 2;
+	static constexpr size_t MAX_WINDOW = 64;
+
+	// Number of peers that can be asked for the same block at once (the original request plus a re-request).
+	static constexpr size_t MAX_ATTEMPTS = 2;
+
+	static constexpr auto MIN_STALL_TIMEOUT = std::chrono::milliseconds(1000);
+	static constexpr auto REQUEST_TIMEOUT = std::chrono::milliseconds(10000);
+
+	explicit BlockScheduler(const SendRequest& sendRequest);
+
+	//
+	// Credits the peer that delivered the block, and completes its request.
+	// A delivery that started while the peer was idle measures its latency. A delivery that queued behind
+	// another block from the same peer measures its bandwidth, since only the transfer time separates the two.
+	//
+	void OnBlockReceived(const Hash& blockHash, const IPAddress& peerAddress, const size_t numBytes, const Clock::time_point receivedTime);
+
+	//
+	// Removes the requests for which isObsolete returns true (eg. blocks that were already applied).
+	//
+	void RemoveRequests(const std::function<bool(const uint64_t, const Hash&)>& isObsolete);
+
+	//
+	// Drops attempts that hit the hard timeout, and re-requests blocks that are taking much longer than their peer
+	// usually needs from a different peer. A stalled peer has its bandwidth estimate halved once per re-requested block.
+	// Each peer counts at most one timeout per pass, however many of its blocks expired.
+	//
+	void ExpireRequests(const std::vector<PeerPtr>& peers, const Clock::time_point now);
+
+	//
+	// Requests the block from the peer with room in its window that is expected to deliver it soonest,
+	// skipping peers that were already asked for it. Returns false if no peer could take the request.
+	//
+	bool RequestBlock(const uint64_t height, const Hash& blockHash, const std::vector<PeerPtr>& peers, const Clock::time_point now);
+
+	//
+	// Returns true if the block is already requested. A request for a different block at the same height
+	// (ie. the candidate chain was reorged) is cancelled.
+	//
+	bool IsRequested(const uint64_t height, const Hash& blockHash);
+
+	//
+	// Returns the number of blocks the peers can take before their windows are full.
+	//
+	size_t GetCapacity(const std::vector<PeerPtr>& peers);
+
+	void Clear();
+
+	size_t GetNumRequests() const noexcept { return m_requests.size(); }
+	size_t GetNumAttempts(const uint64_t height) const;
+	double GetAverageBlockSize() const noexcept { return m_averageBlockSize; }
+
+	size_t GetWindow(const IPAddress& address);
+	std::chrono::milliseconds GetStallTimeout(const IPAddress& address);
+
+private:
+	struct Attempt
+	{
+		PeerPtr pPeer;
+		Clock::time_point sentTime;
+	};
+
+	struct Request
+	{
+		Hash blockHash;
+		std::vector<Attempt> attempts;
+	};
+
+	struct PeerStats
+	{
+		std::chrono::milliseconds latency;
+		double bytesPerSecond;
+		Clock::time_point lastReceived;
+		size_t inFlight;
+		size_t timeouts;
+	};
+
+	PeerStats& GetStats(const IPAddress& address);
+	size_t GetWindow(const PeerStats& stats) const;
+	std::chrono::milliseconds GetStallTimeout(const PeerStats& stats) const;
+	double GetDeliverySeconds(const PeerStats& stats, const size_t numBlocks) const;
+	void CancelAttempts(const Request& request);
+
+	SendRequest m_sendRequest;
+
+	// Outstanding requests, indexed by block height.
+	std::map<uint64_t, Request> m_requests;
+	std::unordered_map<IPAddress, PeerStats> m_peerStats;
+	double m_averageBlockSize;
+};
\ No newline at end of file
@@ -4,8 +4,11 @@
 
 #include <BlockChain/BlockChainServer.h>
 #include <Infrastructure/Logger.h>
-#include <Common/Util/StringUtil.h>
-#include <Crypto/RandomNumberGenerator.h>
+#include <algorithm>
+
+// Memory budget for blocks that are in flight or waiting to be validated.
+static const uint64_t MAX_BYTES_AHEAD = 32 * 1024 * 1024;
+static const uint64_t MAX_BLOCKS_AHEAD = 2048;
 
 BlockSyncer::BlockSyncer(
 	std::weak_ptr<ConnectionManager> pConnectionManager,
@@ -14,9 +17,11 @@ BlockSyncer::BlockSyncer(
 	: m_pConnectionManager(pConnectionManager),
 	m_pBlockChainServer(pBlockChainServer),
 	m_pPipeline(pPipeline),
-	m_timeout(std::chrono::system_clock::now()),
-	m_lastHeight(0),
-	m_highestRequested(0)
+	m_scheduler([pConnectionManager](const PeerPtr& pPeer, const Hash& blockHash) {
+		const GetBlockMessage getBlockMessage(blockHash);
+		return pConnectionManager.lock()->SendMessageToPeer(getBlockMessage, pPeer);
+	}),
+	m_lastReceipt(BlockScheduler::Clock::now())
 {
 
 }
@@ -28,162 +33,89 @@ bool BlockSyncer::SyncBlocks(const SyncStatus& syncStatus, const bool startup)
 
 	if (networkHeight >= (chainHeight + 5) || (startup && networkHeight > chainHeight))
 	{
-		if (IsBlockSyncDue(syncStatus))
-		{
-			RequestBlocks();
+		std::vector<PeerPtr> peers = m_pConnectionManager.lock()->GetMostWorkPeers();
+		peers.erase(
+			std::remove_if(peers.begin(), peers.end(), [](const PeerPtr& pPeer) { return pPeer->IsBanned(); }),
+			peers.end()
+		);
 
-			m_lastHeight = chainHeight;
-			m_timeout = std::chrono::system_clock::now() + std::chrono::seconds(5);
-		}
+		CompleteRequests(chainHeight);
+		m_scheduler.ExpireRequests(peers, BlockScheduler::Clock::now());
+		RequestBlocks(peers);
 
 		return true;
 	}
 
+	m_scheduler.Clear();
+
 	return false;
 }
 
-bool BlockSyncer::IsBlockSyncDue(const SyncStatus& syncStatus)
+//
+// Credits peers for the blocks received since the last tick, in the order they arrived.
+//
+void BlockSyncer::CompleteRequests(const uint64_t chainHeight)
 {
-	const uint64_t chainHeight = syncStatus.GetBlockHeight();
-
-	const uint64_t blocksDownloaded = (chainHeight - m_lastHeight);
-	if (blocksDownloaded > 0)
-	{
-		LOG_TRACE_F("{} blocks received since last check.", blocksDownloaded);
-	}
-
-	// Remove downloaded blocks from queue.
-	for (size_t i = m_lastHeight; i <= chainHeight; i++)
-	{
-		m_requestedBlocks.erase(i);
-	}
-
-	m_lastHeight = chainHeight;
-
-	// Check if blocks were received, and we're ready to request next batch.
-	if (m_requestedBlocks.size() < 15)
-	{
-		LOG_TRACE("Requesting next batch.");
-		return true;
-	}
-
-	// Make sure we have valid requests for the first 15 blocks.
-	std::vector<std::pair<uint64_t, Hash>> blocksNeeded = m_pBlockChainServer->GetBlocksNeeded(15);
-	for (auto iter = blocksNeeded.cbegin(); iter != blocksNeeded.cend(); iter++)
+	for (const BlockPipe::Receipt& receipt : m_pPipeline->GetBlockPipe()->GetReceiptsSince(m_lastReceipt))
 	{
-		auto requestedBlocksIter = m_requestedBlocks.find(iter->first);
-		if (requestedBlocksIter == m_requestedBlocks.end())
-		{
-			LOG_TRACE("Block not requested yet. Requesting now.");
-			return true;
-		}
-
-		if (IsSlowPeer(requestedBlocksIter->second.PEER))
-		{
-			LOG_TRACE("Waiting on block from banned peer. Requesting from valid peer now.");
-			return true;
-		}
-
-		if (requestedBlocksIter->second.TIMEOUT < std::chrono::system_clock::now())
-		{
-			if (m_pPipeline->GetBlockPipe()->IsProcessingBlock(iter->second))
-			{
-				continue;
-			}
-
-			LOG_WARNING("Block request timed out. Requesting again.");
-			return true;
-		}
+		m_lastReceipt = receipt.receivedTime;
+		m_scheduler.OnBlockReceived(receipt.blockHash, receipt.peerAddress, receipt.numBytes, receipt.receivedTime);
 	}
 
-	return false;
+	// Blocks that were already applied (or received without a matching receipt) no longer need a request.
+	m_scheduler.RemoveRequests([this, chainHeight](const uint64_t height, const Hash& blockHash) {
+		return height <= chainHeight || m_pPipeline->GetBlockPipe()->IsProcessingBlock(blockHash);
+	});
 }
 
-bool BlockSyncer::RequestBlocks()
+void BlockSyncer::RequestBlocks(const std::vector<PeerPtr>& peers)
 {
-	LOG_TRACE("Requesting blocks.");
-
-	std::vector<PeerPtr> mostWorkPeers = m_pConnectionManager.lock()->GetMostWorkPeers();
-	const uint64_t numPeers = mostWorkPeers.size();
-	if (mostWorkPeers.empty())
+	if (peers.empty())
 	{
 		LOG_DEBUG("No most-work peers found.");
-		return false;
+		return;
 	}
 
-	const uint64_t numBlocksNeeded = 16 * numPeers;
-	std::vector<std::pair<uint64_t, Hash>> blocksNeeded = m_pBlockChainServer->GetBlocksNeeded(2 * numBlocksNeeded);
-	if (blocksNeeded.empty())
+	// Stay within the memory budget: blocks waiting to be validated, plus blocks expected from in-flight requests.
+	const size_t numRequests = m_scheduler.GetNumRequests();
+	const double averageBlockSize = m_scheduler.GetAverageBlockSize();
+	const uint64_t bytesAhead = m_pPipeline->GetBlockPipe()->GetQueuedBytes() + (uint64_t)(numRequests * averageBlockSize);
+	if (bytesAhead >= MAX_BYTES_AHEAD || numRequests >= MAX_BLOCKS_AHEAD)
 	{
-		LOG_TRACE("No blocks needed.");
-		return false;
+		return;
 	}
 
-	size_t blockIndex = 0;
+	const size_t budget = (size_t)((MAX_BYTES_AHEAD - bytesAhead) / averageBlockSize);
+	const size_t numToRequest = (std::min)({ m_scheduler.GetCapacity(peers), budget, (size_t)MAX_BLOCKS_AHEAD - numRequests });
+	if (numToRequest == 0)
+	{
+		return;
+	}
 
-	std::vector<std::pair<uint64_t, Hash>> blocksToRequest;
+	std::vector<std::pair<uint64_t, Hash>> blocksNeeded = m_pBlockChainServer->GetBlocksNeeded(numRequests + numToRequest);
 
-	while (blockIndex < blocksNeeded.size())
+	const auto now = BlockScheduler::Clock::now();
+	size_t numRequested = 0;
+	for (const std::pair<uint64_t, Hash>& blockNeeded : blocksNeeded)
 	{
-		if (m_pPipeline->GetBlockPipe()->IsProcessingBlock(blocksNeeded[blockIndex].second))
+		if (m_scheduler.IsRequested(blockNeeded.first, blockNeeded.second))
 		{
-			++blockIndex;
 			continue;
 		}
 
-		auto iter = m_requestedBlocks.find(blocksNeeded[blockIndex].first);
-		if (iter != m_requestedBlocks.end())
+		if (m_pPipeline->GetBlockPipe()->IsProcessingBlock(blockNeeded.second))
 		{
-			if (IsSlowPeer(iter->second.PEER) || iter->second.TIMEOUT < std::chrono::system_clock::now())
-			{
-				if (!iter->second.PEER->IsBanned())
-				{
-					LOG_ERROR_F("Banning peer {} for fraud height.", iter->second.PEER);
-					iter->second.PEER->Ban(EBanReason::FraudHeight);
-				}
-
-				m_slowPeers.insert(iter->second.PEER->GetIPAddress());
-
-				blocksToRequest.emplace_back(blocksNeeded[blockIndex]);
-			}
-		}
-		else
-		{
-			blocksToRequest.emplace_back(blocksNeeded[blockIndex]);
+			continue;
 		}
 
-		if (blocksToRequest.size() >= numBlocksNeeded)
+		if (!m_scheduler.RequestBlock(blockNeeded.first, blockNeeded.second, peers, now) || ++numRequested >= numToRequest)
 		{
 			break;
 		}
-
-		++blockIndex;
 	}
 
-	size_t nextPeer = RandomNumberGenerator::GenerateRandom(0, mostWorkPeers.size() - 1);
-	for (size_t i = 0; i < blocksToRequest.size(); i++)
+	if (numRequested > 0)
 	{
-		const GetBlockMessage getBlockMessage(blocksToRequest[i].second);
-		if (m_pConnectionManager.lock()->SendMessageToPeer(getBlockMessage, mostWorkPeers[nextPeer]))
-		{
-			RequestedBlock blockRequested;
-			blockRequested.BLOCK_HEIGHT = blocksToRequest[i].first;
-			blockRequested.PEER = mostWorkPeers[nextPeer];
-			blockRequested.TIMEOUT = std::chrono::system_clock::now() + std::chrono::seconds(10);
-
-			m_requestedBlocks[blockRequested.BLOCK_HEIGHT] = std::move(blockRequested);
-		}
-
-		if ((i + 1) % 16 == 0)
-		{
-			nextPeer = (nextPeer + 1) % mostWorkPeers.size();
-		}
+		LOG_TRACE_F("{} blocks requested from {} peers.", numRequested, peers.size());
 	}
-
-	if (!blocksToRequest.empty())
-	{
-		LOG_TRACE_F("{} blocks requested from %llu peers.", blocksToRequest.size(), numPeers);
-	}
-
-	return true;
 }
\ No newline at end of file
@@ -1,18 +1,20 @@
 #pragma once
 
+#include "BlockScheduler.h"
 #include "../ConnectionManager.h"
 #include "../Pipeline/Pipeline.h"
 
 #include <BlockChain/BlockChainServer.h>
 #include <chrono>
-#include <deque>
-#include <unordered_set>
-#include <unordered_map>
 #include <stdint.h>
 
 // Forward Declarations
 class SyncStatus;
 
+//
+// Schedules block requests across all most-work peers, using a BlockScheduler to pick the peer for each block.
+// The total number of bytes requested or waiting in the BlockPipe is capped, bounding memory use.
+//
 class BlockSyncer
 {
 public:
@@ -25,25 +27,13 @@ public:
 	bool SyncBlocks(const SyncStatus& syncStatus, const bool startup);
 
 private:
-	bool IsBlockSyncDue(const SyncStatus& syncStatus);
-	bool RequestBlocks();
-	bool IsSlowPeer(PeerConstPtr pPeer) const { return m_slowPeers.find(pPeer->GetIPAddress()) != m_slowPeers.end(); }
+	void CompleteRequests(const uint64_t chainHeight);
+	void RequestBlocks(const std::vector<PeerPtr>& peers);
 
 	std::weak_ptr<ConnectionManager> m_pConnectionManager;
 	IBlockChainServerPtr m_pBlockChainServer;
 	std::shared_ptr<Pipeline> m_pPipeline;
 
-	std::chrono::time_point<std::chrono::system_clock> m_timeout;
-	uint64_t m_lastHeight;
-	uint64_t m_highestRequested;
-
-	struct RequestedBlock
-	{
-		PeerPtr PEER;
-		uint64_t BLOCK_HEIGHT;
-		std::chrono::time_point<std::chrono::system_clock> TIMEOUT;
-		// TODO: Add retry?
-	};
-	std::unordered_map<uint64_t, RequestedBlock> m_requestedBlocks;
-	std::unordered_set<IPAddress> m_slowPeers;
+	BlockScheduler m_scheduler;
+	BlockScheduler::Clock::time_point m_lastReceipt;
 };
\ No newline at end of file
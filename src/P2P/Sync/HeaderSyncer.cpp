@@ -4,14 +4,27 @@
 
 #include <BlockChain/BlockChainServer.h>
 #include <Infrastructure/Logger.h>
+#include <algorithm>
 
-HeaderSyncer::HeaderSyncer(std::weak_ptr<ConnectionManager> pConnectionManager, IBlockChainServerPtr pBlockChainServer)
-	: m_pConnectionManager(pConnectionManager), m_pBlockChainServer(pBlockChainServer)
+// Number of peers that can be asked for the same range at once (the original request plus hedges).
+static const size_t MAX_REQUESTS_PER_RANGE = 3;
+
+// Stop requesting once this many headers are waiting to be processed.
+static const uint64_t MAX_HEADERS_AHEAD = P2P::MAX_BLOCK_HEADERS * 8;
+
+static const auto DEFAULT_LATENCY = std::chrono::milliseconds(2000);
+static const auto MIN_HEDGE_TIMEOUT = std::chrono::milliseconds(2000);
+static const auto REQUEST_TIMEOUT = std::chrono::milliseconds(12000);
+
+HeaderSyncer::HeaderSyncer(
+	std::weak_ptr<ConnectionManager> pConnectionManager,
+	IBlockChainServerPtr pBlockChainServer,
+	std::shared_ptr<HeaderPipe> pHeaderPipe)
+	: m_pConnectionManager(pConnectionManager),
+	m_pBlockChainServer(pBlockChainServer),
+	m_pHeaderPipe(pHeaderPipe)
 {
-	m_timeout = std::chrono::system_clock::now();
-	m_lastHeight = 0;
-	m_pPeer = nullptr;
-	m_retried = false;
+
 }
 
 bool HeaderSyncer::SyncHeaders(const SyncStatus& syncStatus, const bool startup)
@@ -27,95 +40,212 @@ bool HeaderSyncer::SyncHeaders(const SyncStatus& syncStatus, const bool startup)
 
 	if (networkHeight >= (chainHeight + 5) || (startup && networkHeight > chainHeight))
 	{
-		if (IsHeaderSyncDue(syncStatus))
-		{
-			RequestHeaders(syncStatus);
-		}
-
+		ScheduleRequests(syncStatus);
 		return true;
 	}
 
-	m_pPeer = nullptr;
-	m_retried = false;
+	m_requests.clear();
 
 	return false;
 }
 
-bool HeaderSyncer::IsHeaderSyncDue(const SyncStatus& syncStatus)
+void HeaderSyncer::ScheduleRequests(const SyncStatus& syncStatus)
 {
-	if (m_pPeer == nullptr)
-	{
-		return true;
-	}
+	auto pTipHeader = m_pBlockChainServer->GetTipBlockHeader(EChainType::CANDIDATE);
+	const std::pair<Hash, uint64_t> frontier = m_pHeaderPipe->GetFrontier(*pTipHeader);
 
-	const uint64_t height = syncStatus.GetHeaderHeight();
+	CompleteRequests(frontier.first);
+	ExpireRequests();
 
-	// Check if headers were received, and we're ready to request next batch.
-	if (height >= (m_lastHeight + P2P::MAX_BLOCK_HEADERS - 1))
+	if (frontier.second >= syncStatus.GetNetworkHeight() || frontier.second >= (pTipHeader->GetHeight() + MAX_HEADERS_AHEAD))
 	{
-		LOG_TRACE("Headers received. Requesting next batch.");
-		m_retried = false;
-		return true;
+		return;
 	}
 
-	if (!m_pConnectionManager.lock()->IsConnected(m_pPeer->GetIPAddress()))
+	if (!m_requests.empty())
 	{
-		LOG_TRACE("Peer disconnected. Requesting from new peer.");
-		m_pPeer = nullptr;
-		return true;
+		if (m_requests.size() >= MAX_REQUESTS_PER_RANGE)
+		{
+			return;
+		}
+
+		// Hedge the request if the most recent peer asked is taking much longer than usual.
+		const Request& lastRequest = m_requests.back();
+		const auto elapsed = Clock::now() - lastRequest.sentTime;
+		if (elapsed < GetHedgeTimeout())
+		{
+			return;
+		}
+
+		LOG_DEBUG_F("Headers from {} are slow. Requesting from another peer.", lastRequest.pPeer);
+
+		// Demote the slow peer, so it's picked last until it answers quickly again.
+		PeerStats& stats = m_peerStats.insert({ lastRequest.pPeer->GetIPAddress(), PeerStats{ DEFAULT_LATENCY, 0 } }).first->second;
+		stats.latency = (std::max)(stats.latency, std::chrono::duration_cast<std::chrono::milliseconds>(elapsed));
 	}
 
-	// Check if header download timed out.
-	if (m_timeout < std::chrono::system_clock::now())
+	RequestHeaders(syncStatus, frontier, *pTipHeader);
+}
+
+//
+// A request is complete once a batch anchored at its hash is received. The peer that delivered it gets credit.
+// All requests not anchored at the frontier are obsolete, since that range has already been received.
+//
+void HeaderSyncer::CompleteRequests(const Hash& frontierHash)
+{
+	auto iter = m_requests.begin();
+	while (iter != m_requests.end())
 	{
-		LOG_DEBUG("Timed out. Banning then requesting from new peer.");
+		auto pReceipt = m_pHeaderPipe->GetReceipt(iter->anchorHash);
+		if (pReceipt != nullptr && pReceipt->receivedTime >= iter->sentTime && pReceipt->peerAddress == iter->pPeer->GetIPAddress())
+		{
+			const auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(pReceipt->receivedTime - iter->sentTime);
+
+			// Exponential moving average, so one slow response doesn't permanently demote a peer.
+			PeerStats& stats = m_peerStats.insert({ pReceipt->peerAddress, PeerStats{ latency, 0 } }).first->second;
+			stats.latency = (stats.latency * 3 + latency) / 4;
+			stats.timeouts = 0;
+
+			LOG_TRACE_F("Headers received from {} in {}ms", iter->pPeer, latency.count());
+			iter = m_requests.erase(iter);
+		}
+		else if (iter->anchorHash != frontierHash)
+		{
+			iter = m_requests.erase(iter);
+		}
+		else
+		{
+			iter++;
+		}
+	}
+}
 
-		if (m_pPeer != nullptr)
+void HeaderSyncer::ExpireRequests()
+{
+	const auto now = Clock::now();
+
+	auto iter = m_requests.begin();
+	while (iter != m_requests.end())
+	{
+		if (iter->sentTime + REQUEST_TIMEOUT < now)
 		{
-			if (m_retried)
+			PeerStats& stats = m_peerStats.insert({ iter->pPeer->GetIPAddress(), PeerStats{ DEFAULT_LATENCY, 0 } }).first->second;
+			stats.latency = REQUEST_TIMEOUT;
+			stats.timeouts++;
+
+			// The peer claims more work than us, but repeatedly fails to send the headers.
+			if (stats.timeouts >= 2)
 			{
-				LOG_ERROR_F("Banning peer {} for fraud height.", m_pPeer);
-				m_pPeer->Ban(EBanReason::FraudHeight);
-				m_pPeer = nullptr;
-				m_retried = false;
+				LOG_ERROR_F("Banning peer {} for fraud height.", iter->pPeer);
+				iter->pPeer->Ban(EBanReason::FraudHeight);
+				m_peerStats.erase(iter->pPeer->GetIPAddress());
 			}
 			else
 			{
-				m_retried = true;
+				LOG_DEBUG_F("Header request to {} timed out.", iter->pPeer);
 			}
-		}
 
-		return true;
+			iter = m_requests.erase(iter);
+		}
+		else
+		{
+			iter++;
+		}
 	}
-
-	return false;
 }
 
-bool HeaderSyncer::RequestHeaders(const SyncStatus& syncStatus)
+bool HeaderSyncer::RequestHeaders(const SyncStatus& syncStatus, const std::pair<Hash, uint64_t>& frontier, const BlockHeader& tipHeader)
 {
-	LOG_TRACE("Requesting headers.");
+	const Hash& anchorHash = frontier.first;
+
+	PeerPtr pPeer = ChooseNextPeer(syncStatus, frontier.second);
+	if (pPeer == nullptr)
+	{
+		return false;
+	}
 
 	std::vector<Hash> locators = BlockLocator(m_pBlockChainServer).GetLocators(syncStatus);
 
+	// Anchor the request at the frontier, falling back to the regular locators if the peer is on a different fork.
+	if (anchorHash != tipHeader.GetHash())
+	{
+		locators.insert(locators.begin(), anchorHash);
+		if (locators.size() > P2P::MAX_LOCATORS)
+		{
+			locators.erase(locators.end() - 2);
+		}
+	}
+
+	LOG_TRACE_F("Requesting headers from {}.", pPeer);
+
+	m_pHeaderPipe->ExpectHeaders(pPeer, locators);
+
 	const GetHeadersMessage getHeadersMessage(std::move(locators));
+	if (!m_pConnectionManager.lock()->SendMessageToPeer(getHeadersMessage, pPeer))
+	{
+		return false;
+	}
 
-	bool messageSent = false;
-	if (m_pPeer != nullptr)
+	m_requests.push_back(Request{ anchorHash, pPeer, Clock::now() });
+	return true;
+}
+
+//
+// Picks the fastest peer with more work than us (as reported by its pings) that isn't already working on the current range.
+// Peers that haven't been asked yet are assumed to have the default latency.
+//
+PeerPtr HeaderSyncer::ChooseNextPeer(const SyncStatus& syncStatus, const uint64_t frontierHeight) const
+{
+	PeerPtr pBestPeer = nullptr;
+	std::chrono::milliseconds bestLatency = std::chrono::milliseconds::max();
+	for (const ConnectedPeer& connectedPeer : m_pConnectionManager.lock()->GetConnectedPeers())
 	{
-		messageSent = m_pConnectionManager.lock()->SendMessageToPeer(getHeadersMessage, m_pPeer);
+		if (connectedPeer.GetTotalDifficulty() <= syncStatus.GetHeaderDifficulty() || connectedPeer.GetHeight() <= frontierHeight)
+		{
+			continue;
+		}
+
+		PeerPtr pPeer = std::const_pointer_cast<Peer>(connectedPeer.GetPeer());
+		const bool alreadyRequested = std::any_of(
+			m_requests.cbegin(),
+			m_requests.cend(),
+			[&pPeer](const Request& request) { return request.pPeer->GetIPAddress() == pPeer->GetIPAddress(); }
+		);
+		if (alreadyRequested || pPeer->IsBanned())
+		{
+			continue;
+		}
+
+		const std::chrono::milliseconds latency = GetLatency(pPeer->GetIPAddress());
+		if (latency < bestLatency)
+		{
+			pBestPeer = pPeer;
+			bestLatency = latency;
+		}
 	}
-	
-	if (!messageSent)
+
+	return pBestPeer;
+}
+
+std::chrono::milliseconds HeaderSyncer::GetHedgeTimeout() const
+{
+	std::chrono::milliseconds fastest = DEFAULT_LATENCY;
+	for (const auto& stats : m_peerStats)
 	{
-		m_pPeer = m_pConnectionManager.lock()->SendMessageToMostWorkPeer(getHeadersMessage);
+		fastest = (std::min)(fastest, stats.second.latency);
 	}
 
-	if (m_pPeer != nullptr)
+	const auto timeout = (std::max)(fastest * 3, std::chrono::duration_cast<std::chrono::milliseconds>(MIN_HEDGE_TIMEOUT));
+	return (std::min)(timeout, std::chrono::duration_cast<std::chrono::milliseconds>(REQUEST_TIMEOUT));
+}
+
+std::chrono::milliseconds HeaderSyncer::GetLatency(const IPAddress& address) const
+{
+	auto iter = m_peerStats.find(address);
+	if (iter != m_peerStats.cend())
 	{
-		LOG_TRACE("Headers requested.");
-		m_timeout = std::chrono::system_clock::now() + std::chrono::seconds(12);
-		m_lastHeight = syncStatus.GetHeaderHeight();
+		return iter->second.latency;
 	}
 
-	return m_pPeer != nullptr;
+	return DEFAULT_LATENCY;
 }
\ No newline at end of file
@@ -1,29 +1,64 @@
 #pragma once
 
 #include "../ConnectionManager.h"
+#include "../Pipeline/HeaderPipe.h"
 
 #include <BlockChain/BlockChainServer.h>
+#include <Net/IPAddress.h>
 #include <chrono>
+#include <unordered_map>
 
 // Forward Declarations
 class SyncStatus;
 
+//
+// Schedules header requests across all peers with more work than us.
+//
+// Each request is anchored at the current frontier - the last PoW-checked header received (but not necessarily processed yet).
+// As soon as a batch arrives, the next range is requested from the next best peer, so downloading overlaps with
+// validation, and the HeaderPipe reassembles the batches in order. Requests that take longer than a few times the
+// typical latency are hedged by sending the same range to another peer, so a single slow peer can't stall the sync.
+// Peers that time out are demoted, and peers that repeatedly fail to deliver the work they claim are banned.
+//
 class HeaderSyncer
 {
 public:
-	HeaderSyncer(std::weak_ptr<ConnectionManager> pConnectionManager, IBlockChainServerPtr pBlockChainServer);
+	HeaderSyncer(
+		std::weak_ptr<ConnectionManager> pConnectionManager,
+		IBlockChainServerPtr pBlockChainServer,
+		std::shared_ptr<HeaderPipe> pHeaderPipe
+	);
 
 	bool SyncHeaders(const SyncStatus& syncStatus, const bool startup);
 
 private:
-	bool IsHeaderSyncDue(const SyncStatus& syncStatus);
-	bool RequestHeaders(const SyncStatus& syncStatus);
+	using Clock = std::chrono::steady_clock;
+
+	struct Request
+	{
+		Hash anchorHash;
+		PeerPtr pPeer;
+		Clock::time_point sentTime;
+	};
+
+	struct PeerStats
+	{
+		std::chrono::milliseconds latency;
+		size_t timeouts;
+	};
+
+	void ScheduleRequests(const SyncStatus& syncStatus);
+	void CompleteRequests(const Hash& frontierHash);
+	void ExpireRequests();
+	bool RequestHeaders(const SyncStatus& syncStatus, const std::pair<Hash, uint64_t>& frontier, const BlockHeader& tipHeader);
+	PeerPtr ChooseNextPeer(const SyncStatus& syncStatus, const uint64_t frontierHeight) const;
+	std::chrono::milliseconds GetHedgeTimeout() const;
+	std::chrono::milliseconds GetLatency(const IPAddress& address) const;
 
 	std::weak_ptr<ConnectionManager> m_pConnectionManager;
 	IBlockChainServerPtr m_pBlockChainServer;
+	std::shared_ptr<HeaderPipe> m_pHeaderPipe;
 
-	std::chrono::time_point<std::chrono::system_clock> m_timeout;
-	uint64_t m_lastHeight;
-	PeerPtr m_pPeer;
-	bool m_retried;
+	std::vector<Request> m_requests;
+	std::unordered_map<IPAddress, PeerStats> m_peerStats;
 };
\ No newline at end of file
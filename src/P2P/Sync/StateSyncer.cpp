@@ -6,8 +6,8 @@
 #include <Infrastructure/Logger.h>
 #include <Infrastructure/ShutdownManager.h>
 
-StateSyncer::StateSyncer(std::weak_ptr<ConnectionManager> pConnectionManager, IBlockChainServerPtr pBlockChainServer)
-	: m_pConnectionManager(pConnectionManager), m_pBlockChainServer(pBlockChainServer)
+StateSyncer::StateSyncer(const Config& config, std::weak_ptr<ConnectionManager> pConnectionManager, IBlockChainServerPtr pBlockChainServer)
+	: m_config(config), m_pConnectionManager(pConnectionManager), m_pBlockChainServer(pBlockChainServer)
 {
 	m_timeRequested = std::chrono::system_clock::now();
 	m_requestedHeight = 0;
@@ -16,6 +16,12 @@ StateSyncer::StateSyncer(std::weak_ptr<ConnectionManager> pConnectionManager, IB
 
 bool StateSyncer::SyncState(SyncStatus& syncStatus)
 {
+	// Archive history is recorded as blocks are applied, so archive nodes download every block from genesis instead.
+	if (m_config.GetNodeConfig().IsArchiveMode())
+	{
+		return false;
+	}
+
 	if (IsStateSyncDue(syncStatus))
 	{
 		syncStatus.UpdateStatus(ESyncStatus::SYNCING_TXHASHSET);
@@ -3,6 +3,7 @@
 #include "../ConnectionManager.h"
 
 #include <BlockChain/BlockChainServer.h>
+#include <Config/Config.h>
 #include <chrono>
 
 // Forward Declarations
@@ -11,7 +12,7 @@ class SyncStatus;
 class StateSyncer
 {
 public:
-	StateSyncer(std::weak_ptr<ConnectionManager> pConnectionManager, IBlockChainServerPtr pBlockChainServer);
+	StateSyncer(const Config& config, std::weak_ptr<ConnectionManager> pConnectionManager, IBlockChainServerPtr pBlockChainServer);
 
 	bool SyncState(SyncStatus& syncStatus);
 
@@ -23,6 +24,7 @@ private:
 	uint64_t m_requestedHeight;
 	PeerPtr m_pPeer;
 
+	const Config& m_config;
 	std::weak_ptr<ConnectionManager> m_pConnectionManager;
 	IBlockChainServerPtr m_pBlockChainServer;
 };
\ No newline at end of file
@@ -12,11 +12,13 @@
 static const int MINIMUM_NUM_PEERS = 4;
 
 Syncer::Syncer(
+	const Config& config,
 	std::weak_ptr<ConnectionManager> pConnectionManager,
 	IBlockChainServerPtr pBlockChainServer,
 	std::shared_ptr<Pipeline> pPipeline,
 	SyncStatusPtr pSyncStatus)
-	: m_pConnectionManager(pConnectionManager),
+	: m_config(config),
+	m_pConnectionManager(pConnectionManager),
 	m_pBlockChainServer(pBlockChainServer),
 	m_pPipeline(pPipeline),
 	m_pSyncStatus(pSyncStatus),
@@ -32,12 +34,14 @@ Syncer::~Syncer()
 }
 
 std::shared_ptr<Syncer> Syncer::Create(
+	const Config& config,
 	std::weak_ptr<ConnectionManager> pConnectionManager,
 	IBlockChainServerPtr pBlockChainServer,
 	std::shared_ptr<Pipeline> pPipeline,
 	SyncStatusPtr pSyncStatus)
 {
 	std::shared_ptr<Syncer> pSyncer = std::shared_ptr<Syncer>(new Syncer(
+		config,
 		pConnectionManager,
 		pBlockChainServer,
 		pPipeline,
@@ -53,8 +57,8 @@ void Syncer::Thread_Sync(Syncer& syncer)
 	ThreadManagerAPI::SetCurrentThreadName("SYNC");
 	LOG_DEBUG("BEGIN");
 
-	HeaderSyncer headerSyncer(syncer.m_pConnectionManager, syncer.m_pBlockChainServer);
-	StateSyncer stateSyncer(syncer.m_pConnectionManager, syncer.m_pBlockChainServer);
+	HeaderSyncer headerSyncer(syncer.m_pConnectionManager, syncer.m_pBlockChainServer, syncer.m_pPipeline->GetHeaderPipe());
+	StateSyncer stateSyncer(syncer.m_config, syncer.m_pConnectionManager, syncer.m_pBlockChainServer);
 	BlockSyncer blockSyncer(syncer.m_pConnectionManager, syncer.m_pBlockChainServer, syncer.m_pPipeline);
 	bool startup = true;
 
@@ -5,6 +5,7 @@
 
 #include <P2P/SyncStatus.h>
 #include <BlockChain/BlockChainServer.h>
+#include <Config/Config.h>
 #include <atomic>
 #include <thread>
 
@@ -15,6 +16,7 @@ class Syncer
 {
 public:
 	static std::shared_ptr<Syncer> Create(
+		const Config& config,
 		std::weak_ptr<ConnectionManager> pConnectionManager,
 		IBlockChainServerPtr pBlockChainServer,
 		std::shared_ptr<Pipeline> pPipeline,
@@ -24,6 +26,7 @@ public:
 
 private:
 	Syncer(
+		const Config& config,
 		std::weak_ptr<ConnectionManager> pConnectionManager,
 		IBlockChainServerPtr pBlockChainServer,
 		std::shared_ptr<Pipeline> pPipeline,
@@ -33,6 +36,7 @@ private:
 	static void Thread_Sync(Syncer& syncer);
 	void UpdateSyncStatus();
 
+	const Config& m_config;
 	std::weak_ptr<ConnectionManager> m_pConnectionManager;
 	IBlockChainServerPtr m_pBlockChainServer;
 	std::shared_ptr<Pipeline> m_pPipeline;
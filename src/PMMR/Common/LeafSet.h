@@ -12,6 +12,7 @@
 #include <Common/Util/HexUtil.h>
 #include <Common/Util/FileUtil.h>
 #include <Core/Serialization/Serializer.h>
+#include <Infrastructure/Metrics.h>
 
 #include <filesystem.h>
 
@@ -25,12 +26,16 @@ public:
 		return std::shared_ptr<LeafSet>(new LeafSet(path, pBitmapFile));
 	}
 
-	void Add(const uint64_t leafIndex) { m_pBitmap->Set(leafIndex); }
-	void Remove(const uint64_t leafIndex) { m_pBitmap->Unset(leafIndex); }
-	bool Contains(const uint64_t leafIndex) const { return m_pBitmap->IsSet(leafIndex); }
+	void Add(const uint64_t leafIndex) { m_pUpdates->Increment(); m_pBitmap->Set(leafIndex); }
+	void Remove(const uint64_t leafIndex) { m_pUpdates->Increment(); m_pBitmap->Unset(leafIndex); }
+	bool Contains(const uint64_t leafIndex) const { m_pReads->Increment(); return m_pBitmap->IsSet(leafIndex); }
 
 	void Rewind(const uint64_t numLeaves, const std::vector<uint64_t>& leavesToAdd) { m_pBitmap->Rewind(numLeaves, leavesToAdd); }
-	void Commit() { m_pBitmap->Commit(); }
+	void Commit()
+	{
+		Metrics::ScopedTimer timer(*m_pFlushLatency);
+		m_pBitmap->Commit();
+	}
 	void Rollback() noexcept { m_pBitmap->Rollback(); }
 	void Snapshot(const Hash& blockHash)
 	{
@@ -72,11 +77,19 @@ public:
 
 private:
 	LeafSet(const fs::path& path, std::shared_ptr<BitmapFile> pBitmap)
-		: m_path(path), m_pBitmap(pBitmap)
+		: m_path(path),
+		m_pBitmap(pBitmap),
+		m_pReads(&MetricsAPI::GetCounter("pmmr." + path.parent_path().filename().u8string() + ".leafset.reads")),
+		m_pUpdates(&MetricsAPI::GetCounter("pmmr." + path.parent_path().filename().u8string() + ".leafset.updates")),
+		m_pFlushLatency(&MetricsAPI::GetHistogram("pmmr." + path.parent_path().filename().u8string() + ".leafset.flush_micros"))
 	{
 
 	}
 
 	fs::path m_path;
 	std::shared_ptr<BitmapFile> m_pBitmap;
+
+	Metrics::Counter* m_pReads;
+	Metrics::Counter* m_pUpdates;
+	Metrics::Histogram* m_pFlushLatency;
 };
@@ -79,14 +79,14 @@ bool TxHashSet::IsValid(std::shared_ptr<const IBlockDB> pBlockDB, const Transact
 	return true;
 }
 
-std::unique_ptr<BlockSums> TxHashSet::ValidateTxHashSet(const BlockHeader& header, const IBlockChainServer& blockChainServer, SyncStatus& syncStatus)
+std::unique_ptr<BlockSums> TxHashSet::ValidateTxHashSet(const BlockHeader& header, const IBlockChainServer& blockChainServer, TaskPool& taskPool, SyncStatus& syncStatus)
 {
 	std::unique_ptr<BlockSums> pBlockSums = nullptr;
 
 	try
 	{
 		LOG_INFO("Validating TxHashSet for block " + header.GetHash().ToHex());
-		pBlockSums = TxHashSetValidator(blockChainServer).Validate(*this, header, syncStatus);
+		pBlockSums = TxHashSetValidator(blockChainServer, taskPool).Validate(*this, header, syncStatus);
 		if (pBlockSums != nullptr)
 		{
 			LOG_INFO("Successfully validated TxHashSet");
@@ -126,6 +126,7 @@ bool TxHashSet::ApplyBlock(std::shared_ptr<IBlockDB> pBlockDB, const FullBlock&
 	}
 
 	pBlockDB->AddSpentPositions(block.GetHash(), spentPositions);
+	pBlockDB->AddArchiveEntries(block, spentPositions);
 
 	// Append new outputs
 	for (const TransactionOutput& output : block.GetOutputs())
@@ -153,7 +154,10 @@ bool TxHashSet::ApplyBlock(std::shared_ptr<IBlockDB> pBlockDB, const FullBlock&
 	// Append new kernels
 	for (const TransactionKernel& kernel : block.GetKernels())
 	{
+		const uint64_t mmrIndex = m_pKernelMMR->GetSize();
 		m_pKernelMMR->ApplyKernel(kernel);
+
+		pBlockDB->AddKernelPosition(kernel.GetExcessCommitment(), KernelLocation(mmrIndex, block.GetHeight()));
 	}
 
 	m_pBlockHeader = block.GetBlockHeader();
@@ -267,6 +271,34 @@ void TxHashSet::SaveOutputPositions(const Chain::CPtr& pChain, std::shared_ptr<I
 	}
 }
 
+void TxHashSet::SaveKernelPositions(const Chain::CPtr& pChain, std::shared_ptr<IBlockDB> pBlockDB) const
+{
+	uint64_t firstKernel = 0;
+	for (uint64_t height = 0; height <= m_pBlockHeader->GetHeight(); height++)
+	{
+		auto pIndex = pChain->GetByHeight(height);
+		if (pIndex != nullptr)
+		{
+			auto pHeader = pBlockDB->GetBlockHeader(pIndex->GetHash());
+			if (pHeader != nullptr)
+			{
+				const uint64_t size = pHeader->GetKernelMMRSize();
+				for (uint64_t mmrIndex = firstKernel; mmrIndex < size; mmrIndex++)
+				{
+					std::unique_ptr<TransactionKernel> pKernel = m_pKernelMMR->GetKernelAt(mmrIndex);
+					if (pKernel != nullptr)
+					{
+						KernelLocation location(mmrIndex, pHeader->GetHeight());
+						pBlockDB->AddKernelPosition(pKernel->GetExcessCommitment(), location);
+					}
+				}
+
+				firstKernel = size;
+			}
+		}
+	}
+}
+
 std::vector<Hash> TxHashSet::GetLastKernelHashes(const uint64_t numberOfKernels) const
 {
 	return m_pKernelMMR->GetLastLeafHashes(numberOfKernels);
@@ -352,6 +384,8 @@ void TxHashSet::Rewind(std::shared_ptr<IBlockDB> pBlockDB, const BlockHeader& he
 		std::unordered_map<Commitment, OutputLocation> spentOutputs = pBlockDB->GetSpentPositions(m_pBlockHeader->GetHash());
 
 		pBlockDB->RemoveOutputPositions(pBlock->GetOutputCommitments());
+		pBlockDB->RemoveKernelPositions(pBlock->GetKernelCommitments());
+		pBlockDB->RemoveArchiveEntries(*pBlock);
 
 		for (const auto& input : pBlock->GetInputs())
 		{
@@ -25,11 +25,12 @@ public:
 	BlockHeaderPtr GetFlushedBlockHeader() const noexcept final { return m_pBlockHeaderBackup; }
 
 	bool IsValid(std::shared_ptr<const IBlockDB> pBlockDB, const Transaction& transaction) const final;
-	std::unique_ptr<BlockSums> ValidateTxHashSet(const BlockHeader& header, const IBlockChainServer& blockChainServer, SyncStatus& syncStatus) final;
+	std::unique_ptr<BlockSums> ValidateTxHashSet(const BlockHeader& header, const IBlockChainServer& blockChainServer, TaskPool& taskPool, SyncStatus& syncStatus) final;
 	bool ApplyBlock(std::shared_ptr<IBlockDB> pBlockDB, const FullBlock& block) final;
 	bool ValidateRoots(const BlockHeader& blockHeader) const final;
 	TxHashSetRoots GetRoots(const std::shared_ptr<const IBlockDB>& pBlockDB, const TransactionBody& body) final;
 	void SaveOutputPositions(const Chain::CPtr& pChain, std::shared_ptr<IBlockDB> pBlockDB) const final;
+	void SaveKernelPositions(const Chain::CPtr& pChain, std::shared_ptr<IBlockDB> pBlockDB) const final;
 
 	std::vector<Hash> GetLastKernelHashes(const uint64_t numberOfKernels) const final;
 	std::vector<Hash> GetLastOutputHashes(const uint64_t numberOfOutputs) const final;
@@ -11,10 +11,10 @@
 #include <Common/Util/HexUtil.h>
 #include <Infrastructure/Logger.h>
 #include <BlockChain/BlockChainServer.h>
-#include <thread>
+#include <Common/TaskPool.h>
 
-TxHashSetValidator::TxHashSetValidator(const IBlockChainServer& blockChainServer)
-	: m_blockChainServer(blockChainServer)
+TxHashSetValidator::TxHashSetValidator(const IBlockChainServer& blockChainServer, TaskPool& taskPool)
+	: m_blockChainServer(blockChainServer), m_taskPool(taskPool)
 {
 
 }
@@ -35,17 +35,17 @@ std::unique_ptr<BlockSums> TxHashSetValidator::Validate(TxHashSet& txHashSet, co
 	syncStatus.UpdateProcessingStatus(5);
 
 	// Validate MMR hashes in parallel
-	std::vector<std::thread> threads;
-	std::atomic_bool mmrHashesValidated = true;
-	threads.emplace_back(std::thread([this, pKernelMMR, &mmrHashesValidated] { if (!this->ValidateMMRHashes(pKernelMMR)) { mmrHashesValidated = false; }}));
-	threads.emplace_back(std::thread([this, pOutputPMMR, &mmrHashesValidated] { if (!this->ValidateMMRHashes(pOutputPMMR)) { mmrHashesValidated = false; }}));
-	threads.emplace_back(std::thread([this, pRangeProofPMMR, &mmrHashesValidated] { if (!this->ValidateMMRHashes(pRangeProofPMMR)) { mmrHashesValidated = false; }}));
+	std::vector<std::future<bool>> tasks;
+	tasks.push_back(m_taskPool.Submit(ETaskPriority::NORMAL, [this, pKernelMMR] { return this->ValidateMMRHashes(pKernelMMR); }));
+	tasks.push_back(m_taskPool.Submit(ETaskPriority::NORMAL, [this, pOutputPMMR] { return this->ValidateMMRHashes(pOutputPMMR); }));
+	tasks.push_back(m_taskPool.Submit(ETaskPriority::NORMAL, [this, pRangeProofPMMR] { return this->ValidateMMRHashes(pRangeProofPMMR); }));
 
-	for (auto& thread : threads)
+	bool mmrHashesValidated = true;
+	for (auto& task : tasks)
 	{
-		if (thread.joinable())
+		if (!m_taskPool.Await(task))
 		{
-			thread.join();
+			mmrHashesValidated = false;
 		}
 	}
 
@@ -243,8 +243,8 @@ BlockSums TxHashSetValidator::ValidateKernelSums(TxHashSet& txHashSet, const Blo
 
 	return KernelSumValidator::ValidateKernelSums(
 		std::vector<Commitment>(),
-		outputCommitments,
-		excessCommitments,
+		std::move(outputCommitments),
+		std::move(excessCommitments),
 		overage,
 		blockHeader.GetTotalKernelOffset(),
 		std::nullopt
@@ -253,6 +253,7 @@ BlockSums TxHashSetValidator::ValidateKernelSums(TxHashSet& txHashSet, const Blo
 
 bool TxHashSetValidator::ValidateRangeProofs(TxHashSet& txHashSet, SyncStatus& syncStatus) const
 {
+	// Every unspent output is verified once here, so caching them would only evict the mempool's entries.
 	std::vector<std::pair<Commitment, RangeProof>> rangeProofs;
 
 	size_t i = 0;
@@ -275,7 +276,7 @@ bool TxHashSetValidator::ValidateRangeProofs(TxHashSet& txHashSet, SyncStatus& s
 
 			if (rangeProofs.size() >= 1000)
 			{
-				if (!Crypto::VerifyRangeProofs(rangeProofs))
+				if (!Crypto::VerifyRangeProofs(rangeProofs, false))
 				{
 					return false;
 				}
@@ -289,7 +290,7 @@ bool TxHashSetValidator::ValidateRangeProofs(TxHashSet& txHashSet, SyncStatus& s
 
 	if (!rangeProofs.empty())
 	{
-		if (!Crypto::VerifyRangeProofs(rangeProofs))
+		if (!Crypto::VerifyRangeProofs(rangeProofs, false))
 		{
 			return false;
 		}
@@ -301,7 +302,12 @@ bool TxHashSetValidator::ValidateRangeProofs(TxHashSet& txHashSet, SyncStatus& s
 
 bool TxHashSetValidator::ValidateKernelSignatures(const KernelMMR& kernelMMR, SyncStatus& syncStatus) const
 {
+	// Each batch is split into chunks of about 2000 kernels, one per worker.
+	// Like the rangeproofs, these are only verified once, so they aren't added to the verified cache.
+	const size_t batchSize = 2000 * m_taskPool.GetNumThreads();
+
 	std::vector<TransactionKernel> kernels;
+	kernels.reserve(batchSize);
 
 	const uint64_t mmrSize = kernelMMR.GetSize();
 	for (uint64_t i = 0; i < mmrSize; i++)
@@ -311,9 +317,9 @@ bool TxHashSetValidator::ValidateKernelSignatures(const KernelMMR& kernelMMR, Sy
 		{
 			kernels.push_back(*pKernel);
 
-			if (kernels.size() >= 2000)
+			if (kernels.size() >= batchSize)
 			{
-				if (!KernelSignatureValidator::VerifyKernelSignatures(kernels))
+				if (!KernelSignatureValidator::VerifyKernelSignatures(kernels, m_taskPool, false))
 				{
 					return false;
 				}
@@ -327,7 +333,7 @@ bool TxHashSetValidator::ValidateKernelSignatures(const KernelMMR& kernelMMR, Sy
 
 	if (!kernels.empty())
 	{
-		if (!KernelSignatureValidator::VerifyKernelSignatures(kernels))
+		if (!KernelSignatureValidator::VerifyKernelSignatures(kernels, m_taskPool, false))
 		{
 			return false;
 		}
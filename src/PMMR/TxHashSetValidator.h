@@ -11,11 +11,12 @@ class KernelMMR;
 class IBlockChainServer;
 class MMR;
 class Commitment;
+class TaskPool;
 
 class TxHashSetValidator
 {
 public:
-	TxHashSetValidator(const IBlockChainServer& blockChainServer);
+	TxHashSetValidator(const IBlockChainServer& blockChainServer, TaskPool& taskPool);
 
 	std::unique_ptr<BlockSums> Validate(TxHashSet& txHashSet, const BlockHeader& blockHeader, SyncStatus& syncStatus) const;
 
@@ -29,4 +30,5 @@ private:
 	bool ValidateKernelSignatures(const KernelMMR& kernelMMR, SyncStatus& syncStatus) const;
 
 	const IBlockChainServer& m_blockChainServer;
+	TaskPool& m_taskPool;
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "DifficultyCalculator.h"
 #include "DifficultyLoader.h"
+#include "DifficultyWindowCache.h"
 
 #include <Consensus/BlockDifficulty.h>
 
@@ -32,9 +33,27 @@ HeaderInfo DifficultyCalculator::CalculateNextDifficulty(const BlockHeader& head
 	// DIFFICULTY_ADJUST_WINDOW + 1 (for initial block time bound)
 	const std::vector<HeaderInfo> difficultyData = DifficultyLoader(m_pBlockDB).LoadDifficultyData(header);
 
+	return CalculateNextDifficulty(header.GetHeight(), difficultyData);
+}
+
+HeaderInfo DifficultyCalculator::CalculateNextDifficulty(const BlockHeader& header, const BlockHeader& previousHeader) const
+{
+	if (header.GetPreviousBlockHash() != previousHeader.GetHash())
+	{
+		return CalculateNextDifficulty(header);
+	}
+
+	const DifficultyLoader loader(m_pBlockDB);
+	std::vector<HeaderInfo> window = DifficultyWindowCache::GetInstance().GetWindow(previousHeader, loader);
+
+	return CalculateNextDifficulty(header.GetHeight(), DifficultyLoader::PadDifficultyData(std::move(window)));
+}
+
+HeaderInfo DifficultyCalculator::CalculateNextDifficulty(const uint64_t height, const std::vector<HeaderInfo>& difficultyData) const
+{
 	// First, get the ratio of secondary PoW vs primary, skipping initial header
 	const std::vector<HeaderInfo> difficultyDataSkipFirst(difficultyData.cbegin() + 1, difficultyData.cend());
-	const uint64_t sec_pow_scaling = SecondaryPOWScaling(header.GetHeight(), difficultyDataSkipFirst);
+	const uint64_t sec_pow_scaling = SecondaryPOWScaling(height, difficultyDataSkipFirst);
 
 	// Get the timestamp delta across the window
 	const uint64_t ts_delta = difficultyData[DIFFICULTY_ADJUST_WINDOW].GetTimestamp() - difficultyData[0].GetTimestamp();
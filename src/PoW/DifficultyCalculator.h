@@ -12,7 +12,15 @@ public:
 
 	HeaderInfo CalculateNextDifficulty(const BlockHeader& blockHeader) const;
 
+	//
+	// Same as above, but reads the difficulty window from the DifficultyWindowCache,
+	// so when previousHeader's window (or its parent's) is cached, no headers are loaded from the db.
+	//
+	HeaderInfo CalculateNextDifficulty(const BlockHeader& blockHeader, const BlockHeader& previousHeader) const;
+
 private:
+	HeaderInfo CalculateNextDifficulty(const uint64_t height, const std::vector<HeaderInfo>& difficultyData) const;
+
 	uint64_t ARCount(const std::vector<HeaderInfo>& difficultyData) const;
 	uint64_t ScalingFactorSum(const std::vector<HeaderInfo>& difficultyData) const;
 	uint32_t SecondaryPOWScaling(const uint64_t height, const std::vector<HeaderInfo>& difficultyData) const;
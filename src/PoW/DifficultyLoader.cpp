@@ -9,12 +9,24 @@ DifficultyLoader::DifficultyLoader(std::shared_ptr<const IBlockDB> pBlockDB)
 }
 
 std::vector<HeaderInfo> DifficultyLoader::LoadDifficultyData(const BlockHeader& header) const
+{
+	BlockHeaderPtr pPreviousHeader = LoadHeader(header.GetPreviousBlockHash());
+	if (pPreviousHeader == nullptr)
+	{
+		return PadDifficultyData(std::vector<HeaderInfo>());
+	}
+
+	return PadDifficultyData(LoadWindow(*pPreviousHeader));
+}
+
+std::vector<HeaderInfo> DifficultyLoader::LoadWindow(const BlockHeader& tipHeader) const
 {
 	const size_t numBlocksNeeded = Consensus::DIFFICULTY_ADJUST_WINDOW + 1;
 	std::vector<HeaderInfo> difficultyData;
 	difficultyData.reserve(numBlocksNeeded);
 
-	BlockHeaderPtr pHeader = LoadHeader(header.GetPreviousBlockHash());
+	const BlockHeader* pHeader = &tipHeader;
+	BlockHeaderPtr pPreviousHeader = nullptr;
 	while (difficultyData.size() < numBlocksNeeded && pHeader != nullptr)
 	{
 		const int64_t timestamp = pHeader->GetTimestamp();
@@ -22,10 +34,10 @@ std::vector<HeaderInfo> DifficultyLoader::LoadDifficultyData(const BlockHeader&
 		const uint32_t scalingFactor = pHeader->GetScalingDifficulty();
 		const bool secondary = pHeader->GetProofOfWork().IsSecondary();
 
-		pHeader = LoadHeader(pHeader->GetPreviousBlockHash());
-		if (pHeader != nullptr)
+		pPreviousHeader = LoadHeader(pHeader->GetPreviousBlockHash());
+		if (pPreviousHeader != nullptr)
 		{
-			const uint64_t difficulty = totalDifficulty - pHeader->GetTotalDifficulty();
+			const uint64_t difficulty = totalDifficulty - pPreviousHeader->GetTotalDifficulty();
 
 			difficultyData.emplace_back(HeaderInfo(timestamp, difficulty, scalingFactor, secondary));
 		}
@@ -33,9 +45,11 @@ std::vector<HeaderInfo> DifficultyLoader::LoadDifficultyData(const BlockHeader&
 		{
 			difficultyData.emplace_back(HeaderInfo(timestamp, totalDifficulty, scalingFactor, secondary));
 		}
+
+		pHeader = pPreviousHeader.get();
 	}
 
-	return PadDifficultyData(difficultyData);
+	return difficultyData;
 }
 
 BlockHeaderPtr DifficultyLoader::LoadHeader(const Hash& headerHash) const
@@ -46,7 +60,7 @@ BlockHeaderPtr DifficultyLoader::LoadHeader(const Hash& headerHash) const
 // Converts an iterator of block difficulty data to more a more manageable
 // vector and pads if needed (which will) only be needed for the first few
 // blocks after genesis
-std::vector<HeaderInfo> DifficultyLoader::PadDifficultyData(std::vector<HeaderInfo>& difficultyData) const
+std::vector<HeaderInfo> DifficultyLoader::PadDifficultyData(std::vector<HeaderInfo>&& difficultyData)
 {
 	// Only needed just after blockchain launch... basically ensures there's
 	// always enough data by simulating perfectly timed pre-genesis
@@ -74,5 +88,5 @@ std::vector<HeaderInfo> DifficultyLoader::PadDifficultyData(std::vector<HeaderIn
 
 	std::reverse(difficultyData.begin(), difficultyData.end());
 
-	return difficultyData;
+	return std::move(difficultyData);
 }
\ No newline at end of file
@@ -13,9 +13,15 @@ public:
 
 	std::vector<HeaderInfo> LoadDifficultyData(const BlockHeader& header) const;
 
+	//
+	// Loads the difficulty window ending at (and including) tipHeader, ordered from latest to earliest, without padding.
+	//
+	std::vector<HeaderInfo> LoadWindow(const BlockHeader& tipHeader) const;
+
+	static std::vector<HeaderInfo> PadDifficultyData(std::vector<HeaderInfo>&& difficultyData);
+
 private:
 	BlockHeaderPtr LoadHeader(const Hash& headerHash) const;
-	std::vector<HeaderInfo> PadDifficultyData(std::vector<HeaderInfo>& difficultyData) const;
 
 	std::shared_ptr<const IBlockDB> m_pBlockDB;
 };
\ No newline at end of file
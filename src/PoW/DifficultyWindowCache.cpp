@@ -0,0 +1,101 @@
+#include "DifficultyWindowCache.h"
+
+#include <Consensus/BlockDifficulty.h>
+
+DifficultyWindowCache& DifficultyWindowCache::GetInstance()
+{
+	static DifficultyWindowCache instance;
+	return instance;
+}
+
+DifficultyWindowCache::DifficultyWindowCache()
+	: m_hits(MetricsAPI::GetCounter("pow.difficulty_window.hits")),
+	m_extends(MetricsAPI::GetCounter("pow.difficulty_window.extends")),
+	m_rebuilds(MetricsAPI::GetCounter("pow.difficulty_window.rebuilds"))
+{
+
+}
+
+std::vector<HeaderInfo> DifficultyWindowCache::GetWindow(const BlockHeader& tipHeader, const DifficultyLoader& loader)
+{
+	const size_t numBlocksNeeded = Consensus::DIFFICULTY_ADJUST_WINDOW + 1;
+
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		for (auto iter = m_windows.begin(); iter != m_windows.end(); iter++)
+		{
+			if (iter->tipHash == tipHeader.GetHash())
+			{
+				m_hits.Increment();
+				m_windows.splice(m_windows.begin(), m_windows, iter);
+				return m_windows.front().entries;
+			}
+		}
+
+		for (auto iter = m_windows.begin(); iter != m_windows.end(); iter++)
+		{
+			if (iter->tipHash == tipHeader.GetPreviousHash())
+			{
+				m_extends.Increment();
+
+				Window window = *iter;
+				window.entries.insert(window.entries.begin(), HeaderInfo(
+					tipHeader.GetTimestamp(),
+					tipHeader.GetTotalDifficulty() - window.tipTotalDifficulty,
+					tipHeader.GetScalingDifficulty(),
+					tipHeader.GetProofOfWork().IsSecondary()
+				));
+				if (window.entries.size() > numBlocksNeeded)
+				{
+					window.entries.pop_back();
+				}
+
+				window.tipHash = tipHeader.GetHash();
+				window.tipTotalDifficulty = tipHeader.GetTotalDifficulty();
+
+				std::vector<HeaderInfo> entries = window.entries;
+				Store(std::move(window));
+				return entries;
+			}
+		}
+	}
+
+	// Fork point (or cold cache) - rebuild the window from the database, without holding the lock.
+	m_rebuilds.Increment();
+	std::vector<HeaderInfo> entries = loader.LoadWindow(tipHeader);
+
+	// Only cache windows that were fully loaded. A window can be short when an ancestor is missing from the db.
+	if (IsComplete(tipHeader, entries))
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		Store(Window{ tipHeader.GetHash(), tipHeader.GetTotalDifficulty(), entries });
+	}
+
+	return entries;
+}
+
+bool DifficultyWindowCache::IsComplete(const BlockHeader& tipHeader, const std::vector<HeaderInfo>& entries) const
+{
+	const size_t numBlocksNeeded = Consensus::DIFFICULTY_ADJUST_WINDOW + 1;
+
+	return entries.size() == numBlocksNeeded || entries.size() == (tipHeader.GetHeight() + 1);
+}
+
+void DifficultyWindowCache::Store(Window&& window)
+{
+	for (auto iter = m_windows.begin(); iter != m_windows.end(); iter++)
+	{
+		if (iter->tipHash == window.tipHash)
+		{
+			m_windows.erase(iter);
+			break;
+		}
+	}
+
+	m_windows.push_front(std::move(window));
+	if (m_windows.size() > MAX_WINDOWS)
+	{
+		m_windows.pop_back();
+	}
+}
\ No newline at end of file
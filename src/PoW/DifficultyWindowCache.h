@@ -0,0 +1,53 @@
+#pragma once
+
+#include "HeaderInfo.h"
+#include "DifficultyLoader.h"
+
+#include <Core/Models/BlockHeader.h>
+#include <Crypto/Hash.h>
+#include <Infrastructure/Metrics.h>
+#include <list>
+#include <mutex>
+#include <vector>
+
+//
+// Caches the difficulty window (the DIFFICULTY_ADJUST_WINDOW + 1 most recent HeaderInfos) for recently seen chain tips.
+//
+// Since a header's hash commits to its entire ancestry, a window is identified solely by the hash of its tip,
+// and never needs to be invalidated. When the window for a header's parent is cached, the header's window
+// is derived by dropping the oldest entry and appending the header, so walking a chain (eg. during header sync)
+// costs no database reads. Windows are only rebuilt from the database at fork points, or after eviction.
+//
+class DifficultyWindowCache
+{
+public:
+	static DifficultyWindowCache& GetInstance();
+
+	//
+	// Returns the window ending at (and including) tipHeader, ordered from latest to earliest, without padding.
+	//
+	std::vector<HeaderInfo> GetWindow(const BlockHeader& tipHeader, const DifficultyLoader& loader);
+
+private:
+	DifficultyWindowCache();
+
+	struct Window
+	{
+		Hash tipHash;
+		uint64_t tipTotalDifficulty;
+		std::vector<HeaderInfo> entries; // Latest to earliest
+	};
+
+	bool IsComplete(const BlockHeader& tipHeader, const std::vector<HeaderInfo>& entries) const;
+	void Store(Window&& window);
+
+	// Enough windows to follow a handful of competing forks without thrashing.
+	static const size_t MAX_WINDOWS = 8;
+
+	std::mutex m_mutex;
+	std::list<Window> m_windows; // Most recently used first
+
+	Metrics::Counter& m_hits;
+	Metrics::Counter& m_extends;
+	Metrics::Counter& m_rebuilds;
+};
\ No newline at end of file
@@ -16,4 +16,24 @@ bool PoWManager::IsPoWValid(const BlockHeader& header, const BlockHeader& previo
 	}
 
 	return PoWValidator(m_config, m_pBlockDB).IsPoWValid(header, previousHeader);
+}
+
+bool PoWManager::IsDifficultyValid(const BlockHeader& header, const BlockHeader& previousHeader) const
+{
+	if (m_config.GetEnvironment().IsAutomatedTesting())
+	{
+		return true;
+	}
+
+	return PoWValidator(m_config, m_pBlockDB).IsDifficultyValid(header, previousHeader);
+}
+
+bool PoWManager::IsProofValid(const Config& config, const BlockHeader& header)
+{
+	if (config.GetEnvironment().IsAutomatedTesting())
+	{
+		return true;
+	}
+
+	return PoWValidator::IsProofValid(config, header);
 }
\ No newline at end of file
@@ -17,6 +17,11 @@ PoWValidator::PoWValidator(const Config& config, std::shared_ptr<const IBlockDB>
 }
 
 bool PoWValidator::IsPoWValid(const BlockHeader& header, const BlockHeader& previousHeader) const
+{
+	return IsDifficultyValid(header, previousHeader) && IsProofValid(m_config, header);
+}
+
+bool PoWValidator::IsDifficultyValid(const BlockHeader& header, const BlockHeader& previousHeader) const
 {
 	// Validate Total Difficulty
 	if (header.GetTotalDifficulty() <= previousHeader.GetTotalDifficulty())
@@ -33,7 +38,7 @@ bool PoWValidator::IsPoWValid(const BlockHeader& header, const BlockHeader& prev
 	}
 
 	// Explicit check to ensure total_difficulty has increased by exactly the _network_ difficulty of the previous block.
-	const HeaderInfo nextHeaderInfo = DifficultyCalculator(m_pBlockDB).CalculateNextDifficulty(header);
+	const HeaderInfo nextHeaderInfo = DifficultyCalculator(m_pBlockDB).CalculateNextDifficulty(header, previousHeader);
 	if (targetDifficulty != nextHeaderInfo.GetDifficulty())
 	{
 		LOG_WARNING_F("Target difficulty invalid for block {} with previous block {}", header, previousHeader);
@@ -47,8 +52,13 @@ bool PoWValidator::IsPoWValid(const BlockHeader& header, const BlockHeader& prev
 		return false;
 	}
 
+	return true;
+}
+
+bool PoWValidator::IsProofValid(const Config& config, const BlockHeader& header)
+{
 	const ProofOfWork& proofOfWork = header.GetProofOfWork();
-	const EPoWType powType = PoWUtil(m_config).DeterminePoWType(header.GetVersion(), proofOfWork.GetEdgeBits());
+	const EPoWType powType = PoWUtil(config).DeterminePoWType(header.GetVersion(), proofOfWork.GetEdgeBits());
 	if (powType == EPoWType::CUCKAROO)
 	{
 		return Cuckaroo::Validate(header);
@@ -10,6 +10,8 @@ public:
 	PoWValidator(const Config& config, std::shared_ptr<const IBlockDB> pBlockDB);
 
 	bool IsPoWValid(const BlockHeader& header, const BlockHeader& previousHeader) const;
+	bool IsDifficultyValid(const BlockHeader& header, const BlockHeader& previousHeader) const;
+	static bool IsProofValid(const Config& config, const BlockHeader& header);
 
 private:
 	uint64_t GetMaximumDifficulty(const BlockHeader& header) const;
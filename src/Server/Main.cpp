@@ -1,10 +1,12 @@
 #include "Node/NodeDaemon.h"
+#include "Node/NodeBootstrap.h"
 #include "Wallet/WalletDaemon.h"
 #include "civetweb/include/civetweb.h"
 
 #include <Core/Context.h>
 #include <Wallet/WalletManager.h>
 #include <Config/ConfigLoader.h>
+#include <Crypto/Crypto.h>
 #include <Infrastructure/ShutdownManager.h>
 #include <Infrastructure/ThreadManager.h>
 #include <Infrastructure/Logger.h>
@@ -33,6 +35,9 @@ int main(int argc, char* argv[])
 
 	EEnvironmentType environment = EEnvironmentType::MAINNET;
 	bool headless = false;
+	std::string exportPath;
+	std::string importPath;
+	std::string replayPath;
 	for (int i = 0; i < argc; ++i)
 	{
 		if (std::string(argv[i]) == "--floonet")
@@ -43,6 +48,26 @@ int main(int argc, char* argv[])
 		{
 			headless = true;
 		}
+		if (std::string(argv[i]) == "--export-bootstrap" && i + 1 < argc)
+		{
+			exportPath = argv[++i];
+		}
+		if (std::string(argv[i]) == "--import-bootstrap" && i + 1 < argc)
+		{
+			importPath = argv[++i];
+		}
+		// --replay-chain <dir>: Replays the configured node's chain into an empty data directory.
+		// The configured node is opened as on a regular start (including its startup maintenance), so it must not be running.
+		if (std::string(argv[i]) == "--replay-chain" && i + 1 < argc)
+		{
+			replayPath = argv[++i];
+		}
+	}
+
+	// Bootstrap modes run offline and exit, so there's no display.
+	if (!exportPath.empty() || !importPath.empty() || !replayPath.empty())
+	{
+		headless = true;
 	}
 
 	if (!headless)
@@ -77,15 +102,34 @@ int main(int argc, char* argv[])
 		throw;
 	}
 
+	const NodeConfig& nodeConfig = pConfig->GetNodeConfig();
+	Crypto::ConfigureScratchSpace(nodeConfig.GetScratchSpaceSize(), nodeConfig.GetScratchRetainSize());
+	Crypto::ConfigureVerifiedCache(nodeConfig.GetVerifiedCacheSize());
+
 	try
 	{
 		LOG_INFO("Starting Grin++");
 
-		mg_init_library(0);
+		if (!exportPath.empty())
+		{
+			NodeBootstrap::Export(pConfig, fs::u8path(exportPath));
+		}
+		else if (!importPath.empty())
+		{
+			NodeBootstrap::Import(pConfig, fs::u8path(importPath));
+		}
+		else if (!replayPath.empty())
+		{
+			NodeBootstrap::Replay(pConfig, fs::u8path(replayPath));
+		}
+		else
+		{
+			mg_init_library(0);
 
-		StartServer(pConfig, headless);
+			StartServer(pConfig, headless);
 
-		mg_exit_library();
+			mg_exit_library();
+		}
 
 		LOG_INFO("Closing Grin++");
 	}
@@ -175,4 +175,105 @@ int ChainAPI::GetChainOutputsByIds_Handler(struct mg_connection* conn, void* pNo
 		LOG_ERROR_F("Exception thrown: {}", e.what());
 		return HTTPUtil::BuildBadRequestResponse(conn, "Expected /v1/txhashset/outputs?start_index=1&max=100");
 	}
+}
+
+//
+// Handles requests to retrieve a confirmed kernel by its excess commitment.
+//
+// APIs:
+// GET /v1/chain/kernels/<excess commit>
+//
+int ChainAPI::GetChainKernelByExcess_Handler(struct mg_connection* conn, void* pNodeContext)
+{
+	IBlockChainServerPtr pBlockChainServer = ((NodeContext*)pNodeContext)->m_pBlockChainServer;
+
+	try
+	{
+		const std::string requestedExcess = HTTPUtil::GetURIParam(conn, "/v1/chain/kernels/");
+		const Commitment excessCommitment = Commitment::FromHex(requestedExcess);
+
+		std::unique_ptr<KernelLocation> pKernelLocation = pBlockChainServer->GetKernelLocation(excessCommitment);
+		if (pKernelLocation == nullptr)
+		{
+			return HTTPUtil::BuildNotFoundResponse(conn, "Kernel not found.");
+		}
+
+		Json::Value kernelNode;
+		kernelNode["height"] = pKernelLocation->GetBlockHeight();
+		kernelNode["mmr_index"] = pKernelLocation->GetMMRIndex() + 1;
+
+		std::unique_ptr<FullBlock> pBlock = pBlockChainServer->GetBlockByHeight(pKernelLocation->GetBlockHeight());
+		if (pBlock != nullptr)
+		{
+			for (const TransactionKernel& kernel : pBlock->GetKernels())
+			{
+				if (kernel.GetExcessCommitment() == excessCommitment)
+				{
+					kernelNode["tx_kernel"] = kernel.ToJSON();
+					break;
+				}
+			}
+		}
+
+		return HTTPUtil::BuildSuccessResponse(conn, kernelNode.toStyledString());
+	}
+	catch (std::exception& e)
+	{
+		LOG_ERROR_F("Exception thrown: {}", e.what());
+		return HTTPUtil::BuildBadRequestResponse(conn, "Expected /v1/chain/kernels/<excess commitment>");
+	}
+}
+
+//
+// Handles requests to retrieve the lifetime of an output (archive mode required for spent outputs).
+//
+// APIs:
+// GET /v1/chain/outputs/history/<output commit>
+//
+int ChainAPI::GetChainOutputHistory_Handler(struct mg_connection* conn, void* pNodeContext)
+{
+	IBlockChainServerPtr pBlockChainServer = ((NodeContext*)pNodeContext)->m_pBlockChainServer;
+
+	try
+	{
+		const std::string requestedCommitment = HTTPUtil::GetURIParam(conn, "/v1/chain/outputs/history/");
+		const Commitment outputCommitment = Commitment::FromHex(requestedCommitment);
+
+		std::unique_ptr<OutputHistory> pHistory = pBlockChainServer->GetOutputHistory(outputCommitment);
+		if (pHistory == nullptr)
+		{
+			return HTTPUtil::BuildNotFoundResponse(conn, "Output not found.");
+		}
+
+		Json::Value historyNode;
+		historyNode["commit"] = outputCommitment.ToHex();
+		historyNode["mmr_index"] = pHistory->GetMMRIndex() + 1;
+		historyNode["height"] = pHistory->GetCreatedHeight();
+
+		std::unique_ptr<Hash> pCreatedHash = pBlockChainServer->GetArchivedBlockHash(pHistory->GetCreatedHeight());
+		if (pCreatedHash != nullptr)
+		{
+			historyNode["block_hash"] = pCreatedHash->ToHex();
+		}
+
+		historyNode["spent"] = pHistory->IsSpent();
+		if (pHistory->IsSpent())
+		{
+			const uint64_t spentHeight = pHistory->GetSpentHeight().value();
+			historyNode["spent_height"] = spentHeight;
+
+			std::unique_ptr<Hash> pSpentHash = pBlockChainServer->GetArchivedBlockHash(spentHeight);
+			if (pSpentHash != nullptr)
+			{
+				historyNode["spent_block_hash"] = pSpentHash->ToHex();
+			}
+		}
+
+		return HTTPUtil::BuildSuccessResponse(conn, historyNode.toStyledString());
+	}
+	catch (std::exception& e)
+	{
+		LOG_ERROR_F("Exception thrown: {}", e.what());
+		return HTTPUtil::BuildBadRequestResponse(conn, "Expected /v1/chain/outputs/history/<output commitment>");
+	}
 }
\ No newline at end of file
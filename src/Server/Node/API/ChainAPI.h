@@ -8,4 +8,6 @@ public:
 	static int GetChain_Handler(struct mg_connection* conn, void* pNodeContext);
 	static int GetChainOutputsByHeight_Handler(struct mg_connection* conn, void* pNodeContext);
 	static int GetChainOutputsByIds_Handler(struct mg_connection* conn, void* pNodeContext);
+	static int GetChainKernelByExcess_Handler(struct mg_connection* conn, void* pNodeContext);
+	static int GetChainOutputHistory_Handler(struct mg_connection* conn, void* pNodeContext);
 };
\ No newline at end of file
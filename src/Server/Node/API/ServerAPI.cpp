@@ -3,6 +3,7 @@
 
 #include <Net/Util/HTTPUtil.h>
 #include <P2P/Common.h>
+#include <Infrastructure/Metrics.h>
 #include <json/json.h>
 
 /*
@@ -33,6 +34,8 @@ int ServerAPI::V1_Handler(struct mg_connection* conn, void*)
 		json.append("GET /v1/chain/");
 		json.append("GET /v1/chain/outputs/byids?id=xxx,yyy&id=zzz");
 		json.append("GET /v1/chain/outputs/byheight?start_height=100&end_height=200");
+		json.append("GET /v1/chain/outputs/history/<output commit>");
+		json.append("GET /v1/chain/kernels/<excess commit>");
 		json.append("GET /v1/peers/all");
 		json.append("GET /v1/peers/connected");
 		json.append("GET /v1/peers/a.b.c.d");
@@ -43,6 +46,7 @@ int ServerAPI::V1_Handler(struct mg_connection* conn, void*)
 		json.append("GET /v1/txhashset/lastoutputs?n=###");
 		json.append("GET /v1/txhashset/lastrangeproofs?n=###");
 		json.append("GET /v1/txhashset/outputs?start_index=1&max=100");
+		json.append("GET /v1/metrics");
 
 		return HTTPUtil::BuildSuccessResponse(conn, json.toStyledString());
 	}
@@ -139,4 +143,41 @@ int ServerAPI::ResyncChain_Handler(struct mg_connection* conn, void* pNodeContex
 	pServer->m_pP2PServer->UnbanAllPeers();
 
 	return HTTPUtil::BuildSuccessResponse(conn, "");
+}
+
+int ServerAPI::GetMetrics_Handler(struct mg_connection* conn, void*)
+{
+	Json::Value metricsNode;
+
+	// Gauges first, since fetching them runs the collectors.
+	Json::Value gaugesNode(Json::objectValue);
+	for (const auto& gauge : MetricsAPI::GetGauges())
+	{
+		gaugesNode[gauge.first] = Json::Int64(gauge.second);
+	}
+	metricsNode["gauges"] = gaugesNode;
+
+	Json::Value countersNode(Json::objectValue);
+	for (const auto& counter : MetricsAPI::GetCounters())
+	{
+		countersNode[counter.first] = Json::UInt64(counter.second);
+	}
+	metricsNode["counters"] = countersNode;
+
+	Json::Value histogramsNode(Json::objectValue);
+	for (const auto& histogram : MetricsAPI::GetHistograms())
+	{
+		const Metrics::HistogramSnapshot& snapshot = histogram.second;
+
+		Json::Value histogramNode;
+		histogramNode["count"] = Json::UInt64(snapshot.count);
+		histogramNode["mean_micros"] = Json::UInt64(snapshot.Mean());
+		histogramNode["p50_micros"] = Json::UInt64(snapshot.p50);
+		histogramNode["p99_micros"] = Json::UInt64(snapshot.p99);
+		histogramNode["max_micros"] = Json::UInt64(snapshot.max);
+		histogramsNode[histogram.first] = histogramNode;
+	}
+	metricsNode["histograms"] = histogramsNode;
+
+	return HTTPUtil::BuildSuccessResponse(conn, metricsNode.toStyledString());
 }
\ No newline at end of file
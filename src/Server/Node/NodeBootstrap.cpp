@@ -0,0 +1,117 @@
+#include "NodeBootstrap.h"
+
+#include <Database/Database.h>
+#include <PMMR/TxHashSetManager.h>
+#include <TxPool/TransactionPool.h>
+#include <Infrastructure/Logger.h>
+#include <Infrastructure/Metrics.h>
+#include <Common/Util/FileUtil.h>
+#include <Core/Exceptions/FileException.h>
+#include <iostream>
+#include <chrono>
+#include <sstream>
+
+using namespace std::chrono;
+
+void NodeBootstrap::Export(const ConfigPtr& pConfig, const fs::path& path)
+{
+	TaskPool::Ptr pTaskPool = TaskPool::Create();
+	IBlockChainServerPtr pBlockChainServer = OpenBlockChain(pConfig, pTaskPool);
+
+	const auto start = steady_clock::now();
+	const uint64_t numBlocks = pBlockChainServer->ExportBootstrap(path);
+	const auto elapsed = duration_cast<milliseconds>(steady_clock::now() - start).count();
+
+	LOG_INFO_F("Exported {} blocks in {}ms", numBlocks, elapsed);
+	std::cout << "Exported " << numBlocks << " blocks to " << path.u8string() << " in " << elapsed << "ms" << std::endl;
+
+	pBlockChainServer.reset();
+	pTaskPool->Shutdown();
+}
+
+void NodeBootstrap::Import(const ConfigPtr& pConfig, const fs::path& path)
+{
+	TaskPool::Ptr pTaskPool = TaskPool::Create();
+	IBlockChainServerPtr pBlockChainServer = OpenBlockChain(pConfig, pTaskPool);
+
+	const Metrics::ProcessStats statsBefore = MetricsAPI::GetProcessStats();
+	const auto start = steady_clock::now();
+	const uint64_t numBlocks = pBlockChainServer->ImportBootstrap(path);
+	PrintReport("Imported", numBlocks, steady_clock::now() - start, statsBefore);
+
+	pBlockChainServer.reset();
+	pTaskPool->Shutdown();
+}
+
+void NodeBootstrap::Replay(const ConfigPtr& pConfig, const fs::path& targetDir)
+{
+	if (fs::exists(targetDir) && !fs::is_empty(targetDir))
+	{
+		throw FILE_EXCEPTION_F("Replay directory {} must be empty", targetDir);
+	}
+
+	Json::Value targetJSON = pConfig->GetJSON();
+	targetJSON[ConfigProps::DATA_PATH] = targetDir.u8string();
+	ConfigPtr pTargetConfig = Config::Load(targetJSON, pConfig->GetEnvironment().GetEnvironmentType());
+
+	TaskPool::Ptr pTaskPool = TaskPool::Create();
+	IBlockChainServerPtr pSource = OpenBlockChain(pConfig, pTaskPool);
+	IBlockChainServerPtr pTarget = OpenBlockChain(pTargetConfig, pTaskPool);
+
+	const Metrics::ProcessStats statsBefore = MetricsAPI::GetProcessStats();
+	const auto start = steady_clock::now();
+	const uint64_t numBlocks = pTarget->ReplayChain(*pSource);
+	PrintReport("Replayed", numBlocks, steady_clock::now() - start, statsBefore);
+
+	pTarget.reset();
+	pSource.reset();
+	pTaskPool->Shutdown();
+}
+
+void NodeBootstrap::PrintReport(
+	const std::string& action,
+	const uint64_t numBlocks,
+	const steady_clock::duration elapsed,
+	const Metrics::ProcessStats& statsBefore)
+{
+	const uint64_t elapsedMs = (uint64_t)duration_cast<milliseconds>(elapsed).count();
+	const uint64_t blocksPerSecond = elapsedMs > 0 ? (numBlocks * 1000) / elapsedMs : numBlocks;
+	const Metrics::ProcessStats statsAfter = MetricsAPI::GetProcessStats();
+
+	std::ostringstream report;
+	report << action << " " << numBlocks << " blocks in " << elapsedMs << "ms (" << blocksPerSecond << " blocks/s)" << std::endl;
+	report << "I/O: read=" << (statsAfter.readBytes - statsBefore.readBytes) / 1024 << "KiB";
+	report << " written=" << (statsAfter.writeBytes - statsBefore.writeBytes) / 1024 << "KiB" << std::endl;
+	report << "Peak memory: " << statsAfter.peakMemoryBytes / (1024 * 1024) << "MiB" << std::endl;
+
+	// Histograms are in microseconds. Stages are listed by total time, since that's what bounds throughput.
+	for (const auto& histogram : MetricsAPI::GetHistograms())
+	{
+		const bool isStage = histogram.first.rfind("block.import.", 0) == 0 || histogram.first.rfind("block.process.", 0) == 0;
+		if (isStage && histogram.second.count > 0)
+		{
+			report << "  " << histogram.first << ": total=" << histogram.second.sum / 1000 << "ms";
+			report << " mean=" << histogram.second.Mean() << "us p99=" << histogram.second.p99 << "us" << std::endl;
+		}
+	}
+
+	LOG_INFO(report.str());
+	std::cout << report.str() << std::flush;
+}
+
+IBlockChainServerPtr NodeBootstrap::OpenBlockChain(const ConfigPtr& pConfig, const TaskPool::Ptr& pTaskPool)
+{
+	auto pDatabase = DatabaseAPI::OpenDatabase(*pConfig);
+	auto pTxHashSetManager = std::make_shared<Locked<TxHashSetManager>>(std::make_shared<TxHashSetManager>(*pConfig));
+	auto pTransactionPool = TxPoolAPI::CreateTransactionPool(*pConfig);
+	auto pHeaderMMR = HeaderMMRAPI::OpenHeaderMMR(*pConfig);
+
+	return BlockChainAPI::StartBlockChainServer(
+		*pConfig,
+		pDatabase->GetBlockDB(),
+		pTxHashSetManager,
+		pTransactionPool,
+		pHeaderMMR,
+		pTaskPool
+	);
+}
\ No newline at end of file
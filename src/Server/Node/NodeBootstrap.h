@@ -0,0 +1,39 @@
+#pragma once
+
+#include <Config/Config.h>
+#include <BlockChain/BlockChainServer.h>
+#include <Common/TaskPool.h>
+#include <Infrastructure/Metrics.h>
+#include <chrono>
+#include <string>
+#include <filesystem.h>
+
+//
+// Runs the node offline (without P2P or the REST servers) to export the confirmed chain to a bootstrap file,
+// to import one, or to replay the stored chain into a fresh data directory.
+// Import and replay report blocks/s, per-stage times, I/O and peak memory, which gives a reproducible way
+// to measure block processing without the network.
+//
+class NodeBootstrap
+{
+public:
+	static void Export(const ConfigPtr& pConfig, const fs::path& path);
+	static void Import(const ConfigPtr& pConfig, const fs::path& path);
+
+	//
+	// Validates and applies every block of the configured node's confirmed chain to a new chain state in targetDir,
+	// through the same BlockProcessor path used when syncing.
+	// The configured node is opened like a regular start, so its startup maintenance still runs (eg. the version
+	// migration and TxHashSet compaction). Replay itself doesn't change its chain. Stop the node before replaying it.
+	//
+	static void Replay(const ConfigPtr& pConfig, const fs::path& targetDir);
+
+private:
+	static void PrintReport(
+		const std::string& action,
+		const uint64_t numBlocks,
+		const std::chrono::steady_clock::duration elapsed,
+		const Metrics::ProcessStats& statsBefore
+	);
+	static IBlockChainServerPtr OpenBlockChain(const ConfigPtr& pConfig, const TaskPool::Ptr& pTaskPool);
+};
\ No newline at end of file
@@ -39,7 +39,8 @@ public:
 			pDatabase->GetBlockDB(),
 			pLockedTxHashSetManager,
 			pTransactionPool,
-			pHeaderMMR
+			pHeaderMMR,
+			pContext->GetTaskPool()
 		);
 		auto pP2PServer = P2PAPI::StartP2PServer(
 			pContext,
@@ -90,6 +91,11 @@ public:
 		return outputs;
 	}
 
+	std::unique_ptr<KernelLocation> GetKernelByExcess(const Commitment& excessCommitment) const final
+	{
+		return m_pBlockChainServer->GetKernelLocation(excessCommitment);
+	}
+
 	std::vector<BlockWithOutputs> GetBlockOutputs(const uint64_t startHeight, const uint64_t maxHeight) const final
 	{
 		return m_pBlockChainServer->GetOutputsByHeight(startHeight, maxHeight);
@@ -9,6 +9,7 @@
 #include <Consensus/BlockDifficulty.h>
 #include <Database/Database.h>
 #include <Infrastructure/Logger.h>
+#include <Infrastructure/Metrics.h>
 #include <PMMR/TxHashSetManager.h>
 
 #include <iostream>
@@ -24,12 +25,15 @@ NodeDaemon::NodeDaemon(
 	m_pNodeClient(pNodeClient),
 	m_pGrinJoinController(std::move(pGrinJoinController))
 {
-
+	m_metricsTaskId = m_pContext->GetTaskPool()->ScheduleInterval(std::chrono::minutes(5), ETaskPriority::LOW, []() {
+		MetricsAPI::LogSummary();
+	});
 }
 
 NodeDaemon::~NodeDaemon()
 {
 	LOG_INFO("Shutting down node daemon");
+	m_pContext->GetTaskPool()->CancelInterval(m_metricsTaskId);
 }
 
 std::unique_ptr<NodeDaemon> NodeDaemon::Create(const Context::Ptr& pContext)
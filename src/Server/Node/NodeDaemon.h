@@ -35,4 +35,5 @@ private:
 	std::unique_ptr<NodeRestServer> m_pNodeRestServer;
 	std::shared_ptr<DefaultNodeClient> m_pNodeClient;
 	std::unique_ptr<GrinJoinController> m_pGrinJoinController;
+	uint64_t m_metricsTaskId;
 };
\ No newline at end of file
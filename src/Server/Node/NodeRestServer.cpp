@@ -34,6 +34,8 @@ std::unique_ptr<NodeRestServer> NodeRestServer::Create(const Config& config, std
 	pServer->AddListener("/v1/blocks/", BlockAPI::GetBlock_Handler, pNodeContext.get());
 	pServer->AddListener("/v1/chain/outputs/byids", ChainAPI::GetChainOutputsByIds_Handler, pNodeContext.get());
 	pServer->AddListener("/v1/chain/outputs/byheight", ChainAPI::GetChainOutputsByHeight_Handler, pNodeContext.get());
+	pServer->AddListener("/v1/chain/outputs/history/", ChainAPI::GetChainOutputHistory_Handler, pNodeContext.get());
+	pServer->AddListener("/v1/chain/kernels/", ChainAPI::GetChainKernelByExcess_Handler, pNodeContext.get());
 	pServer->AddListener("/v1/chain", ChainAPI::GetChain_Handler, pNodeContext.get());
 	pServer->AddListener("/v1/peers/all", PeersAPI::GetAllPeers_Handler, pNodeContext.get());
 	pServer->AddListener("/v1/peers/connected", PeersAPI::GetConnectedPeers_Handler, pNodeContext.get());
@@ -43,6 +45,7 @@ std::unique_ptr<NodeRestServer> NodeRestServer::Create(const Config& config, std
 	pServer->AddListener("/v1/txhashset/lastoutputs", TxHashSetAPI::GetLastOutputs_Handler, pNodeContext.get());
 	pServer->AddListener("/v1/txhashset/lastrangeproofs", TxHashSetAPI::GetLastRangeproofs_Handler, pNodeContext.get());
 	pServer->AddListener("/v1/txhashset/outputs", TxHashSetAPI::GetOutputs_Handler, pNodeContext.get());
+	pServer->AddListener("/v1/metrics", ServerAPI::GetMetrics_Handler, pNodeContext.get());
 	pServer->AddListener("/v1/shutdown", Shutdown_Handler, pNodeContext.get());
 	pServer->AddListener("/v1/", ServerAPI::V1_Handler, pNodeContext.get());
 
@@ -133,8 +133,9 @@ void Pool::RemoveTransaction(const Transaction& transaction)
 
 // Quick reconciliation step - we can evict any txs in the pool where
 // inputs or kernels intersect with the block.
-void Pool::ReconcileBlock(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet, const FullBlock& block, TransactionPtr pMemPoolAggTx)
+std::vector<TxPoolEntry> Pool::ReconcileBlock(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet, const FullBlock& block, TransactionPtr pMemPoolAggTx)
 {
+	std::vector<TxPoolEntry> removedEntries;
 	std::vector<TransactionPtr> filteredTransactions;
 	std::unordered_map<Hash, TxPoolEntry> filteredEntriesByHash;
 
@@ -149,6 +150,10 @@ void Pool::ReconcileBlock(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetCo
 			filteredTransactions.push_back(txPoolEntry.GetTransaction());
 			filteredEntriesByHash.insert(std::pair<Hash, TxPoolEntry>(txPoolEntry.GetTransaction()->GetHash(), txPoolEntry));
 		}
+		else
+		{
+			removedEntries.push_back(txPoolEntry);
+		}
 	}
 
 	m_transactions.clear();
@@ -156,9 +161,17 @@ void Pool::ReconcileBlock(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetCo
 	std::vector<TransactionPtr> validTransactions = ValidTransactionFinder::FindValidTransactions(pBlockDB, pTxHashSet, filteredTransactions, pMemPoolAggTx);
 	for (auto& pTransaction : validTransactions)
 	{
-		const TxPoolEntry& txPoolEntry = filteredEntriesByHash.at(pTransaction->GetHash());
-		m_transactions.push_back(txPoolEntry);
+		auto iter = filteredEntriesByHash.find(pTransaction->GetHash());
+		m_transactions.push_back(iter->second);
+		filteredEntriesByHash.erase(iter);
+	}
+
+	for (auto& entry : filteredEntriesByHash)
+	{
+		removedEntries.push_back(entry.second);
 	}
+
+	return removedEntries;
 }
 
 void Pool::ChangeStatus(const std::vector<TransactionPtr>& transactions, const EDandelionStatus status)
@@ -21,7 +21,12 @@ public:
 	void AddTransaction(TransactionPtr pTransaction, const EDandelionStatus status);
 	bool ContainsTransaction(const Transaction& transaction) const;
 	void RemoveTransaction(const Transaction& transaction);
-	void ReconcileBlock(
+
+	//
+	// Removes all txs that were included in the block, conflict with it, or are no longer valid.
+	// Returns the removed entries.
+	//
+	std::vector<TxPoolEntry> ReconcileBlock(
 		std::shared_ptr<const IBlockDB> pBlockDB,
 		ITxHashSetConstPtr pTxHashSet,
 		const FullBlock& block,
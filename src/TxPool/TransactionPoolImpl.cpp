@@ -8,6 +8,11 @@
 #include <Infrastructure/Logger.h>
 #include <Core/Util/FeeUtil.h>
 #include <Core/Validation/TransactionValidator.h>
+#include <unordered_set>
+
+// How long (and how many) removed mempool txs are kept around in case of a reorg.
+static const std::time_t REORG_CACHE_SECONDS = 30 * 60;
+static const size_t MAX_REORG_CACHE_SIZE = 1000;
 
 TransactionPool::TransactionPool(const Config& config)
 	: m_config(config), 
@@ -126,7 +131,16 @@ void TransactionPool::ReconcileBlock(std::shared_ptr<const IBlockDB> pBlockDB, I
 	std::unique_lock<std::shared_mutex> writeLock(m_mutex);
 
 	// First reconcile the txpool.
-	m_memPool.ReconcileBlock(pBlockDB, pTxHashSet, block, nullptr);
+	const std::time_t now = std::time(nullptr);
+	for (const TxPoolEntry& removedEntry : m_memPool.ReconcileBlock(pBlockDB, pTxHashSet, block, nullptr))
+	{
+		m_reorgCache.emplace_back(TxPoolEntry(removedEntry.GetTransaction(), removedEntry.GetStatus(), now));
+	}
+
+	while (m_reorgCache.size() > MAX_REORG_CACHE_SIZE || (!m_reorgCache.empty() && m_reorgCache.front().GetTimestamp() + REORG_CACHE_SECONDS < now))
+	{
+		m_reorgCache.pop_front();
+	}
 
 	// Now reconcile our stempool, accounting for the updated txpool txs.
 	auto pMemPoolAggTx = m_memPool.Aggregate();
@@ -134,6 +148,63 @@ void TransactionPool::ReconcileBlock(std::shared_ptr<const IBlockDB> pBlockDB, I
 	m_joinPool.ReconcileBlock(pBlockDB, pTxHashSet, block, pMemPoolAggTx);
 }
 
+void TransactionPool::ReconcileReorg(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet, const BlockHeader& lastConfirmedBlock)
+{
+	std::unique_lock<std::shared_mutex> writeLock(m_mutex);
+
+	if (pTxHashSet == nullptr)
+	{
+		return;
+	}
+
+	std::unordered_set<Commitment> spentInputs;
+	for (const TransactionPtr& pTransaction : m_memPool.FindTransactionsByStatus(EDandelionStatus::FLUFFED))
+	{
+		for (const TransactionInput& input : pTransaction->GetInputs())
+		{
+			spentInputs.insert(input.GetCommitment());
+		}
+	}
+
+	size_t numReadmitted = 0;
+	auto iter = m_reorgCache.begin();
+	while (iter != m_reorgCache.end())
+	{
+		const TransactionPtr& pTransaction = iter->GetTransaction();
+
+		const bool locked = std::any_of(
+			pTransaction->GetKernels().cbegin(),
+			pTransaction->GetKernels().cend(),
+			[&lastConfirmedBlock](const TransactionKernel& kernel) { return kernel.GetLockHeight() > (lastConfirmedBlock.GetHeight() + 1); }
+		);
+		const bool conflicts = std::any_of(
+			pTransaction->GetInputs().cbegin(),
+			pTransaction->GetInputs().cend(),
+			[&spentInputs](const TransactionInput& input) { return spentInputs.find(input.GetCommitment()) != spentInputs.cend(); }
+		);
+
+		if (locked || conflicts || m_memPool.ContainsTransaction(*pTransaction) || !pTxHashSet->IsValid(pBlockDB, *pTransaction))
+		{
+			iter++;
+			continue;
+		}
+
+		m_memPool.AddTransaction(pTransaction, EDandelionStatus::FLUFFED);
+		for (const TransactionInput& input : pTransaction->GetInputs())
+		{
+			spentInputs.insert(input.GetCommitment());
+		}
+
+		++numReadmitted;
+		iter = m_reorgCache.erase(iter);
+	}
+
+	if (numReadmitted > 0)
+	{
+		LOG_INFO_F("{} transactions re-added to mempool after reorg", numReadmitted);
+	}
+}
+
 TransactionPtr TransactionPool::GetTransactionToStem(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet)
 {
 	std::unique_lock<std::shared_mutex> writeLock(m_mutex);
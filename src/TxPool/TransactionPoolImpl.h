@@ -7,6 +7,7 @@
 #include <Core/Models/ShortId.h>
 #include <Crypto/Hash.h>
 #include <shared_mutex>
+#include <deque>
 #include <set>
 
 class TransactionPool : public ITransactionPool
@@ -20,6 +21,7 @@ public:
 	virtual std::vector<TransactionPtr> FindTransactionsByKernel(const std::set<TransactionKernel>& kernels) const override final;
 	virtual TransactionPtr FindTransactionByKernelHash(const Hash& kernelHash) const override final;
 	virtual void ReconcileBlock(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet, const FullBlock& block) override final;
+	virtual void ReconcileReorg(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet, const BlockHeader& lastConfirmedBlock) override final;
 
 	// Dandelion
 	virtual TransactionPtr GetTransactionToStem(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet) override final;
@@ -36,4 +38,8 @@ private:
 	Pool m_memPool;
 	Pool m_stemPool;
 	Pool m_joinPool;
+
+	// Mempool txs recently removed by blocks, kept so they can be re-admitted if those blocks get rewound.
+	// Entries are timestamped with when they were removed.
+	std::deque<TxPoolEntry> m_reorgCache;
 };
@@ -0,0 +1,317 @@
+#pragma once
+
+#include <Models/TxModels.h>
+#include <RootCalculator.h>
+#include <TxBuilder.h>
+
+#include <Config/Config.h>
+#include <Consensus/BlockTime.h>
+#include <Consensus/BlockWeight.h>
+#include <Consensus/Common.h>
+#include <Consensus/HardForks.h>
+#include <Core/Models/FullBlock.h>
+#include <Core/Util/FeeUtil.h>
+#include <Core/Util/TransactionUtil.h>
+#include <Crypto/Crypto.h>
+#include <Wallet/Keychain/KeyChain.h>
+#include <deque>
+#include <random>
+
+namespace Test
+{
+    struct WorkloadOptions
+    {
+        // Keys, amounts, offsets, timestamps and kernel signature nonces are derived from the seed,
+        // so the same options give the same chain, byte for byte.
+        uint64_t seed = 0;
+
+        // Height of the final chain.
+        uint64_t numBlocks = 100;
+
+        // Fraction of the maximum block weight to fill with txs. Early blocks are emptier, until enough outputs are spendable.
+        double blockFullness = 0.5;
+
+        size_t inputsPerTx = 1;
+        size_t outputsPerTx = 2;
+
+        // Every reorgInterval blocks, a branch of reorgDepth blocks is mined and then replaced by a heavier branch. 0 disables reorgs.
+        uint64_t reorgInterval = 0;
+        uint64_t reorgDepth = 1;
+
+        // Number of txs, valid on top of the final chain, that aren't included in any block.
+        size_t numMempoolTxs = 0;
+    };
+
+    struct Workload
+    {
+        // Every block mined, in the order a node would receive them.
+        // Blocks of abandoned branches come before the blocks that replace them.
+        std::vector<FullBlock> blocks;
+
+        BlockHeaderPtr pTip;
+        std::vector<TransactionPtr> mempoolTxs;
+    };
+}
+
+//
+// Generates large, valid chains for benchmarks and scaling tests, using the test PoW of the AUTOMATED_TESTING environment.
+// Roots are accumulated incrementally, so generation time grows with the number of outputs and kernels, not quadratically.
+// The generated blocks can be fed to a TestServer, and then exported with IBlockChainServer::ExportBootstrap for replays.
+//
+class ChainGenerator
+{
+public:
+    ChainGenerator(const Config& config, const Test::WorkloadOptions& options)
+        : m_config(config),
+        m_options(options),
+        m_random(options.seed),
+        m_keyChain(KeyChain::FromSeed(config, GenerateSeed(m_random))),
+        m_txBuilder(m_keyChain, [this] { return GenerateNonce(); }),
+        m_nextKeyIndex(0)
+    {
+        const FullBlock& genesis = config.GetEnvironment().GetGenesisBlock();
+        m_state.pTip = genesis.GetHeader();
+        m_state.headerMMR.Add(*genesis.GetHeader());
+        AddToMMRs(m_state, genesis.GetTransactionBody());
+    }
+
+    Test::Workload Generate()
+    {
+        Test::Workload workload;
+
+        while (m_state.pTip->GetHeight() < m_options.numBlocks)
+        {
+            uint64_t additionalDifficulty = 0;
+
+            const uint64_t nextHeight = m_state.pTip->GetHeight() + 1;
+            if (m_options.reorgInterval > 0 && nextHeight % m_options.reorgInterval == 0)
+            {
+                const State forkPoint = m_state;
+                for (uint64_t i = 0; i < m_options.reorgDepth; i++)
+                {
+                    workload.blocks.push_back(MineBlock(m_state, 0));
+                }
+
+                // The replacement branch outweighs the abandoned one as soon as its first block arrives.
+                m_state = forkPoint;
+                additionalDifficulty = m_options.reorgDepth;
+            }
+
+            workload.blocks.push_back(MineBlock(m_state, additionalDifficulty));
+        }
+
+        workload.pTip = m_state.pTip;
+        workload.mempoolTxs = BuildTxs(m_state, m_state.pTip->GetHeight() + 1, m_options.numMempoolTxs);
+        return workload;
+    }
+
+private:
+    struct Spendable
+    {
+        Test::Input input;
+        uint64_t height;
+    };
+
+    struct State
+    {
+        BlockHeaderPtr pTip;
+        RootAccumulator headerMMR;
+        RootAccumulator outputMMR;
+        RootAccumulator rangeProofMMR;
+        RootAccumulator kernelMMR;
+
+        // Ordered oldest first, so txs always spend the oldest outputs.
+        // Coinbase outputs are kept apart, since they can only be spent once mature.
+        std::deque<Spendable> unspentOutputs;
+        std::deque<Spendable> unspentCoinbases;
+    };
+
+    static SecureVector GenerateSeed(std::mt19937_64& random)
+    {
+        SecureVector seed(32);
+        for (unsigned char& byte : seed)
+        {
+            byte = (unsigned char)random();
+        }
+
+        return seed;
+    }
+
+    // 32 random bytes, kept below the curve order (and above zero) so they're a valid scalar.
+    Hash GenerateScalar()
+    {
+        std::vector<unsigned char> bytes(32);
+        for (unsigned char& byte : bytes)
+        {
+            byte = (unsigned char)m_random();
+        }
+
+        bytes[0] &= 0x7f;
+        bytes[31] |= 0x01;
+        return Hash(std::move(bytes));
+    }
+
+    BlindingFactor GenerateOffset() { return BlindingFactor(GenerateScalar()); }
+    SecretKey GenerateNonce() { return SecretKey(GenerateScalar()); }
+
+    static void AddToMMRs(State& state, const TransactionBody& body)
+    {
+        for (const TransactionOutput& output : body.GetOutputs())
+        {
+            state.outputMMR.Add(OutputIdentifier::FromOutput(output));
+            state.rangeProofMMR.Add(output.GetRangeProof());
+        }
+
+        for (const TransactionKernel& kernel : body.GetKernels())
+        {
+            state.kernelMMR.Add(kernel);
+        }
+    }
+
+    std::vector<TransactionPtr> BuildTxs(State& state, const uint64_t height, const size_t maxTxs)
+    {
+        const uint64_t maxCoinbaseHeight = Consensus::GetMaxCoinbaseHeight(m_config.GetEnvironment().GetEnvironmentType(), height);
+        const uint64_t numInputs = m_options.inputsPerTx;
+        const uint64_t numOutputs = m_options.outputsPerTx;
+        const uint64_t fee = FeeUtil::CalculateFee(1'000'000, numInputs, numOutputs, 1);
+
+        std::vector<TransactionPtr> txs;
+        while (txs.size() < maxTxs)
+        {
+            std::vector<Spendable> selected;
+            uint64_t inputTotal = 0;
+            while (selected.size() < numInputs)
+            {
+                // Outputs created in the same block would be cut through.
+                std::deque<Spendable>* pQueue = nullptr;
+                if (!state.unspentOutputs.empty() && state.unspentOutputs.front().height < height)
+                {
+                    pQueue = &state.unspentOutputs;
+                }
+                else if (!state.unspentCoinbases.empty() && state.unspentCoinbases.front().height <= maxCoinbaseHeight)
+                {
+                    pQueue = &state.unspentCoinbases;
+                }
+                else
+                {
+                    break;
+                }
+
+                selected.push_back(pQueue->front());
+                pQueue->pop_front();
+                inputTotal += selected.back().input.amount;
+            }
+
+            if (selected.size() < numInputs || inputTotal <= fee + numOutputs)
+            {
+                for (auto iter = selected.crbegin(); iter != selected.crend(); iter++)
+                {
+                    auto& queue = iter->input.input.IsCoinbase() ? state.unspentCoinbases : state.unspentOutputs;
+                    queue.push_front(*iter);
+                }
+
+                return txs;
+            }
+
+            std::vector<Test::Input> inputs;
+            for (const Spendable& spendable : selected)
+            {
+                inputs.push_back(spendable.input);
+            }
+
+            const uint64_t outputAmount = (inputTotal - fee) / numOutputs;
+            std::vector<Test::Output> outputs;
+            for (size_t i = 0; i < numOutputs; i++)
+            {
+                const uint64_t amount = (i == 0) ? (inputTotal - fee) - (outputAmount * (numOutputs - 1)) : outputAmount;
+                outputs.push_back({ KeyChainPath({ 1, m_nextKeyIndex++ }), amount });
+            }
+
+            Transaction tx = m_txBuilder.BuildTx(fee, inputs, outputs, GenerateOffset());
+            for (const Test::Output& output : outputs)
+            {
+                const SecretKey blindingFactor = m_keyChain.DerivePrivateKey(output.path, output.amount);
+                Commitment commitment = Crypto::CommitBlinded(output.amount, BlindingFactor(blindingFactor.GetBytes()));
+                state.unspentOutputs.push_back({ { TransactionInput(EOutputFeatures::DEFAULT_OUTPUT, std::move(commitment)), output.path, output.amount }, height });
+            }
+
+            txs.push_back(std::make_shared<Transaction>(std::move(tx)));
+        }
+
+        return txs;
+    }
+
+    FullBlock MineBlock(State& state, const uint64_t additionalDifficulty)
+    {
+        const uint64_t height = state.pTip->GetHeight() + 1;
+
+        const uint64_t txWeight = (m_options.inputsPerTx * Consensus::BLOCK_INPUT_WEIGHT)
+            + (m_options.outputsPerTx * Consensus::BLOCK_OUTPUT_WEIGHT)
+            + Consensus::BLOCK_KERNEL_WEIGHT;
+        const uint64_t coinbaseWeight = Consensus::BLOCK_OUTPUT_WEIGHT + Consensus::BLOCK_KERNEL_WEIGHT;
+        const size_t maxTxs = (size_t)((Consensus::MAX_BLOCK_WEIGHT - coinbaseWeight) * m_options.blockFullness) / txWeight;
+
+        std::vector<TransactionPtr> txs = BuildTxs(state, height, maxTxs);
+
+        uint64_t fees = 0;
+        for (const TransactionPtr& pTx : txs)
+        {
+            fees += FeeUtil::CalculateActualFee(*pTx);
+        }
+
+        const KeyChainPath coinbasePath({ 0, m_nextKeyIndex++ });
+        const uint64_t coinbaseAmount = Consensus::REWARD + fees;
+        txs.push_back(m_txBuilder.BuildCoinbaseTx(coinbasePath, coinbaseAmount).pTransaction);
+
+        TransactionPtr pTransaction = TransactionUtil::Aggregate(txs);
+        AddToMMRs(state, pTransaction->GetBody());
+
+        // Block hashes are hashes of the proof, so the nonces must differ between blocks at the same height.
+        BlockHeaderPtr pPrevHeader = state.pTip;
+        std::vector<uint64_t> nonces = pPrevHeader->GetProofOfWork().GetProofNonces();
+        for (size_t i = 0; i < 4; i++)
+        {
+            nonces[i] += m_random();
+        }
+
+        auto pHeader = std::make_shared<BlockHeader>(
+            Consensus::GetHeaderVersion(m_config.GetEnvironment().GetEnvironmentType(), height),
+            height,
+            m_config.GetEnvironment().GetGenesisBlock().GetHeader()->GetTimestamp() + (int64_t)(height * Consensus::BLOCK_TIME_SEC),
+            Hash(pPrevHeader->GetHash()),
+            state.headerMMR.GetRoot(),
+            state.outputMMR.GetRoot(),
+            state.rangeProofMMR.GetRoot(),
+            state.kernelMMR.GetRoot(),
+            Crypto::AddBlindingFactors({ pPrevHeader->GetTotalKernelOffset(), pTransaction->GetOffset() }, {}),
+            state.outputMMR.GetSize(),
+            state.kernelMMR.GetSize(),
+            pPrevHeader->GetTotalDifficulty() + 1 + additionalDifficulty,
+            10,
+            m_random(),
+            ProofOfWork(pPrevHeader->GetProofOfWork().GetEdgeBits(), std::move(nonces))
+        );
+
+        FullBlock block(pHeader, TransactionBody(pTransaction->GetBody()));
+        for (const TransactionOutput& output : block.GetOutputs())
+        {
+            if (output.IsCoinbase())
+            {
+                state.unspentCoinbases.push_back({ { TransactionInput(output.GetFeatures(), output.GetCommitment()), coinbasePath, coinbaseAmount }, height });
+            }
+        }
+
+        state.pTip = pHeader;
+        state.headerMMR.Add(*pHeader);
+
+        return block;
+    }
+
+    const Config& m_config;
+    Test::WorkloadOptions m_options;
+    std::mt19937_64 m_random;
+    KeyChain m_keyChain;
+    TxBuilder m_txBuilder;
+    uint32_t m_nextKeyIndex;
+    State m_state;
+};
\ No newline at end of file
@@ -7,56 +7,79 @@
 #include <PMMR/Common/MMRHashUtil.h>
 #include <type_traits>
 
+//
+// Builds an MMR one leaf at a time, so roots can be calculated after each block without rehashing every leaf.
+//
+class RootAccumulator
+{
+public:
+    template<class T, typename = std::enable_if_t<std::is_base_of_v<Traits::ISerializable, T>>>
+    void Add(const T& leaf)
+    {
+        uint64_t position = m_hashes.size();
+        m_hashes.push_back(Crypto::Blake2b(leaf.SerializeWithIndex(position)));
+
+        const uint64_t nextLeafPosition = MMRUtil::GetPMMRIndex(++m_numLeaves);
+
+        // Add parent hashes
+        uint64_t peak = 1;
+        while (++position < nextLeafPosition)
+        {
+            const uint64_t leftSiblingPosition = position - (2 * peak);
+
+            const Hash& leftHash = m_hashes[leftSiblingPosition];
+            const Hash& rightHash = m_hashes[position - 1];
+
+            peak *= 2;
+
+            m_hashes.push_back(MMRHashUtil::HashParentWithIndex(leftHash, rightHash, position));
+        }
+    }
+
+    Hash GetRoot() const
+    {
+        Hash hash = ZERO_HASH;
+        const std::vector<uint64_t> peakIndices = MMRUtil::GetPeakIndices(m_hashes.size());
+        for (auto iter = peakIndices.crbegin(); iter != peakIndices.crend(); iter++)
+        {
+            const Hash& peakHash = m_hashes[*iter];
+            if (peakHash != ZERO_HASH)
+            {
+                if (hash == ZERO_HASH)
+                {
+                    hash = peakHash;
+                }
+                else
+                {
+                    hash = MMRHashUtil::HashParentWithIndex(peakHash, hash, m_hashes.size());
+                }
+            }
+        }
+
+        return hash;
+    }
+
+    uint64_t GetSize() const noexcept { return m_hashes.size(); }
+
+private:
+    std::vector<Hash> m_hashes;
+    uint64_t m_numLeaves = 0;
+};
+
 class RootCalculator
 {
 public:
     template<class T, typename = std::enable_if_t<std::is_base_of_v<Traits::ISerializable, T>>>
     static Hash CalculateRoot(const std::vector<T>& leaves)
     {
-		assert(!leaves.empty());
+        assert(!leaves.empty());
 
-        std::vector<Hash> hashes;
-
-        for (size_t leafIdx = 0; leafIdx < leaves.size(); leafIdx++)
+        RootAccumulator accumulator;
+        for (const T& leaf : leaves)
         {
-			uint64_t position = MMRUtil::GetPMMRIndex(leafIdx);
-            hashes.push_back(Crypto::Blake2b(leaves[leafIdx].SerializeWithIndex(position)));
-
-			const uint64_t nextLeafPosition = MMRUtil::GetPMMRIndex(leafIdx + 1);
-
-			// Add parent hashes
-			uint64_t peak = 1;
-			while (++position < nextLeafPosition)
-			{
-				const uint64_t leftSiblingPosition = position - (2 * peak);
-
-				const Hash& leftHash = hashes[leftSiblingPosition];
-				const Hash& rightHash = hashes[position - 1];
-
-				peak *= 2;
-
-				hashes.push_back(MMRHashUtil::HashParentWithIndex(leftHash, rightHash, position));
-			}
-		}
-
-		Hash hash = ZERO_HASH;
-		const std::vector<uint64_t> peakIndices = MMRUtil::GetPeakIndices(hashes.size());
-		for (auto iter = peakIndices.crbegin(); iter != peakIndices.crend(); iter++)
-		{
-			const Hash& peakHash = hashes[*iter];
-			if (peakHash != ZERO_HASH)
-			{
-				if (hash == ZERO_HASH)
-				{
-					hash = peakHash;
-				}
-				else
-				{
-					hash = MMRHashUtil::HashParentWithIndex(peakHash, hash, hashes.size());
-				}
-			}
-		}
-
-		return hash;
+            accumulator.Add(leaf);
+        }
+
+        return accumulator.GetRoot();
     }
 };
\ No newline at end of file
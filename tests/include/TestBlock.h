@@ -0,0 +1,35 @@
+#pragma once
+
+#include <Core/Models/FullBlock.h>
+#include <Crypto/RandomNumberGenerator.h>
+
+class TestBlock
+{
+public:
+    //
+    // Creates an empty block at the given height. Its header isn't valid, just unique,
+    // so it's only suited to tests that key blocks by height and hash (eg. OrphanPool and ValidatedBlockCache).
+    //
+    static FullBlock::CPtr Create(const uint64_t height, const Hash& previousHash = RandomNumberGenerator::GenerateRandom32())
+    {
+        auto pHeader = std::make_shared<BlockHeader>(
+            (uint16_t)2,
+            height,
+            (int64_t)height * 60,
+            Hash(previousHash),
+            Hash(ZERO_HASH),
+            Hash(ZERO_HASH),
+            Hash(ZERO_HASH),
+            Hash(ZERO_HASH),
+            BlindingFactor(ZERO_HASH),
+            0,
+            0,
+            height,
+            1,
+            height,
+            ProofOfWork(29, std::vector<uint64_t>(42, 0), RandomNumberGenerator::GenerateRandom32())
+        );
+
+        return std::make_shared<const FullBlock>(pHeader, TransactionBody());
+    }
+};
\ No newline at end of file
@@ -16,9 +16,9 @@ class TestServer
 public:
 	using Ptr = std::shared_ptr<TestServer>;
 
-	static TestServer::Ptr Create()
+	static TestServer::Ptr Create(const Json::Value& json = Json::Value())
 	{
-		ConfigPtr pConfig = TestHelper::GetTestConfig();
+		ConfigPtr pConfig = TestHelper::GetTestConfig(json);
 		LoggerAPI::Initialize(pConfig->GetLogDirectory(), pConfig->GetLogLevel());
 		IDatabasePtr pDatabase = DatabaseAPI::OpenDatabase(*pConfig);
 		auto pTxHashSetManager = std::make_shared<Locked<TxHashSetManager>>(std::make_shared<TxHashSetManager>(*pConfig));
@@ -29,7 +29,8 @@ public:
 			pDatabase->GetBlockDB(),
 			pTxHashSetManager,
 			pTxPool,
-			pHeaderMMR
+			pHeaderMMR,
+			TaskPool::Create()
 		);
 
 		return std::make_shared<TestServer>(
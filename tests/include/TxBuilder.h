@@ -7,13 +7,19 @@
 #include <Crypto/RandomNumberGenerator.h>
 #include <Crypto/Crypto.h>
 #include <Crypto/CryptoUtil.h>
+#include <functional>
 #include <tuple>
 
 class TxBuilder
 {
     static const uint64_t BASE_REWARD = 60'000'000'000;
 public:
-    TxBuilder(const KeyChain& keyChain) : m_keyChain(keyChain) { }
+    // Returns the secret nonce for the next kernel signature.
+    using NonceGenerator = std::function<SecretKey()>;
+
+    // Kernel signatures use random nonces, unless a nonceGenerator is given.
+    TxBuilder(const KeyChain& keyChain, const NonceGenerator& nonceGenerator = nullptr)
+        : m_keyChain(keyChain), m_nonceGenerator(nonceGenerator) { }
 
     Test::Tx BuildCoinbaseTx(const KeyChainPath& keyChainPath, const uint64_t amount = BASE_REWARD)
     {
@@ -43,9 +49,10 @@ public:
     Transaction BuildTx(
         const uint64_t fee,
         const std::vector<Test::Input>& inputs,
-        const std::vector<Test::Output>& outputs)
+        const std::vector<Test::Output>& outputs,
+        const BlindingFactor& offset = RandomNumberGenerator::GenerateRandom32())
     {
-        BlindingFactor txOffset = RandomNumberGenerator::GenerateRandom32();
+        BlindingFactor txOffset = offset;
 
         // Calculate sum inputs blinding factors xI.
         std::vector<BlindingFactor> inputBlindingFactors;
@@ -98,6 +105,7 @@ public:
 
 private:
     const KeyChain& m_keyChain;
+    NonceGenerator m_nonceGenerator;
 
     TransactionKernel BuildKernel(
         const EKernelFeatures features,
@@ -113,11 +121,23 @@ private:
             serializer.Append<uint64_t>((uint64_t)fee);
         }
 
-        auto pSignature = Crypto::BuildCoinbaseSignature(
-            BlindingFactor(blind).ToSecretKey(),
-            commit,
-            Crypto::Blake2b(serializer.GetBytes())
-        );
+        const Hash message = Crypto::Blake2b(serializer.GetBytes());
+
+        std::unique_ptr<Signature> pSignature = nullptr;
+        if (m_nonceGenerator)
+        {
+            const SecretKey secretKey = BlindingFactor(blind).ToSecretKey();
+            const SecretKey secretNonce = m_nonceGenerator();
+            const PublicKey publicKey = Crypto::CalculatePublicKey(secretKey);
+            const PublicKey publicNonce = Crypto::CalculatePublicKey(secretNonce);
+
+            auto pPartialSignature = Crypto::CalculatePartialSignature(secretKey, secretNonce, publicKey, publicNonce, message);
+            pSignature = Crypto::AggregateSignatures({ *pPartialSignature }, publicNonce);
+        }
+        else
+        {
+            pSignature = Crypto::BuildCoinbaseSignature(BlindingFactor(blind).ToSecretKey(), commit, message);
+        }
 
         return TransactionKernel(
             features,
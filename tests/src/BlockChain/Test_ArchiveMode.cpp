@@ -0,0 +1,80 @@
+#include <catch.hpp>
+
+#include <TestServer.h>
+#include <TestMiner.h>
+#include <ChainGenerator.h>
+#include <TxBuilder.h>
+
+#include <BlockChain/BlockChainServer.h>
+#include <Config/ConfigProps.h>
+#include <Core/Util/FeeUtil.h>
+#include <Core/Util/TransactionUtil.h>
+
+//
+// Archive nodes never download the TxHashSet, so they must apply blocks that are more than a horizon
+// behind the header chain, and their history must cover the whole chain from height 1 onward.
+//
+TEST_CASE("Archive Mode Full Sync")
+{
+	Json::Value json;
+	json[ConfigProps::Node::NODE][ConfigProps::Node::ARCHIVE_MODE] = true;
+
+	TestServer::Ptr pTestServer = TestServer::Create(json);
+	auto pBlockChainServer = pTestServer->GetBlockChainServer();
+
+	Test::WorkloadOptions options;
+	options.seed = 28;
+	options.numBlocks = Consensus::CUT_THROUGH_HORIZON + 30;
+	options.blockFullness = 0.0; // Coinbase only, to keep generation fast
+	options.numMempoolTxs = 1;   // Spends the coinbase of block 1
+
+	Test::Workload workload = ChainGenerator(*pTestServer->GetConfig(), options).Generate();
+	REQUIRE(workload.blocks.size() == options.numBlocks);
+
+	// Like header sync, all headers arrive before the blocks, so the early blocks are beyond the candidate chain's horizon.
+	std::vector<BlockHeaderPtr> headers;
+	for (const FullBlock& block : workload.blocks)
+	{
+		headers.push_back(block.GetHeader());
+	}
+
+	REQUIRE(pBlockChainServer->AddBlockHeaders(headers) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pBlockChainServer->GetHeight(EChainType::CANDIDATE) == options.numBlocks);
+
+	for (const FullBlock& block : workload.blocks)
+	{
+		REQUIRE(pBlockChainServer->AddBlock(block) == EBlockChainStatus::SUCCESS);
+	}
+
+	REQUIRE(pBlockChainServer->GetHeight(EChainType::CONFIRMED) == options.numBlocks);
+
+	for (uint64_t height = 1; height <= options.numBlocks; height++)
+	{
+		std::unique_ptr<Hash> pArchivedHash = pBlockChainServer->GetArchivedBlockHash(height);
+		REQUIRE(pArchivedHash != nullptr);
+		REQUIRE(*pArchivedHash == workload.blocks[height - 1].GetHash());
+	}
+
+	////////////////////////////////////////
+	// Spend the coinbase of block 1
+	////////////////////////////////////////
+	const TransactionPtr& pSpendTx = workload.mempoolTxs.front();
+	const Commitment& spentCommitment = pSpendTx->GetInputs().front().GetCommitment();
+	REQUIRE(spentCommitment == workload.blocks.front().GetOutputs().front().GetCommitment());
+
+	TestMiner miner(pTestServer);
+	KeyChain keyChain = KeyChain::FromRandom(*pTestServer->GetConfig());
+	TxBuilder txBuilder(keyChain);
+
+	Test::Tx coinbaseTx = txBuilder.BuildCoinbaseTx(KeyChainPath({ 0, 0 }), Consensus::REWARD + FeeUtil::CalculateActualFee(*pSpendTx));
+	FullBlock spendBlock = miner.MineNextBlock(
+		workload.pTip,
+		*TransactionUtil::Aggregate({ coinbaseTx.pTransaction, pSpendTx })
+	);
+	REQUIRE(pBlockChainServer->AddBlock(spendBlock) == EBlockChainStatus::SUCCESS);
+
+	std::unique_ptr<OutputHistory> pHistory = pBlockChainServer->GetOutputHistory(spentCommitment);
+	REQUIRE(pHistory != nullptr);
+	REQUIRE(pHistory->GetCreatedHeight() == 1);
+	REQUIRE(pHistory->GetSpentHeight() == std::make_optional<uint64_t>(options.numBlocks + 1));
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include <catch.hpp>
+
+#include <TestServer.h>
+#include <TestChain.h>
+#include <TxBuilder.h>
+
+#include <BlockChain/BlockChainServer.h>
+#include <Config/Config.h>
+#include <Infrastructure/Metrics.h>
+
+//
+// Returns a copy of the coinbase tx, with its rangeproof swapped for one belonging to a different output.
+// Sums and MMR roots still add up, so only rangeproof verification can catch it.
+//
+static Test::Tx BuildInvalidCoinbaseTx(TxBuilder& txBuilder, const KeyChainPath& keyChainPath, const KeyChainPath& otherPath)
+{
+	Test::Tx coinbase = txBuilder.BuildCoinbaseTx(keyChainPath);
+	Test::Tx other = txBuilder.BuildCoinbaseTx(otherPath);
+
+	const TransactionOutput& output = coinbase.pTransaction->GetOutputs().front();
+	TransactionOutput invalidOutput(
+		output.GetFeatures(),
+		Commitment(output.GetCommitment()),
+		RangeProof(other.pTransaction->GetOutputs().front().GetRangeProof())
+	);
+
+	coinbase.pTransaction = std::make_shared<Transaction>(
+		BlindingFactor(coinbase.pTransaction->GetOffset()),
+		TransactionBody({}, { invalidOutput }, std::vector<TransactionKernel>(coinbase.pTransaction->GetKernels()))
+	);
+	return coinbase;
+}
+
+//
+// a(invalid rangeproof) - b - c - d(invalid rangeproof)
+//
+// With b as the assume-valid block, a's rangeproof isn't verified, but d's still is.
+//
+TEST_CASE("Assume Valid")
+{
+	MinedBlock block_a, block_b, block_c, block_d;
+
+	{
+		TestServer::Ptr pTestServer = TestServer::Create();
+		KeyChain keyChain = KeyChain::FromRandom(*pTestServer->GetConfig());
+		TxBuilder txBuilder(keyChain);
+		TestChain chain(pTestServer);
+
+		block_a = chain.AddNextBlock({ BuildInvalidCoinbaseTx(txBuilder, KeyChainPath({ 0, 1 }), KeyChainPath({ 1, 1 })) });
+		block_b = chain.AddNextBlock({ txBuilder.BuildCoinbaseTx(KeyChainPath({ 0, 2 })) });
+		block_c = chain.AddNextBlock({ txBuilder.BuildCoinbaseTx(KeyChainPath({ 0, 3 })) });
+		block_d = chain.AddNextBlock({ BuildInvalidCoinbaseTx(txBuilder, KeyChainPath({ 0, 4 }), KeyChainPath({ 1, 4 })) });
+
+		// Without assume-valid, the invalid rangeproof is caught.
+		REQUIRE(pTestServer->GetBlockChainServer()->AddBlock(FullBlock(block_a.block)) == EBlockChainStatus::INVALID);
+	}
+
+	Json::Value json;
+	json[ConfigProps::Node::NODE][ConfigProps::Node::ASSUME_VALID] = block_b.block.GetHash().ToHex();
+
+	TestServer::Ptr pTestServer = TestServer::Create(json);
+	auto pBlockChainServer = pTestServer->GetBlockChainServer();
+
+	REQUIRE(pBlockChainServer->AddBlockHeaders({
+		block_a.block.GetHeader(),
+		block_b.block.GetHeader(),
+		block_c.block.GetHeader(),
+		block_d.block.GetHeader()
+	}) == EBlockChainStatus::SUCCESS);
+
+	// An assumed-valid block isn't marked as validated, so a full check later still verifies its rangeproofs.
+	{
+		FullBlock assumed(block_a.block);
+		REQUIRE(pBlockChainServer->VerifyBlock(assumed));
+		REQUIRE(assumed.WasAssumedValid());
+		REQUIRE_FALSE(assumed.WasValidated());
+	}
+
+	const uint64_t skippedBefore = MetricsAPI::GetCounter("block.assume_valid.skipped").GetValue();
+
+	REQUIRE(pBlockChainServer->AddBlock(block_a.block) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pBlockChainServer->AddBlock(block_b.block) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pBlockChainServer->AddBlock(block_c.block) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pBlockChainServer->AddBlock(block_d.block) == EBlockChainStatus::INVALID);
+
+	REQUIRE(MetricsAPI::GetCounter("block.assume_valid.skipped").GetValue() == skippedBefore + 2);
+	REQUIRE(pBlockChainServer->GetHeight(EChainType::CONFIRMED) == 3);
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include <catch.hpp>
+
+#include <TestServer.h>
+#include <TestChain.h>
+#include <TestFileUtil.h>
+#include <TxBuilder.h>
+
+#include <BlockChain/BlockChainServer.h>
+#include <Core/Exceptions/BadDataException.h>
+#include <fstream>
+
+// Mines and applies numBlocks blocks (coinbase only) on the server's chain, and returns them in order.
+static std::vector<MinedBlock> MineBlocks(const TestServer::Ptr& pTestServer, const uint32_t numBlocks)
+{
+	KeyChain keyChain = KeyChain::FromRandom(*pTestServer->GetConfig());
+	TxBuilder txBuilder(keyChain);
+	TestChain chain(pTestServer);
+
+	std::vector<MinedBlock> blocks;
+	for (uint32_t i = 1; i <= numBlocks; i++)
+	{
+		MinedBlock block = chain.AddNextBlock({ txBuilder.BuildCoinbaseTx(KeyChainPath({ 0, i })) });
+		REQUIRE(pTestServer->GetBlockChainServer()->AddBlock(block.block) == EBlockChainStatus::SUCCESS);
+		blocks.push_back(block);
+	}
+
+	return blocks;
+}
+
+TEST_CASE("Bootstrap Export and Import")
+{
+	TemporaryFile::Ptr pBootstrapFile = TestFileUtil::CreateTempFile();
+	std::vector<MinedBlock> blocks;
+
+	{
+		TestServer::Ptr pTestServer = TestServer::Create();
+		blocks = MineBlocks(pTestServer, 5);
+		REQUIRE(pTestServer->GetBlockChainServer()->ExportBootstrap(pBootstrapFile->GetPath()) == 5);
+	}
+
+	TestServer::Ptr pTestServer = TestServer::Create();
+	auto pBlockChainServer = pTestServer->GetBlockChainServer();
+
+	// Resumes from the confirmed tip, skipping blocks already applied.
+	REQUIRE(pBlockChainServer->AddBlockHeaders({ blocks[0].block.GetHeader(), blocks[1].block.GetHeader() }) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pBlockChainServer->AddBlock(blocks[0].block) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pBlockChainServer->AddBlock(blocks[1].block) == EBlockChainStatus::SUCCESS);
+
+	REQUIRE(pBlockChainServer->ImportBootstrap(pBootstrapFile->GetPath()) == 3);
+	REQUIRE(pBlockChainServer->GetHeight(EChainType::CONFIRMED) == 5);
+	REQUIRE(pBlockChainServer->GetTipBlockHeader(EChainType::CONFIRMED)->GetHash() == blocks.back().block.GetHash());
+
+	// A truncated file is rejected.
+	fs::resize_file(pBootstrapFile->GetPath(), fs::file_size(pBootstrapFile->GetPath()) - 1);
+	REQUIRE_THROWS_AS(pBlockChainServer->ImportBootstrap(pBootstrapFile->GetPath()), BadDataException);
+}
+
+// Overwrites the 8 bytes at the position with 0xFF, the largest possible size or count.
+static void CorruptU64(const fs::path& path, const uint64_t position)
+{
+	std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+	file.seekp(position);
+	const std::vector<char> bytes(8, (char)0xFF);
+	file.write(bytes.data(), bytes.size());
+}
+
+TEST_CASE("Bootstrap Corrupt Sizes")
+{
+	TemporaryFile::Ptr pBootstrapFile = TestFileUtil::CreateTempFile();
+
+	{
+		TestServer::Ptr pTestServer = TestServer::Create();
+		MineBlocks(pTestServer, 2);
+		REQUIRE(pTestServer->GetBlockChainServer()->ExportBootstrap(pBootstrapFile->GetPath()) == 2);
+	}
+
+	const fs::path& path = pBootstrapFile->GetPath();
+	std::vector<unsigned char> original;
+	REQUIRE(FileUtil::ReadFile(path, original));
+
+	TestServer::Ptr pTestServer = TestServer::Create();
+	auto pBlockChainServer = pTestServer->GetBlockChainServer();
+
+	// A block count too large for the file is rejected before the index is read.
+	CorruptU64(path, original.size() - 16);
+	REQUIRE_THROWS_AS(pBlockChainServer->ImportBootstrap(path), BadDataException);
+
+	// A block size larger than the file is rejected before the block is read.
+	// The first block's size comes right after the 41 byte file header.
+	FileUtil::SafeWriteToFile(path, original);
+	CorruptU64(path, 41);
+	REQUIRE_THROWS_AS(pBlockChainServer->ImportBootstrap(path), BadDataException);
+	REQUIRE(pBlockChainServer->GetHeight(EChainType::CONFIRMED) == 0);
+
+	// The untouched file still imports.
+	FileUtil::SafeWriteToFile(path, original);
+	REQUIRE(pBlockChainServer->ImportBootstrap(path) == 2);
+}
+
+TEST_CASE("Replay Chain")
+{
+	TestServer::Ptr pSourceServer = TestServer::Create();
+	const std::vector<MinedBlock> blocks = MineBlocks(pSourceServer, 5);
+
+	auto pSource = pSourceServer->GetBlockChainServer();
+	TestServer::Ptr pTargetServer = TestServer::Create();
+	auto pTarget = pTargetServer->GetBlockChainServer();
+
+	// Resumes from the target's confirmed tip.
+	REQUIRE(pTarget->AddBlockHeaders({ blocks[0].block.GetHeader() }) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pTarget->AddBlock(blocks[0].block) == EBlockChainStatus::SUCCESS);
+
+	REQUIRE(pTarget->ReplayChain(*pSource) == 4);
+	REQUIRE(pTarget->GetHeight(EChainType::CONFIRMED) == 5);
+	REQUIRE(pTarget->GetTipBlockHeader(EChainType::CONFIRMED)->GetHash() == blocks.back().block.GetHash());
+
+	// The source is left as it was.
+	REQUIRE(pSource->GetHeight(EChainType::CONFIRMED) == 5);
+	REQUIRE(pSource->GetHeight(EChainType::CANDIDATE) == 5);
+	REQUIRE(pSource->GetTipBlockHeader(EChainType::CONFIRMED)->GetHash() == blocks.back().block.GetHash());
+
+	// Nothing left to replay.
+	REQUIRE(pTarget->ReplayChain(*pSource) == 0);
+}
\ No newline at end of file
@@ -61,4 +61,89 @@ TEST_CASE("Chain Batching")
 		REQUIRE(pReader->GetByHeight(3)->GetHash() == hash3b);
 		REQUIRE(pReader->GetByHeight(4)->GetHash() == hash4b);
 	}
+}
+
+TEST_CASE("Chain Common Index")
+{
+	TestServer::Ptr pTestServer = TestServer::Create();
+	auto pAllocator = std::make_shared<BlockIndexAllocator>();
+	auto pGenesisIndex = pAllocator->GetOrCreateIndex(pTestServer->GetGenesisHeader()->GetHash(), 0);
+
+	Locked<Chain> candidate(Chain::Load(pAllocator, EChainType::CANDIDATE, pTestServer->GenerateTempDir() / "candidate.chain", pGenesisIndex));
+	Locked<Chain> confirmed(Chain::Load(pAllocator, EChainType::CONFIRMED, pTestServer->GenerateTempDir() / "confirmed.chain", pGenesisIndex));
+
+	{
+		auto pCandidate = candidate.BatchWrite();
+		auto pConfirmed = confirmed.BatchWrite();
+		for (uint64_t height = 1; height <= 100; height++)
+		{
+			const Hash hash = RandomNumberGenerator::GenerateRandom32();
+			pCandidate->AddBlock(hash, height);
+			if (height <= 37)
+			{
+				pConfirmed->AddBlock(hash, height);
+			}
+			else if (height <= 60)
+			{
+				pConfirmed->AddBlock(RandomNumberGenerator::GenerateRandom32(), height);
+			}
+		}
+
+		pCandidate->Commit();
+		pConfirmed->Commit();
+	}
+
+	// Forked at height 37
+	REQUIRE(candidate.Read()->FindCommonIndex(*confirmed.Read())->GetHeight() == 37);
+	REQUIRE(confirmed.Read()->FindCommonIndex(*candidate.Read())->GetHeight() == 37);
+
+	// One chain is a prefix of the other
+	{
+		auto pConfirmed = confirmed.BatchWrite();
+		pConfirmed->Rewind(20);
+		pConfirmed->Commit();
+	}
+	REQUIRE(candidate.Read()->FindCommonIndex(*confirmed.Read())->GetHeight() == 20);
+
+	// Only genesis in common
+	{
+		auto pConfirmed = confirmed.BatchWrite();
+		pConfirmed->Rewind(0);
+		pConfirmed->AddBlock(RandomNumberGenerator::GenerateRandom32(), 1);
+		pConfirmed->Commit();
+	}
+	REQUIRE(candidate.Read()->FindCommonIndex(*confirmed.Read())->GetHeight() == 0);
+}
+
+TEST_CASE("Chain Reload")
+{
+	TestServer::Ptr pTestServer = TestServer::Create();
+	auto chain_path = pTestServer->GenerateTempDir() / "confirmed.chain";
+	auto pGenesisHeader = pTestServer->GetGenesisHeader();
+
+	std::vector<Hash> hashes;
+	{
+		auto pAllocator = std::make_shared<BlockIndexAllocator>();
+		Locked<Chain> chain(Chain::Load(pAllocator, EChainType::CONFIRMED, chain_path, pAllocator->GetOrCreateIndex(pGenesisHeader->GetHash(), 0)));
+
+		auto pBatch = chain.BatchWrite();
+		for (uint64_t height = 1; height <= 100; height++)
+		{
+			hashes.push_back(RandomNumberGenerator::GenerateRandom32());
+			pBatch->AddBlock(hashes.back(), height);
+		}
+
+		pBatch->Commit();
+	}
+
+	// Every committed hash is read back from the chain file.
+	auto pAllocator = std::make_shared<BlockIndexAllocator>();
+	auto pChain = Chain::Load(pAllocator, EChainType::CONFIRMED, chain_path, pAllocator->GetOrCreateIndex(pGenesisHeader->GetHash(), 0));
+	REQUIRE(pChain->GetHeight() == 100);
+	REQUIRE(pChain->GetHash(0) == pGenesisHeader->GetHash());
+	for (uint64_t height = 1; height <= 100; height++)
+	{
+		REQUIRE(pChain->GetByHeight(height)->GetHeight() == height);
+		REQUIRE(pChain->GetHash(height) == hashes[height - 1]);
+	}
 }
\ No newline at end of file
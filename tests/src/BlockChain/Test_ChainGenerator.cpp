@@ -0,0 +1,75 @@
+#include <catch.hpp>
+
+#include <TestServer.h>
+#include <ChainGenerator.h>
+
+#include <BlockChain/BlockChainServer.h>
+
+TEST_CASE("ChainGenerator - Reorgs and Mempool")
+{
+	TestServer::Ptr pTestServer = TestServer::Create();
+	auto pBlockChainServer = pTestServer->GetBlockChainServer();
+
+	Test::WorkloadOptions options;
+	options.seed = 42;
+	options.numBlocks = 35;
+	options.blockFullness = 0.003; // 2 txs per block
+	options.reorgInterval = 10;
+	options.reorgDepth = 2;
+	options.numMempoolTxs = 2;
+
+	Test::Workload workload = ChainGenerator(*pTestServer->GetConfig(), options).Generate();
+	REQUIRE(workload.blocks.size() == 35 + (3 * 2));
+	REQUIRE(workload.mempoolTxs.size() == 2);
+
+	size_t numTxBlocks = 0;
+	for (const FullBlock& block : workload.blocks)
+	{
+		REQUIRE(pBlockChainServer->AddBlock(block) == EBlockChainStatus::SUCCESS);
+		if (block.GetKernels().size() > 1)
+		{
+			++numTxBlocks;
+		}
+	}
+
+	// Coinbase outputs mature after 25 blocks in AUTOMATED_TESTING.
+	REQUIRE(numTxBlocks > 0);
+	REQUIRE(pBlockChainServer->GetTipBlockHeader(EChainType::CONFIRMED)->GetHash() == workload.pTip->GetHash());
+
+	for (const TransactionPtr& pTransaction : workload.mempoolTxs)
+	{
+		REQUIRE(pBlockChainServer->AddTransaction(pTransaction, EPoolType::MEMPOOL) == EBlockChainStatus::SUCCESS);
+	}
+}
+
+TEST_CASE("ChainGenerator - Deterministic")
+{
+	TestServer::Ptr pTestServer = TestServer::Create();
+
+	Test::WorkloadOptions options;
+	options.seed = 7;
+	options.numBlocks = 3;
+
+	Test::Workload workload1 = ChainGenerator(*pTestServer->GetConfig(), options).Generate();
+	Test::Workload workload2 = ChainGenerator(*pTestServer->GetConfig(), options).Generate();
+
+	REQUIRE(workload1.blocks.size() == workload2.blocks.size());
+	for (size_t i = 0; i < workload1.blocks.size(); i++)
+	{
+		const BlockHeaderPtr& pHeader1 = workload1.blocks[i].GetHeader();
+		const BlockHeaderPtr& pHeader2 = workload2.blocks[i].GetHeader();
+		REQUIRE(pHeader1->GetKernelRoot() == pHeader2->GetKernelRoot());
+		REQUIRE(pHeader1->GetOutputRoot() == pHeader2->GetOutputRoot());
+
+		// Header hashes only cover the proof of work, so compare every byte of the blocks.
+		Serializer serializer1;
+		workload1.blocks[i].Serialize(serializer1);
+		Serializer serializer2;
+		workload2.blocks[i].Serialize(serializer2);
+		REQUIRE(serializer1.GetBytes() == serializer2.GetBytes());
+	}
+
+	options.seed = 8;
+	Test::Workload workload3 = ChainGenerator(*pTestServer->GetConfig(), options).Generate();
+	REQUIRE(workload3.blocks.front().GetHeader()->GetOutputRoot() != workload1.blocks.front().GetHeader()->GetOutputRoot());
+}
\ No newline at end of file
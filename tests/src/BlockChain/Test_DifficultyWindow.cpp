@@ -0,0 +1,116 @@
+#include <catch.hpp>
+
+#include <TestServer.h>
+#include <TestMiner.h>
+#include <TxBuilder.h>
+
+#include <PoW/DifficultyCalculator.h>
+#include <PoW/DifficultyLoader.h>
+#include <PoW/DifficultyWindowCache.h>
+#include <Consensus/BlockTime.h>
+
+static bool SameWindow(const std::vector<HeaderInfo>& lhs, const std::vector<HeaderInfo>& rhs)
+{
+	return std::equal(
+		lhs.cbegin(), lhs.cend(),
+		rhs.cbegin(), rhs.cend(),
+		[](const HeaderInfo& a, const HeaderInfo& b) {
+			return a.GetTimestamp() == b.GetTimestamp()
+				&& a.GetDifficulty() == b.GetDifficulty()
+				&& a.GetSecondaryScaling() == b.GetSecondaryScaling()
+				&& a.IsSecondary() == b.IsSecondary();
+		}
+	);
+}
+
+//
+// Checks that the cached window of each header matches the window loaded from the db,
+// and that the next difficulty calculated from it matches the uncached calculation.
+// Header validation skips the difficulty check in automated testing, so it's compared here directly.
+//
+static void VerifyWindows(const TestServer::Ptr& pTestServer, const std::vector<BlockHeaderPtr>& headers)
+{
+	auto pBlockDB = pTestServer->GetDatabase()->GetBlockDB()->Read();
+	const DifficultyLoader loader(pBlockDB.GetShared());
+	const DifficultyCalculator calculator(pBlockDB.GetShared());
+
+	for (size_t i = 0; i < headers.size(); i++)
+	{
+		const BlockHeader& header = *headers[i];
+		INFO("Height " << header.GetHeight());
+
+		const std::vector<HeaderInfo> loaded = loader.LoadWindow(header);
+		REQUIRE(loaded.size() == (std::min)(header.GetHeight() + 1, Consensus::DIFFICULTY_ADJUST_WINDOW + 1));
+		REQUIRE(SameWindow(DifficultyWindowCache::GetInstance().GetWindow(header, loader), loaded));
+
+		if (header.GetHeight() > 0)
+		{
+			BlockHeaderPtr pPreviousHeader = pBlockDB->GetBlockHeader(header.GetPreviousHash());
+			REQUIRE(pPreviousHeader != nullptr);
+
+			const HeaderInfo cached = calculator.CalculateNextDifficulty(header, *pPreviousHeader);
+			const HeaderInfo uncached = calculator.CalculateNextDifficulty(header);
+			REQUIRE(cached.GetDifficulty() == uncached.GetDifficulty());
+			REQUIRE(cached.GetSecondaryScaling() == uncached.GetSecondaryScaling());
+		}
+	}
+}
+
+static std::vector<BlockHeaderPtr> GetConfirmedChain(const TestServer::Ptr& pTestServer)
+{
+	auto pBlockChainServer = pTestServer->GetBlockChainServer();
+
+	std::vector<BlockHeaderPtr> headers;
+	for (uint64_t height = 0; height <= pBlockChainServer->GetHeight(EChainType::CONFIRMED); height++)
+	{
+		headers.push_back(pBlockChainServer->GetBlockHeaderByHeight(height, EChainType::CONFIRMED));
+	}
+
+	return headers;
+}
+
+//
+// Walks a chain longer than the difficulty window, then reorgs to a fork and walks it again.
+// The fork's first header extends a window that isn't the most recent one, and the
+// headers that were reorged out must still get their own windows, not the fork's.
+//
+TEST_CASE("Difficulty Window Cache")
+{
+	TestServer::Ptr pTestServer = TestServer::Create();
+	TestMiner miner(pTestServer);
+	KeyChain keyChain = KeyChain::FromRandom(*pTestServer->GetConfig());
+	TxBuilder txBuilder(keyChain);
+	auto pBlockChainServer = pTestServer->GetBlockChainServer();
+
+	const uint64_t chainLength = Consensus::DIFFICULTY_ADJUST_WINDOW + 10;
+	std::vector<MinedBlock> minedChain = miner.MineChain(keyChain, chainLength);
+	REQUIRE(pBlockChainServer->GetHeight(EChainType::CONFIRMED) == chainLength - 1);
+
+	const std::vector<BlockHeaderPtr> originalChain = GetConfirmedChain(pTestServer);
+	VerifyWindows(pTestServer, originalChain);
+
+	////////////////////////////////////////
+	// Rewind to the fork point, and apply a longer fork
+	////////////////////////////////////////
+	const uint64_t forkHeight = chainLength - 5;
+
+	std::vector<FullBlock> fork;
+	for (uint32_t i = 0; i < 6; i++)
+	{
+		Test::Tx coinbaseTx = txBuilder.BuildCoinbaseTx(KeyChainPath({ 1, (uint32_t)forkHeight + i }));
+		fork.push_back(miner.MineNextBlock(minedChain[forkHeight - 1].block.GetBlockHeader(), *coinbaseTx.pTransaction, fork));
+	}
+
+	for (const FullBlock& block : fork)
+	{
+		REQUIRE(pBlockChainServer->AddBlock(block) == EBlockChainStatus::SUCCESS);
+	}
+
+	REQUIRE(pBlockChainServer->GetHeight(EChainType::CONFIRMED) == forkHeight + 5);
+	REQUIRE(pBlockChainServer->GetBlockHeaderByHeight(forkHeight, EChainType::CONFIRMED)->GetHash() == fork.front().GetHash());
+
+	VerifyWindows(pTestServer, GetConfirmedChain(pTestServer));
+
+	// The reorged out headers are still in the db.
+	VerifyWindows(pTestServer, std::vector<BlockHeaderPtr>(originalChain.cbegin() + forkHeight, originalChain.cend()));
+}
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include <catch.hpp>
+
+#include <TestBlock.h>
+
+#include <BlockChain/OrphanPool/OrphanPool.h>
+#include <Crypto/RandomNumberGenerator.h>
+#include <thread>
+
+static bool Contains(const OrphanPool& pool, const FullBlock::CPtr& pBlock)
+{
+	return pool.IsOrphan(pBlock->GetHeight(), pBlock->GetHash());
+}
+
+TEST_CASE("OrphanPool - Children")
+{
+	OrphanPool pool;
+
+	const Hash previousHash = RandomNumberGenerator::GenerateRandom32();
+	FullBlock::CPtr pBlockA = TestBlock::Create(11, previousHash);
+	FullBlock::CPtr pBlockB = TestBlock::Create(11, previousHash);
+	FullBlock::CPtr pBlockC = TestBlock::Create(12, pBlockA->GetHash());
+
+	REQUIRE(pool.AddOrphanBlock(pBlockA, 10));
+	REQUIRE(pool.AddOrphanBlock(pBlockB, 10));
+	REQUIRE(pool.AddOrphanBlock(pBlockC, 10));
+
+	REQUIRE(pool.GetOrphanChildren(previousHash).size() == 2);
+	REQUIRE(pool.GetOrphanChildren(pBlockA->GetHash()) == std::vector<FullBlock::CPtr>{ pBlockC });
+	REQUIRE(pool.GetOrphanChildren(pBlockC->GetHash()).empty());
+
+	pool.RemoveOrphan(pBlockA->GetHeight(), pBlockA->GetHash());
+	REQUIRE(pool.GetOrphanChildren(previousHash) == std::vector<FullBlock::CPtr>{ pBlockB });
+	REQUIRE(pool.GetNumOrphans() == 2);
+}
+
+TEST_CASE("OrphanPool - Byte Cap")
+{
+	const uint64_t blockSize = TestBlock::Create(1)->GetSerializedSize();
+
+	OrphanPool::Limits limits;
+	limits.maxBytes = 3 * blockSize;
+	OrphanPool pool(limits);
+
+	FullBlock::CPtr pBlock11 = TestBlock::Create(11);
+	FullBlock::CPtr pBlock12 = TestBlock::Create(12);
+	FullBlock::CPtr pBlock13 = TestBlock::Create(13);
+	REQUIRE(pool.AddOrphanBlock(pBlock11, 10, "peer"));
+	REQUIRE(pool.AddOrphanBlock(pBlock12, 10, "peer"));
+	REQUIRE(pool.AddOrphanBlock(pBlock13, 10, "peer"));
+	REQUIRE(pool.GetTotalBytes() == 3 * blockSize);
+
+	// A block closer to the tip makes room by evicting the furthest one.
+	FullBlock::CPtr pBlock10 = TestBlock::Create(10);
+	REQUIRE(pool.AddOrphanBlock(pBlock10, 9, "other"));
+	REQUIRE_FALSE(Contains(pool, pBlock13));
+	REQUIRE(Contains(pool, pBlock10));
+	REQUIRE(pool.GetTotalBytes() == 3 * blockSize);
+
+	// A block further than everything in the full pool is the one dropped.
+	FullBlock::CPtr pBlock20 = TestBlock::Create(20);
+	REQUIRE_FALSE(pool.AddOrphanBlock(pBlock20, 9, "other"));
+	REQUIRE_FALSE(Contains(pool, pBlock20));
+	REQUIRE(pool.GetNumOrphans() == 3);
+	REQUIRE(pool.GetTotalBytes() == 3 * blockSize);
+
+	// So is one too far ahead of the confirmed tip.
+	REQUIRE_FALSE(pool.AddOrphanBlock(TestBlock::Create(9 + limits.maxHeightAhead + 1), 9, "other"));
+	REQUIRE(pool.GetNumOrphans() == 3);
+}
+
+TEST_CASE("OrphanPool - Per-Peer Quota")
+{
+	const uint64_t blockSize = TestBlock::Create(1)->GetSerializedSize();
+
+	OrphanPool::Limits limits;
+	limits.maxBytes = 10 * blockSize;
+	limits.maxBytesPerSource = 2 * blockSize;
+	OrphanPool pool(limits);
+
+	FullBlock::CPtr pBlock11 = TestBlock::Create(11);
+	FullBlock::CPtr pBlock12 = TestBlock::Create(12);
+	REQUIRE(pool.AddOrphanBlock(pBlock11, 10, "peer1"));
+	REQUIRE(pool.AddOrphanBlock(pBlock12, 10, "peer1"));
+
+	// peer1 is at its quota, and has nothing further away to give up.
+	REQUIRE_FALSE(pool.AddOrphanBlock(TestBlock::Create(13), 10, "peer1"));
+
+	// Only peer1's own orphans are evicted to make room for its blocks.
+	FullBlock::CPtr pBlock14 = TestBlock::Create(14);
+	REQUIRE(pool.AddOrphanBlock(pBlock14, 10, "peer2"));
+
+	FullBlock::CPtr pBlock10 = TestBlock::Create(10);
+	REQUIRE(pool.AddOrphanBlock(pBlock10, 9, "peer1"));
+	REQUIRE_FALSE(Contains(pool, pBlock12));
+	REQUIRE(Contains(pool, pBlock11));
+	REQUIRE(Contains(pool, pBlock10));
+	REQUIRE(Contains(pool, pBlock14));
+
+	// Other peers still have their full quota.
+	REQUIRE(pool.AddOrphanBlock(TestBlock::Create(15), 10, "peer2"));
+	REQUIRE(pool.GetNumOrphans() == 4);
+	REQUIRE(pool.GetTotalBytes() == 4 * blockSize);
+}
+
+TEST_CASE("OrphanPool - Eviction Order")
+{
+	OrphanPool::Limits limits;
+	limits.maxOrphans = 3;
+	OrphanPool pool(limits);
+
+	FullBlock::CPtr pBlock15 = TestBlock::Create(15);
+	FullBlock::CPtr pBlock11 = TestBlock::Create(11);
+	FullBlock::CPtr pBlock13 = TestBlock::Create(13);
+	REQUIRE(pool.AddOrphanBlock(pBlock15, 10));
+	REQUIRE(pool.AddOrphanBlock(pBlock11, 10));
+	REQUIRE(pool.AddOrphanBlock(pBlock13, 10));
+
+	// The orphans furthest above the tip go first, regardless of the order they were added in.
+	FullBlock::CPtr pBlock12 = TestBlock::Create(12);
+	REQUIRE(pool.AddOrphanBlock(pBlock12, 10));
+	REQUIRE_FALSE(Contains(pool, pBlock15));
+
+	FullBlock::CPtr pBlock10 = TestBlock::Create(10);
+	REQUIRE(pool.AddOrphanBlock(pBlock10, 9));
+	REQUIRE_FALSE(Contains(pool, pBlock13));
+
+	REQUIRE_FALSE(pool.AddOrphanBlock(TestBlock::Create(14), 9));
+
+	REQUIRE(pool.GetNumOrphans() == 3);
+	REQUIRE(Contains(pool, pBlock10));
+	REQUIRE(Contains(pool, pBlock11));
+	REQUIRE(Contains(pool, pBlock12));
+}
+
+TEST_CASE("OrphanPool - Expiry")
+{
+	OrphanPool::Limits limits;
+	limits.maxAge = std::chrono::milliseconds(50);
+	OrphanPool pool(limits);
+
+	FullBlock::CPtr pOldBlock = TestBlock::Create(11);
+	REQUIRE(pool.AddOrphanBlock(pOldBlock, 10, "peer"));
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+	// Expired orphans are dropped when the next one is added.
+	FullBlock::CPtr pNewBlock = TestBlock::Create(12, pOldBlock->GetHash());
+	REQUIRE(pool.AddOrphanBlock(pNewBlock, 10, "peer"));
+	REQUIRE_FALSE(Contains(pool, pOldBlock));
+	REQUIRE(Contains(pool, pNewBlock));
+	REQUIRE(pool.GetNumOrphans() == 1);
+	REQUIRE(pool.GetTotalBytes() == pNewBlock->GetSerializedSize());
+	REQUIRE(pool.GetOrphanChildren(pOldBlock->GetPreviousHash()).empty());
+}
\ No newline at end of file
@@ -443,4 +443,206 @@ TEST_CASE("Reorg Chain")
 	REQUIRE(pBlockChainServer->GetBlockByHeight(31)->GetHash() == block31b.GetHash());
 
 	// TODO: Assert unspent positions in leafset and in database.
+}
+
+//
+// a - b - c
+//  \
+//   - b'
+//
+// Verifies kernel positions are indexed when blocks are applied, and removed when rewound.
+//
+TEST_CASE("Reorg Kernel Positions")
+{
+	TestServer::Ptr pTestServer = TestServer::Create();
+	KeyChain keyChain = KeyChain::FromRandom(*pTestServer->GetConfig());
+	TxBuilder txBuilder(keyChain);
+	auto pBlockChainServer = pTestServer->GetBlockChainServer();
+
+	TestChain chain1(pTestServer);
+
+	Test::Tx coinbase_a = txBuilder.BuildCoinbaseTx(KeyChainPath({ 0, 1 }));
+	MinedBlock block_a = chain1.AddNextBlock({ coinbase_a });
+
+	Test::Tx coinbase_b = txBuilder.BuildCoinbaseTx(KeyChainPath({ 0, 2 }));
+	MinedBlock block_b = chain1.AddNextBlock({ coinbase_b });
+
+	Test::Tx coinbase_c = txBuilder.BuildCoinbaseTx(KeyChainPath({ 0, 3 }));
+	MinedBlock block_c = chain1.AddNextBlock({ coinbase_c });
+
+	chain1.Rewind(2);
+	Test::Tx coinbase_b_fork = txBuilder.BuildCoinbaseTx(KeyChainPath({ 1, 2 }));
+	MinedBlock block_b_fork = chain1.AddNextBlock({ coinbase_b_fork }, 10);
+
+	REQUIRE(pBlockChainServer->AddBlock(block_a.block) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pBlockChainServer->AddBlock(block_b.block) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pBlockChainServer->AddBlock(block_c.block) == EBlockChainStatus::SUCCESS);
+
+	const Commitment& excess_b = block_b.block.GetKernels().front().GetExcessCommitment();
+	const Commitment& excess_c = block_c.block.GetKernels().front().GetExcessCommitment();
+	const Commitment& excess_b_fork = block_b_fork.block.GetKernels().front().GetExcessCommitment();
+
+	std::unique_ptr<KernelLocation> pLocation_c = pBlockChainServer->GetKernelLocation(excess_c);
+	REQUIRE(pLocation_c != nullptr);
+	REQUIRE(pLocation_c->GetBlockHeight() == 3);
+	REQUIRE(pLocation_c->GetMMRIndex() >= block_b.block.GetHeader()->GetKernelMMRSize());
+	REQUIRE(pLocation_c->GetMMRIndex() < block_c.block.GetHeader()->GetKernelMMRSize());
+	REQUIRE(pBlockChainServer->GetKernelLocation(excess_b_fork) == nullptr);
+
+	////////////////////////////////////////
+	// Process forked block_b with higher difficulty
+	////////////////////////////////////////
+	REQUIRE(pBlockChainServer->AddBlock(block_b_fork.block) == EBlockChainStatus::SUCCESS);
+
+	REQUIRE(pBlockChainServer->GetKernelLocation(excess_b) == nullptr);
+	REQUIRE(pBlockChainServer->GetKernelLocation(excess_c) == nullptr);
+
+	std::unique_ptr<KernelLocation> pLocation_b_fork = pBlockChainServer->GetKernelLocation(excess_b_fork);
+	REQUIRE(pLocation_b_fork != nullptr);
+	REQUIRE(pLocation_b_fork->GetBlockHeight() == 2);
+}
+
+
+//
+// Verifies that archive mode records the spend height of outputs and indexes blocks by height,
+// and that both are corrected when the spending block is reorged out.
+//
+TEST_CASE("Reorg Archive Mode")
+{
+	Json::Value json;
+	json[ConfigProps::Node::NODE][ConfigProps::Node::ARCHIVE_MODE] = true;
+
+	TestServer::Ptr pTestServer = TestServer::Create(json);
+	TestMiner miner(pTestServer);
+	KeyChain keyChain = KeyChain::FromRandom(*pTestServer->GetConfig());
+	TxBuilder txBuilder(keyChain);
+	auto pBlockChainServer = pTestServer->GetBlockChainServer();
+
+	std::vector<MinedBlock> minedChain = miner.MineChain(keyChain, 30);
+	REQUIRE(minedChain.size() == 30);
+
+	TransactionOutput outputToSpend = minedChain[1].block.GetOutputs().front();
+	const Commitment& spentCommitment = outputToSpend.GetCommitment();
+	Test::Input input({
+		{ outputToSpend.GetFeatures(), spentCommitment },
+		minedChain[1].coinbasePath.value(),
+		minedChain[1].coinbaseAmount
+	});
+	Test::Output newOutput({
+		KeyChainPath({ 1, 0 }),
+		(uint64_t)(minedChain[1].coinbaseAmount)
+	});
+
+	Transaction spendTransaction = txBuilder.BuildTx(0, { input }, { newOutput });
+
+	std::unique_ptr<OutputHistory> pUnspent = pBlockChainServer->GetOutputHistory(spentCommitment);
+	REQUIRE(pUnspent != nullptr);
+	REQUIRE(pUnspent->GetCreatedHeight() == 1);
+	REQUIRE(!pUnspent->IsSpent());
+
+	////////////////////////////////////////
+	// Spend the output in block 30a
+	////////////////////////////////////////
+	Test::Tx coinbaseTx30a = txBuilder.BuildCoinbaseTx(KeyChainPath({ 0, 30 }));
+	FullBlock block30a = miner.MineNextBlock(
+		minedChain.back().block.GetBlockHeader(),
+		*TransactionUtil::Aggregate({ coinbaseTx30a.pTransaction, std::make_shared<Transaction>(spendTransaction) })
+	);
+	REQUIRE(pBlockChainServer->AddBlock(block30a) == EBlockChainStatus::SUCCESS);
+
+	std::unique_ptr<OutputHistory> pSpent30a = pBlockChainServer->GetOutputHistory(spentCommitment);
+	REQUIRE(pSpent30a != nullptr);
+	REQUIRE(pSpent30a->GetCreatedHeight() == 1);
+	REQUIRE(pSpent30a->GetSpentHeight() == std::make_optional<uint64_t>(30));
+	REQUIRE(*pBlockChainServer->GetArchivedBlockHash(1) == minedChain[1].block.GetHash());
+	REQUIRE(*pBlockChainServer->GetArchivedBlockHash(30) == block30a.GetHash());
+
+	////////////////////////////////////////
+	// Reorg to a chain that spends the output in block 28b instead
+	////////////////////////////////////////
+	Test::Tx coinbaseTx28b = txBuilder.BuildCoinbaseTx(KeyChainPath({ 1, 28 }));
+	FullBlock block28b = miner.MineNextBlock(
+		minedChain[27].block.GetBlockHeader(),
+		*TransactionUtil::Aggregate({ coinbaseTx28b.pTransaction, std::make_shared<Transaction>(spendTransaction) })
+	);
+
+	Test::Tx coinbaseTx29b = txBuilder.BuildCoinbaseTx(KeyChainPath({ 1, 29 }));
+	FullBlock block29b = miner.MineNextBlock(minedChain[27].block.GetBlockHeader(), *coinbaseTx29b.pTransaction, { block28b });
+
+	Test::Tx coinbaseTx30b = txBuilder.BuildCoinbaseTx(KeyChainPath({ 1, 30 }));
+	FullBlock block30b = miner.MineNextBlock(minedChain[27].block.GetBlockHeader(), *coinbaseTx30b.pTransaction, { block28b, block29b });
+
+	Test::Tx coinbaseTx31b = txBuilder.BuildCoinbaseTx(KeyChainPath({ 1, 31 }));
+	FullBlock block31b = miner.MineNextBlock(minedChain[27].block.GetBlockHeader(), *coinbaseTx31b.pTransaction, { block28b, block29b, block30b });
+
+	REQUIRE(pBlockChainServer->AddBlock(block28b) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pBlockChainServer->AddBlock(block29b) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pBlockChainServer->AddBlock(block30b) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pBlockChainServer->AddBlock(block31b) == EBlockChainStatus::SUCCESS);
+
+	std::unique_ptr<OutputHistory> pSpent28b = pBlockChainServer->GetOutputHistory(spentCommitment);
+	REQUIRE(pSpent28b != nullptr);
+	REQUIRE(pSpent28b->GetSpentHeight() == std::make_optional<uint64_t>(28));
+	REQUIRE(*pBlockChainServer->GetArchivedBlockHash(28) == block28b.GetHash());
+	REQUIRE(*pBlockChainServer->GetArchivedBlockHash(30) == block30b.GetHash());
+	REQUIRE(*pBlockChainServer->GetArchivedBlockHash(31) == block31b.GetHash());
+}
+
+//
+// Verifies that a mempool transaction confirmed in a block that gets reorged out is re-added to the mempool.
+//
+TEST_CASE("Reorg Readmits Transactions")
+{
+	TestServer::Ptr pTestServer = TestServer::Create();
+	TestMiner miner(pTestServer);
+	KeyChain keyChain = KeyChain::FromRandom(*pTestServer->GetConfig());
+	TxBuilder txBuilder(keyChain);
+	auto pBlockChainServer = pTestServer->GetBlockChainServer();
+
+	std::vector<MinedBlock> minedChain = miner.MineChain(keyChain, 30);
+	REQUIRE(minedChain.size() == 30);
+
+	const uint64_t fee = 10'000'000;
+	TransactionOutput outputToSpend = minedChain[1].block.GetOutputs().front();
+	Test::Input input({
+		{ outputToSpend.GetFeatures(), outputToSpend.GetCommitment() },
+		minedChain[1].coinbasePath.value(),
+		minedChain[1].coinbaseAmount
+	});
+	Test::Output newOutput({
+		KeyChainPath({ 1, 0 }),
+		(uint64_t)(minedChain[1].coinbaseAmount - fee)
+	});
+
+	TransactionPtr pSpendTransaction = std::make_shared<Transaction>(txBuilder.BuildTx(fee, { input }, { newOutput }));
+	const Hash kernelHash = pSpendTransaction->GetKernels().front().GetHash();
+
+	REQUIRE(pBlockChainServer->AddTransaction(pSpendTransaction, EPoolType::MEMPOOL) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pBlockChainServer->GetTransactionByKernelHash(kernelHash) != nullptr);
+
+	////////////////////////////////////////
+	// Confirm the transaction in block 30a
+	////////////////////////////////////////
+	Test::Tx coinbaseTx30a = txBuilder.BuildCoinbaseTx(KeyChainPath({ 0, 30 }), Consensus::REWARD + fee);
+	FullBlock block30a = miner.MineNextBlock(
+		minedChain.back().block.GetBlockHeader(),
+		*TransactionUtil::Aggregate({ coinbaseTx30a.pTransaction, pSpendTransaction })
+	);
+	REQUIRE(pBlockChainServer->AddBlock(block30a) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pBlockChainServer->GetTransactionByKernelHash(kernelHash) == nullptr);
+
+	////////////////////////////////////////
+	// Reorg to a chain that doesn't include the transaction
+	////////////////////////////////////////
+	Test::Tx coinbaseTx30b = txBuilder.BuildCoinbaseTx(KeyChainPath({ 1, 30 }));
+	FullBlock block30b = miner.MineNextBlock(minedChain.back().block.GetBlockHeader(), *coinbaseTx30b.pTransaction);
+
+	Test::Tx coinbaseTx31b = txBuilder.BuildCoinbaseTx(KeyChainPath({ 1, 31 }));
+	FullBlock block31b = miner.MineNextBlock(minedChain.back().block.GetBlockHeader(), *coinbaseTx31b.pTransaction, { block30b });
+
+	REQUIRE(pBlockChainServer->AddBlock(block30b) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pBlockChainServer->AddBlock(block31b) == EBlockChainStatus::SUCCESS);
+	REQUIRE(pBlockChainServer->GetBlockByHeight(31)->GetHash() == block31b.GetHash());
+
+	REQUIRE(pBlockChainServer->GetTransactionByKernelHash(kernelHash) != nullptr);
 }
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include <catch.hpp>
+
+#include <TestBlock.h>
+
+#include <BlockChain/ValidatedBlockCache.h>
+#include <Crypto/RandomNumberGenerator.h>
+
+TEST_CASE("ValidatedBlockCache - Hit")
+{
+	ValidatedBlockCache cache;
+
+	FullBlock::CPtr pValidated = TestBlock::Create(1);
+	pValidated->MarkAsValidated();
+	cache.AddBlock(pValidated);
+
+	// The cached instance is returned, so its validated flag lets callers skip re-validation.
+	FullBlock::CPtr pCached = cache.GetBlock(pValidated->GetHash());
+	REQUIRE(pCached == pValidated);
+	REQUIRE(pCached->WasValidated());
+
+	// Blocks that weren't fully validated (including assumed-valid ones) aren't cached.
+	FullBlock::CPtr pUnvalidated = TestBlock::Create(2);
+	cache.AddBlock(pUnvalidated);
+	REQUIRE(cache.GetBlock(pUnvalidated->GetHash()) == nullptr);
+
+	FullBlock::CPtr pAssumedValid = TestBlock::Create(3);
+	pAssumedValid->MarkAsAssumedValid();
+	cache.AddBlock(pAssumedValid);
+	REQUIRE(cache.GetBlock(pAssumedValid->GetHash()) == nullptr);
+
+	REQUIRE(cache.GetBlock(RandomNumberGenerator::GenerateRandom32()) == nullptr);
+}
+
+TEST_CASE("ValidatedBlockCache - Eviction")
+{
+	ValidatedBlockCache cache;
+
+	std::vector<FullBlock::CPtr> blocks;
+	for (uint64_t height = 1; height <= 64; height++)
+	{
+		blocks.push_back(TestBlock::Create(height));
+		blocks.back()->MarkAsValidated();
+		cache.AddBlock(blocks.back());
+	}
+
+	for (const FullBlock::CPtr& pBlock : blocks)
+	{
+		REQUIRE(cache.GetBlock(pBlock->GetHash()) == pBlock);
+	}
+
+	// Once full, each new block evicts the least recently used one.
+	FullBlock::CPtr pNewBlock = TestBlock::Create(65);
+	pNewBlock->MarkAsValidated();
+	cache.AddBlock(pNewBlock);
+
+	REQUIRE(cache.GetBlock(pNewBlock->GetHash()) == pNewBlock);
+	REQUIRE(cache.GetBlock(blocks.front()->GetHash()) == nullptr);
+	for (size_t i = 1; i < blocks.size(); i++)
+	{
+		REQUIRE(cache.GetBlock(blocks[i]->GetHash()) == blocks[i]);
+	}
+}
\ No newline at end of file
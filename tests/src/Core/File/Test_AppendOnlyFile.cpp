@@ -30,4 +30,32 @@ TEST_CASE("DataFile")
     pDataFile->Commit();
 
     REQUIRE(pDataFile->GetSize() == 4);
+}
+
+TEST_CASE("DataFile Range")
+{
+    auto pFile = TestFileUtil::CreateTempFile();
+    auto pDataFile = DataFile<32>::Load(pFile->GetPath());
+
+    std::vector<CBigInteger<32>> entries;
+    for (size_t i = 0; i < 4; i++)
+    {
+        entries.push_back(RandomNumberGenerator::GenerateRandom32());
+        pDataFile->AddData(entries.back());
+        if (i == 1)
+        {
+            pDataFile->Commit();
+        }
+    }
+
+    // Starts in the committed entries and ends in the uncommitted ones.
+    const std::vector<unsigned char> range = pDataFile->GetDataRange(1, 3);
+    REQUIRE(range.size() == 3 * 32);
+    for (size_t i = 0; i < 3; i++)
+    {
+        REQUIRE(CBigInteger<32>(&range[i * 32]) == entries[i + 1]);
+    }
+
+    REQUIRE_THROWS(pDataFile->GetDataRange(2, 3));
+    REQUIRE_THROWS(pDataFile->GetDataAt(4));
 }
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include <catch.hpp>
+
+#include <Infrastructure/Metrics.h>
+#include <Core/File/DataFile.h>
+#include <TestFileUtil.h>
+#include <Crypto/RandomNumberGenerator.h>
+
+TEST_CASE("Metrics Histogram")
+{
+    Metrics::Histogram histogram;
+    for (uint64_t i = 1; i <= 100; i++)
+    {
+        histogram.Record(i);
+    }
+
+    const Metrics::HistogramSnapshot snapshot = histogram.GetSnapshot();
+    REQUIRE(snapshot.count == 100);
+    REQUIRE(snapshot.sum == 5050);
+    REQUIRE(snapshot.max == 100);
+    REQUIRE(snapshot.Mean() == 50);
+    REQUIRE(snapshot.p50 == 64);
+    REQUIRE(snapshot.p99 == 128);
+}
+
+TEST_CASE("Metrics DataFile")
+{
+    auto pFile = TestFileUtil::CreateTempFile();
+    auto pDataFile = DataFile<32>::Load(pFile->GetPath());
+
+    const std::string prefix = "file." + pFile->GetPath().parent_path().filename().u8string() + "." + pFile->GetPath().stem().u8string();
+    const uint64_t readsBefore = MetricsAPI::GetCounter(prefix + ".reads").GetValue();
+    const uint64_t writtenBefore = MetricsAPI::GetCounter(prefix + ".bytes_written").GetValue();
+
+    pDataFile->AddData(RandomNumberGenerator::GenerateRandom32());
+    pDataFile->AddData(RandomNumberGenerator::GenerateRandom32());
+    pDataFile->Commit();
+    pDataFile->GetDataAt(1);
+
+    REQUIRE(MetricsAPI::GetCounter(prefix + ".reads").GetValue() == readsBefore + 1);
+    REQUIRE(MetricsAPI::GetCounter(prefix + ".bytes_written").GetValue() == writtenBefore + 64);
+    REQUIRE(MetricsAPI::GetHistograms().at(prefix + ".flush_micros").count >= 1);
+}
+
+TEST_CASE("Metrics StageTimer")
+{
+    Metrics::StageTimer timer("test.stage_timer");
+    timer.Mark("first");
+    timer.Mark("second");
+    timer.Mark("first");
+    timer.Record();
+
+    const std::string formatted = timer.Format();
+    REQUIRE(formatted.find("total_us=") == 0);
+    REQUIRE(formatted.find("first_us=") != std::string::npos);
+    REQUIRE(formatted.find("second_us=") != std::string::npos);
+    REQUIRE(formatted.find("first_us=") == formatted.rfind("first_us="));
+
+    const auto histograms = MetricsAPI::GetHistograms();
+    REQUIRE(histograms.at("test.stage_timer.first").count == 1);
+    REQUIRE(histograms.at("test.stage_timer.second").count == 1);
+    REQUIRE(histograms.at("test.stage_timer.total").count == 1);
+}
+
+TEST_CASE("Metrics ProcessStats")
+{
+    const Metrics::ProcessStats before = MetricsAPI::GetProcessStats();
+    REQUIRE(before.peakMemoryBytes > 0);
+
+    // Counters never decrease.
+    std::vector<uint8_t> allocation(16 * 1024 * 1024, 1);
+    const Metrics::ProcessStats after = MetricsAPI::GetProcessStats();
+    REQUIRE(after.peakMemoryBytes >= before.peakMemoryBytes);
+    REQUIRE(after.readBytes >= before.readBytes);
+    REQUIRE(after.writeBytes >= before.writeBytes);
+}
\ No newline at end of file
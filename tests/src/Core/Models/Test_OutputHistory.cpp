@@ -0,0 +1,24 @@
+#include <catch.hpp>
+
+#include <Core/Models/OutputHistory.h>
+#include <Core/Exceptions/DeserializationException.h>
+
+TEST_CASE("OutputHistory::Deserialize")
+{
+	const OutputHistory spent(OutputLocation(5, 10), std::make_optional<uint64_t>(20));
+
+	Serializer serializer;
+	spent.Serialize(serializer);
+
+	ByteBuffer byteBuffer(serializer.GetBytes());
+	const OutputHistory deserialized = OutputHistory::Deserialize(byteBuffer);
+	REQUIRE(deserialized.GetMMRIndex() == 5);
+	REQUIRE(deserialized.GetCreatedHeight() == 10);
+	REQUIRE(deserialized.GetSpentHeight() == std::make_optional<uint64_t>(20));
+
+	// Unknown versions are rejected rather than misread.
+	std::vector<unsigned char> bytes = serializer.GetBytes();
+	bytes[0] = 1;
+	ByteBuffer unknownVersion(bytes);
+	REQUIRE_THROWS_AS(OutputHistory::Deserialize(unknownVersion), DeserializationException);
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#include <catch.hpp>
+
+#include <Core/Validation/KernelSignatureValidator.h>
+#include <Crypto/RandomNumberGenerator.h>
+
+static TransactionKernel BuildKernel(const uint64_t fee)
+{
+    const SecretKey blind = RandomNumberGenerator::GenerateRandom32();
+    Commitment excess = Crypto::CommitBlinded(0, BlindingFactor(blind.GetBytes()));
+
+    // The signature message only depends on the features, fee and lock height.
+    const Hash message = TransactionKernel(EKernelFeatures::DEFAULT_KERNEL, fee, 0, Commitment(excess), Signature(CBigInteger<64>())).GetSignatureMessage();
+    auto pSignature = Crypto::BuildCoinbaseSignature(blind, excess, message);
+
+    return TransactionKernel(EKernelFeatures::DEFAULT_KERNEL, fee, 0, std::move(excess), Signature(*pSignature));
+}
+
+TEST_CASE("KernelSignatureValidator Parallel")
+{
+    TaskPool::Ptr pTaskPool = TaskPool::Create(4);
+
+    std::vector<TransactionKernel> kernels;
+    for (uint64_t i = 0; i < 1000; i++)
+    {
+        kernels.push_back(BuildKernel(i + 1));
+    }
+
+    REQUIRE(KernelSignatureValidator::VerifyKernelSignatures(kernels, *pTaskPool));
+
+    // Swap in a signature from another kernel, in a chunk other than the first.
+    std::vector<TransactionKernel> tampered(kernels);
+    tampered[700] = TransactionKernel(
+        EKernelFeatures::DEFAULT_KERNEL,
+        tampered[700].GetFee(),
+        0,
+        Commitment(tampered[700].GetExcessCommitment()),
+        Signature(kernels[3].GetExcessSignature())
+    );
+
+    REQUIRE_FALSE(KernelSignatureValidator::VerifyKernelSignatures(tampered, *pTaskPool));
+    REQUIRE_FALSE(KernelSignatureValidator::VerifyKernelSignatures(tampered));
+}
\ No newline at end of file
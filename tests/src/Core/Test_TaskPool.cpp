@@ -0,0 +1,146 @@
+#include <catch.hpp>
+
+#include <Common/TaskPool.h>
+#include <atomic>
+#include <chrono>
+
+TEST_CASE("TaskPool Submit")
+{
+    TaskPool::Ptr pTaskPool = TaskPool::Create(4);
+
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 100; i++)
+    {
+        futures.push_back(pTaskPool->Submit(ETaskPriority::NORMAL, [i] { return i * 2; }));
+    }
+
+    int total = 0;
+    for (auto& future : futures)
+    {
+        total += pTaskPool->Await(future);
+    }
+
+    REQUIRE(total == 9900);
+}
+
+TEST_CASE("TaskPool Nested Await")
+{
+    // A single worker must still complete tasks that wait on other tasks.
+    TaskPool::Ptr pTaskPool = TaskPool::Create(1);
+
+    auto future = pTaskPool->Submit(ETaskPriority::HIGH, [pTaskPool] {
+        auto inner = pTaskPool->Submit(ETaskPriority::LOW, [] { return 5; });
+        return pTaskPool->Await(inner) + 1;
+    });
+
+    REQUIRE(pTaskPool->Await(future) == 6);
+}
+
+TEST_CASE("TaskGroup Concurrency Limit")
+{
+    TaskPool::Ptr pTaskPool = TaskPool::Create(4);
+    TaskGroup::Ptr pGroup = pTaskPool->CreateGroup("TEST", 2);
+
+    std::atomic_size_t running = 0;
+    std::atomic_size_t maxRunning = 0;
+    std::atomic_size_t completed = 0;
+    for (size_t i = 0; i < 20; i++)
+    {
+        pGroup->Post(ETaskPriority::NORMAL, [&running, &maxRunning, &completed] {
+            const size_t numRunning = ++running;
+            size_t expected = maxRunning;
+            while (numRunning > expected && !maxRunning.compare_exchange_weak(expected, numRunning)) {}
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            running--;
+            completed++;
+        });
+    }
+
+    pGroup->Wait();
+    REQUIRE(completed == 20);
+    REQUIRE(maxRunning <= 2);
+}
+
+TEST_CASE("TaskGroup Cancel")
+{
+    TaskPool::Ptr pTaskPool = TaskPool::Create(2);
+    TaskGroup::Ptr pGroup = pTaskPool->CreateGroup("TEST", 1);
+
+    std::atomic_size_t completed = 0;
+    for (size_t i = 0; i < 10; i++)
+    {
+        pGroup->Post(ETaskPriority::NORMAL, [&completed] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            completed++;
+        });
+    }
+
+    pGroup->Cancel();
+    pGroup->Wait();
+
+    REQUIRE(completed <= 1);
+    REQUIRE(pGroup->IsCancelled());
+    REQUIRE_FALSE(pGroup->Post(ETaskPriority::NORMAL, [] {}));
+}
+
+TEST_CASE("TaskPool ScheduleInterval")
+{
+    TaskPool::Ptr pTaskPool = TaskPool::Create(2);
+
+    std::atomic_size_t runs = 0;
+    const uint64_t intervalId = pTaskPool->ScheduleInterval(std::chrono::milliseconds(1), ETaskPriority::LOW, [&runs] { runs++; });
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (runs < 3 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    pTaskPool->CancelInterval(intervalId);
+    REQUIRE(runs >= 3);
+
+    pTaskPool->Shutdown();
+}
+
+TEST_CASE("TaskGroup Wait After Shutdown")
+{
+    TaskPool::Ptr pTaskPool = TaskPool::Create(1);
+    TaskGroup::Ptr pGroup = pTaskPool->CreateGroup("TEST", 2);
+
+    std::atomic_bool started = false;
+    std::atomic_bool release = false;
+    std::atomic_size_t completed = 0;
+    REQUIRE(pGroup->Post(ETaskPriority::NORMAL, [&started, &release, &completed] {
+        started = true;
+        while (!release)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        completed++;
+    }));
+
+    while (!started)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // The only worker is busy, so one task is queued in the pool, and the rest wait in the group.
+    for (size_t i = 0; i < 5; i++)
+    {
+        REQUIRE(pGroup->Post(ETaskPriority::NORMAL, [&completed] { completed++; }));
+    }
+
+    std::thread shutdownThread([pTaskPool] { pTaskPool->Shutdown(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    release = true;
+    shutdownThread.join();
+
+    // Discarded tasks must release their slots, or this would never return.
+    pGroup->Wait();
+    REQUIRE(completed == 1);
+
+    REQUIRE_FALSE(pTaskPool->Post(ETaskPriority::NORMAL, [] {}));
+    REQUIRE_FALSE(pGroup->Post(ETaskPriority::NORMAL, [] {}));
+}
\ No newline at end of file
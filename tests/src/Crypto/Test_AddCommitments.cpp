@@ -59,4 +59,31 @@ TEST_CASE("Crypto::AddCommitment")
 		Commitment commit_c = Crypto::CommitBlinded(1, blind_c);
 		REQUIRE(commit_c == difference);
 	}
+}
+
+TEST_CASE("Crypto::AddCommitments - Large Batches")
+{
+	const Commitment zeroCommitment(CBigInteger<33>::ValueOf(0));
+
+	// Enough commitments to exceed the stack storage, with zero commitments mixed in to be skipped.
+	std::vector<Commitment> positive;
+	uint64_t total = 0;
+	for (uint64_t i = 1; i <= 40; i++)
+	{
+		positive.push_back(Crypto::CommitTransparent(i));
+		total += i;
+
+		if (i % 10 == 0)
+		{
+			positive.push_back(zeroCommitment);
+		}
+	}
+
+	REQUIRE(Crypto::AddCommitments(positive, std::vector<Commitment>()) == Crypto::CommitTransparent(total));
+
+	std::vector<Commitment> negative({ zeroCommitment, Crypto::CommitTransparent(20) });
+	REQUIRE(Crypto::AddCommitments(positive, negative) == Crypto::CommitTransparent(total - 20));
+
+	// Small batches stay on the stack.
+	REQUIRE(Crypto::AddCommitments({ Crypto::CommitTransparent(3), zeroCommitment }, { Crypto::CommitTransparent(1) }) == Crypto::CommitTransparent(2));
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "../secp256k1-zkp/include/secp256k1.h"
 #include <Crypto/Crypto.h>
 #include <Crypto/RandomNumberGenerator.h>
+#include <thread>
 
 TEST_CASE("AggSig Interaction")
 {
@@ -62,4 +63,43 @@ TEST_CASE("Message Signature")
 	const PublicKey publicKey2 = Crypto::CalculatePublicKey(RandomNumberGenerator::GenerateRandom32());
 	const bool differentPublicKey = Crypto::VerifyMessageSignature(*pSignature, publicKey2, message);
 	REQUIRE(differentPublicKey == false);
+}
+
+TEST_CASE("Concurrent Signing and Verification")
+{
+	// Each thread uses its own secp256k1 context, so signing on one thread must not disturb verification on another.
+	const size_t numThreads = 8;
+	const size_t numIterations = 20;
+
+	std::vector<std::thread> threads;
+	std::vector<size_t> numValid(numThreads, 0);
+	for (size_t t = 0; t < numThreads; t++)
+	{
+		threads.emplace_back([&numValid, t] {
+			for (size_t i = 0; i < numIterations; i++)
+			{
+				const SecretKey secretKey = RandomNumberGenerator::GenerateRandom32();
+				const PublicKey publicKey = Crypto::CalculatePublicKey(secretKey);
+				const std::string message = "MESSAGE " + std::to_string(t) + "-" + std::to_string(i);
+
+				std::unique_ptr<CompactSignature> pSignature = Crypto::SignMessage(secretKey, publicKey, message);
+				if (pSignature != nullptr
+					&& Crypto::VerifyMessageSignature(*pSignature, publicKey, message)
+					&& !Crypto::VerifyMessageSignature(*pSignature, publicKey, "WRONG_MESSAGE"))
+				{
+					numValid[t]++;
+				}
+			}
+		});
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	for (size_t t = 0; t < numThreads; t++)
+	{
+		REQUIRE(numValid[t] == numIterations);
+	}
 }
\ No newline at end of file
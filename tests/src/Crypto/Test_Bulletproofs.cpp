@@ -0,0 +1,74 @@
+#include <catch.hpp>
+
+#include <Crypto/Crypto.h>
+#include <Crypto/RandomNumberGenerator.h>
+#include <Crypto/VerifiedCache.h>
+#include <thread>
+
+static std::pair<Commitment, RangeProof> CreateProof(const uint64_t amount)
+{
+	const SecretKey blindingFactor = RandomNumberGenerator::GenerateRandom32();
+	const Commitment commitment = Crypto::CommitBlinded(amount, BlindingFactor(blindingFactor.GetBytes()));
+	const RangeProof rangeProof = Crypto::GenerateRangeProof(
+		amount,
+		blindingFactor,
+		RandomNumberGenerator::GenerateRandom32(),
+		RandomNumberGenerator::GenerateRandom32(),
+		ProofMessage(CBigInteger<20>())
+	);
+
+	return std::make_pair(commitment, rangeProof);
+}
+
+TEST_CASE("Bulletproofs - Reused Scratch Space")
+{
+	// The limits only apply to scratch spaces created afterwards, so the proofs are verified on a new thread.
+	// Keep less than a batch needs, so some frames are reused and others are freed after each call.
+	Crypto::ConfigureScratchSpace(256 * 1024 * 1024, 64 * 1024);
+
+	std::vector<bool> verified;
+	std::vector<bool> mismatchVerified;
+	std::thread thread([&verified, &mismatchVerified]() {
+		for (size_t i = 0; i < 3; i++)
+		{
+			std::vector<std::pair<Commitment, RangeProof>> proofs;
+			for (size_t j = 0; j < 4; j++)
+			{
+				proofs.push_back(CreateProof(1000 + j));
+			}
+
+			verified.push_back(Crypto::VerifyRangeProofs(proofs));
+
+			// The proof doesn't match the commitment, so it must fail even though the scratch memory was already used.
+			const Commitment otherCommitment = Crypto::CommitBlinded(5, BlindingFactor(RandomNumberGenerator::GenerateRandom32()));
+			const std::vector<std::pair<Commitment, RangeProof>> mismatched({ std::make_pair(otherCommitment, CreateProof(5).second) });
+			mismatchVerified.push_back(Crypto::VerifyRangeProofs(mismatched));
+		}
+	});
+	thread.join();
+
+	// Restore the defaults, so later tests aren't affected.
+	Crypto::ConfigureScratchSpace(256 * 1024 * 1024, 16 * 1024 * 1024);
+
+	REQUIRE(verified == std::vector<bool>({ true, true, true }));
+	REQUIRE(mismatchVerified == std::vector<bool>({ false, false, false }));
+}
+
+TEST_CASE("Bulletproofs - Verified Cache")
+{
+	const std::pair<Commitment, RangeProof> proof = CreateProof(1000);
+	const Hash cacheKey = VerifiedCache::RangeProofKey(proof.first, proof.second);
+	REQUIRE_FALSE(VerifiedCache::GetInstance().Contains(cacheKey));
+
+	// Bulk validation doesn't remember what it verified.
+	REQUIRE(Crypto::VerifyRangeProofs({ proof }, false));
+	REQUIRE_FALSE(VerifiedCache::GetInstance().Contains(cacheKey));
+
+	REQUIRE(Crypto::VerifyRangeProofs({ proof }));
+	REQUIRE(VerifiedCache::GetInstance().Contains(cacheKey));
+
+	// The cache is keyed by commitment and proof, so another proof for the same commitment still gets verified.
+	const std::pair<Commitment, RangeProof> other = CreateProof(1000);
+	REQUIRE_FALSE(VerifiedCache::GetInstance().Contains(VerifiedCache::RangeProofKey(proof.first, other.second)));
+	REQUIRE_FALSE(Crypto::VerifyRangeProofs({ std::make_pair(proof.first, other.second) }));
+}
\ No newline at end of file
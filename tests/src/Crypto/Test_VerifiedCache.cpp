@@ -0,0 +1,74 @@
+#include <catch.hpp>
+
+#include <Crypto/VerifiedCache.h>
+#include <Crypto/RandomNumberGenerator.h>
+
+static Commitment RandomCommitment()
+{
+	return Commitment(CBigInteger<33>(RandomNumberGenerator::GenerateRandomBytes(33).data()));
+}
+
+static Signature RandomSignature()
+{
+	return Signature(CBigInteger<64>(RandomNumberGenerator::GenerateRandomBytes(64).data()));
+}
+
+// Shards are picked by the last byte of the hash, so hashes sharing it land in the same shard.
+static Hash HashInShard(const uint8_t shard, const uint8_t id)
+{
+	std::vector<unsigned char> bytes(32, 0);
+	bytes[0] = id;
+	bytes[31] = shard;
+	return Hash(bytes);
+}
+
+TEST_CASE("VerifiedCache - Kernel Signatures")
+{
+	VerifiedCache cache(1000);
+
+	const Commitment excess = RandomCommitment();
+	const Signature signature = RandomSignature();
+	const Hash message = RandomNumberGenerator::GenerateRandom32();
+
+	const Hash cacheKey = VerifiedCache::SignatureKey(excess, signature, message);
+	REQUIRE_FALSE(cache.Contains(cacheKey));
+
+	cache.Add(cacheKey);
+	REQUIRE(cache.Contains(VerifiedCache::SignatureKey(excess, signature, message)));
+
+	// Changing any part of the kernel is a miss.
+	REQUIRE_FALSE(cache.Contains(VerifiedCache::SignatureKey(RandomCommitment(), signature, message)));
+	REQUIRE_FALSE(cache.Contains(VerifiedCache::SignatureKey(excess, RandomSignature(), message)));
+	REQUIRE_FALSE(cache.Contains(VerifiedCache::SignatureKey(excess, signature, RandomNumberGenerator::GenerateRandom32())));
+}
+
+TEST_CASE("VerifiedCache - Eviction")
+{
+	// Each shard holds 2 entries.
+	VerifiedCache cache(VerifiedCache::NUM_SHARDS * 2);
+
+	cache.Add(HashInShard(0, 1));
+	cache.Add(HashInShard(0, 2));
+	cache.Add(HashInShard(1, 1));
+
+	// Adding an entry already cached doesn't take another slot.
+	cache.Add(HashInShard(0, 1));
+	REQUIRE(cache.Contains(HashInShard(0, 1)));
+	REQUIRE(cache.Contains(HashInShard(0, 2)));
+
+	// A full shard evicts its oldest entry first.
+	cache.Add(HashInShard(0, 3));
+	REQUIRE_FALSE(cache.Contains(HashInShard(0, 1)));
+	REQUIRE(cache.Contains(HashInShard(0, 2)));
+	REQUIRE(cache.Contains(HashInShard(0, 3)));
+
+	// Other shards aren't affected.
+	REQUIRE(cache.Contains(HashInShard(1, 1)));
+
+	// Shrinking the capacity takes effect as entries are added.
+	cache.SetCapacity(VerifiedCache::NUM_SHARDS);
+	cache.Add(HashInShard(0, 4));
+	REQUIRE_FALSE(cache.Contains(HashInShard(0, 2)));
+	REQUIRE_FALSE(cache.Contains(HashInShard(0, 3)));
+	REQUIRE(cache.Contains(HashInShard(0, 4)));
+}
\ No newline at end of file
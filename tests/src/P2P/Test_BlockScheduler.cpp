@@ -0,0 +1,198 @@
+#include <catch.hpp>
+
+#include <P2P/Sync/BlockScheduler.h>
+#include <chrono>
+
+using namespace std::chrono;
+
+class TestSender
+{
+public:
+    BlockScheduler::SendRequest GetCallback()
+    {
+        return [this](const PeerPtr& pPeer, const Hash& blockHash) {
+            sent.push_back({ pPeer, blockHash });
+            return true;
+        };
+    }
+
+    std::vector<std::pair<PeerPtr, Hash>> sent;
+};
+
+static PeerPtr CreatePeer(const uint8_t id)
+{
+    return std::make_shared<Peer>(IPAddress::CreateV4({ 10, 0, 0, id }));
+}
+
+TEST_CASE("BlockScheduler Window Growth")
+{
+    TestSender sender;
+    BlockScheduler scheduler(sender.GetCallback());
+
+    PeerPtr pPeer = CreatePeer(1);
+    const std::vector<PeerPtr> peers{ pPeer };
+
+    // Unmeasured peers get the default bandwidth-delay product: 2 * 128KiB/s * 1s / 32KiB.
+    const size_t initialWindow = scheduler.GetWindow(pPeer->GetIPAddress());
+    REQUIRE(initialWindow == 8);
+
+    const auto start = BlockScheduler::Clock::now();
+    for (uint8_t i = 0; i < initialWindow; i++)
+    {
+        REQUIRE(scheduler.RequestBlock(i, Hash::ValueOf(i), peers, start));
+    }
+
+    // The window is full, so no more blocks can be requested from the peer.
+    REQUIRE_FALSE(scheduler.RequestBlock(initialWindow, Hash::ValueOf((uint8_t)initialWindow), peers, start));
+    REQUIRE(scheduler.GetCapacity(peers) == 0);
+    REQUIRE(sender.sent.size() == initialWindow);
+
+    // The first block measures latency, the rest arrive back-to-back at ~3MiB/s.
+    auto received = start + milliseconds(500);
+    for (uint8_t i = 0; i < initialWindow; i++)
+    {
+        scheduler.OnBlockReceived(Hash::ValueOf(i), pPeer->GetIPAddress(), 32 * 1024, received);
+        received += milliseconds(10);
+    }
+
+    REQUIRE(scheduler.GetNumRequests() == 0);
+
+    const size_t window = scheduler.GetWindow(pPeer->GetIPAddress());
+    REQUIRE(window > initialWindow);
+    REQUIRE(window <= BlockScheduler::MAX_WINDOW);
+    REQUIRE(scheduler.GetCapacity(peers) == window);
+}
+
+TEST_CASE("BlockScheduler Stall Re-request")
+{
+    TestSender sender;
+    BlockScheduler scheduler(sender.GetCallback());
+
+    PeerPtr pPeer1 = CreatePeer(1);
+    PeerPtr pPeer2 = CreatePeer(2);
+    const Hash blockHash = Hash::ValueOf(1);
+
+    const auto start = BlockScheduler::Clock::now();
+    const milliseconds stallTimeout = scheduler.GetStallTimeout(pPeer1->GetIPAddress());
+    REQUIRE(stallTimeout >= BlockScheduler::MIN_STALL_TIMEOUT);
+    REQUIRE(stallTimeout <= BlockScheduler::REQUEST_TIMEOUT / 2);
+
+    SECTION("Re-requested from another peer once")
+    {
+        const std::vector<PeerPtr> peers{ pPeer1, pPeer2 };
+        REQUIRE(scheduler.RequestBlock(1, blockHash, peers, start));
+        REQUIRE(sender.sent.size() == 1);
+        REQUIRE(sender.sent[0].first == pPeer1);
+
+        const size_t window = scheduler.GetWindow(pPeer1->GetIPAddress());
+
+        // Not stalled yet.
+        scheduler.ExpireRequests(peers, start + milliseconds(500));
+        REQUIRE(sender.sent.size() == 1);
+
+        const auto stalled = start + scheduler.GetStallTimeout(pPeer1->GetIPAddress()) + milliseconds(1);
+        scheduler.ExpireRequests(peers, stalled);
+        REQUIRE(sender.sent.size() == 2);
+        REQUIRE(sender.sent[1].first == pPeer2);
+        REQUIRE(sender.sent[1].second == blockHash);
+        REQUIRE(scheduler.GetNumAttempts(1) == 2);
+
+        // The stalled peer's bandwidth estimate is halved exactly once, no matter how many ticks pass.
+        const size_t reducedWindow = scheduler.GetWindow(pPeer1->GetIPAddress());
+        REQUIRE(reducedWindow < window);
+
+        for (int i = 0; i < 100; i++)
+        {
+            scheduler.ExpireRequests(peers, stalled + milliseconds(i));
+        }
+
+        REQUIRE(sender.sent.size() == 2);
+        REQUIRE(scheduler.GetWindow(pPeer1->GetIPAddress()) == reducedWindow);
+    }
+
+    SECTION("No other peer available")
+    {
+        const std::vector<PeerPtr> peers{ pPeer1 };
+        REQUIRE(scheduler.RequestBlock(1, blockHash, peers, start));
+
+        const size_t window = scheduler.GetWindow(pPeer1->GetIPAddress());
+        const milliseconds requestStallTimeout = scheduler.GetStallTimeout(pPeer1->GetIPAddress());
+        for (int i = 0; i < 1000; i++)
+        {
+            scheduler.ExpireRequests(peers, start + requestStallTimeout + milliseconds(1 + i));
+        }
+
+        // The re-request was never sent, so the peer isn't penalized and its timeouts stay finite.
+        REQUIRE(sender.sent.size() == 1);
+        REQUIRE(scheduler.GetNumAttempts(1) == 1);
+        REQUIRE(scheduler.GetWindow(pPeer1->GetIPAddress()) == window);
+        REQUIRE(scheduler.GetStallTimeout(pPeer1->GetIPAddress()) == requestStallTimeout);
+    }
+}
+
+TEST_CASE("BlockScheduler Timeout Banning")
+{
+    TestSender sender;
+    BlockScheduler scheduler(sender.GetCallback());
+
+    PeerPtr pPeer = CreatePeer(1);
+    const std::vector<PeerPtr> peers{ pPeer };
+    const Hash blockHash = Hash::ValueOf(1);
+    const milliseconds timeout = BlockScheduler::REQUEST_TIMEOUT + milliseconds(1);
+
+    auto now = BlockScheduler::Clock::now();
+    REQUIRE(scheduler.RequestBlock(1, blockHash, peers, now));
+
+    now += timeout;
+    scheduler.ExpireRequests(peers, now);
+    REQUIRE(scheduler.GetNumRequests() == 0);
+    REQUIRE_FALSE(pPeer->IsBanned());
+
+    // Timeouts shrink the peer's bandwidth estimate, but the stall timeout stays within its bounds.
+    REQUIRE(scheduler.GetStallTimeout(pPeer->GetIPAddress()) <= BlockScheduler::REQUEST_TIMEOUT / 2);
+
+    SECTION("Second consecutive timeout bans the peer")
+    {
+        REQUIRE(scheduler.RequestBlock(1, blockHash, peers, now));
+
+        scheduler.ExpireRequests(peers, now + timeout);
+        REQUIRE(scheduler.GetNumRequests() == 0);
+        REQUIRE(pPeer->IsBanned());
+    }
+
+    SECTION("Delivery resets the timeout count")
+    {
+        REQUIRE(scheduler.RequestBlock(1, blockHash, peers, now));
+        scheduler.OnBlockReceived(blockHash, pPeer->GetIPAddress(), 1024, now + milliseconds(100));
+        REQUIRE(scheduler.GetNumRequests() == 0);
+
+        now += milliseconds(100);
+        REQUIRE(scheduler.RequestBlock(2, Hash::ValueOf(2), peers, now));
+
+        scheduler.ExpireRequests(peers, now + timeout);
+        REQUIRE(scheduler.GetNumRequests() == 0);
+        REQUIRE_FALSE(pPeer->IsBanned());
+    }
+
+    SECTION("Several blocks timing out together count as one stall")
+    {
+        // Clear the earlier timeout, so the peer starts this stall with a clean record.
+        REQUIRE(scheduler.RequestBlock(1, blockHash, peers, now));
+        scheduler.OnBlockReceived(blockHash, pPeer->GetIPAddress(), 1024, now + milliseconds(100));
+        now += milliseconds(100);
+
+        REQUIRE(scheduler.GetWindow(pPeer->GetIPAddress()) >= BlockScheduler::MIN_WINDOW);
+        REQUIRE(scheduler.RequestBlock(2, Hash::ValueOf(2), peers, now));
+        REQUIRE(scheduler.RequestBlock(3, Hash::ValueOf(3), peers, now));
+
+        now += timeout;
+        scheduler.ExpireRequests(peers, now);
+        REQUIRE(scheduler.GetNumRequests() == 0);
+        REQUIRE_FALSE(pPeer->IsBanned());
+
+        // Only a later, separate stall gets the peer banned.
+        REQUIRE(scheduler.RequestBlock(4, Hash::ValueOf(4), peers, now));
+        scheduler.ExpireRequests(peers, now + timeout);
+        REQUIRE(pPeer->IsBanned());
+    }
+}
\ No newline at end of file